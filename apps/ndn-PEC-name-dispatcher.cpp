@@ -0,0 +1,73 @@
+/*
+ * Copyright ( C ) 2020 New Mexico State University- Board of Regents
+ *
+ * See AUTHORS.md for complete list of authors and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * ( at your option ) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "ndn-PEC-name-dispatcher.hpp"
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+
+const name::Component PECNames::SERVICE("service");
+const name::Component PECNames::BASE_QUERY("baseQuery");
+const name::Component PECNames::UPDATE("update");
+const name::Component PECNames::SERVER("server");
+const name::Component PECNames::COMPUTE("compute");
+const name::Component PECNames::OBTAIN("obtain");
+const name::Component PECNames::INPUT("input");
+
+NamePattern::NamePattern()
+  : m_minSize(0)
+{
+}
+
+NamePattern&
+NamePattern::at(ssize_t index, const name::Component& component)
+{
+  m_components.emplace_back(index, component);
+  // a name shorter than this cannot have the component at the position
+  m_minSize = std::max(m_minSize, static_cast<size_t>(index < 0 ? -index : index + 1));
+  return *this;
+}
+
+NamePattern&
+NamePattern::atLeast(size_t nComponents)
+{
+  m_minSize = std::max(m_minSize, nComponents);
+  return *this;
+}
+
+bool
+NamePattern::match(const Name& name) const
+{
+  if (name.size() < m_minSize) {
+    return false;
+  }
+  for (const auto& component : m_components) {
+    if (!isComponent(name, component.first, component.second)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,158 @@
+/*
+ * Copyright ( C ) 2020 New Mexico State University- Board of Regents
+ *
+ * See AUTHORS.md for complete list of authors and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * ( at your option ) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef NDN_PEC_NAME_DISPATCHER_H
+#define NDN_PEC_NAME_DISPATCHER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndnQoS
+ * @brief Name components that identify PEC packets
+ *
+ * Names used by PEC applications have the form /<prefix>/<type>/..., e.g.,
+ *
+ *     /prefix/service/<client>/<seq>                 service discovery
+ *     /prefix/baseQuery/<station>/<seq>              state query of a base station
+ *     /prefix/update/server/<server>/<seq>           state update of a server
+ *     /prefix/compute/<server>/<client>/<seq>        compute request
+ *     /prefix/compute/<server>/<client>/obtain/<seq> result of a compute request
+ *     /prefix/input/<client>/<seq>                   input of a compute request
+ *
+ * The components are created once, so that packets can be classified without building names
+ * or strings.
+ */
+struct PECNames {
+  static const name::Component SERVICE;
+  static const name::Component BASE_QUERY;
+  static const name::Component UPDATE;
+  static const name::Component SERVER;
+  static const name::Component COMPUTE;
+  static const name::Component OBTAIN;
+  static const name::Component INPUT;
+};
+
+/**
+ * @brief Check whether component @p index of @p name equals @p component
+ * @param index position of the component, negative positions count from the end
+ * @return false if @p name has no component at @p index
+ */
+inline bool
+isComponent(const Name& name, ssize_t index, const name::Component& component)
+{
+  ssize_t size = static_cast<ssize_t>(name.size());
+  if (index < 0) {
+    index += size;
+  }
+  return index >= 0 && index < size && name.get(index) == component;
+}
+
+/**
+ * @ingroup ndnQoS
+ * @brief Set of components a name must have at given positions
+ */
+class NamePattern {
+public:
+  NamePattern();
+
+  /**
+   * @brief Require @p component at @p index (negative positions count from the end)
+   */
+  NamePattern&
+  at(ssize_t index, const name::Component& component);
+
+  /**
+   * @brief Require at least @p nComponents components
+   */
+  NamePattern&
+  atLeast(size_t nComponents);
+
+  bool
+  match(const Name& name) const;
+
+private:
+  std::vector<std::pair<ssize_t, name::Component>> m_components;
+  size_t m_minSize;
+};
+
+/**
+ * @ingroup ndnQoS
+ * @brief Routes packets to handlers by the name patterns they match
+ *
+ * Patterns are tried in the order they were added and the first match wins, so more specific
+ * patterns (e.g., obtain under compute) must be added before more general ones.  Matching
+ * compares components in place and does not allocate.
+ *
+ * @tparam Handler callable type, e.g., std::function<void(shared_ptr<const Interest>)>
+ */
+template<typename Handler>
+class NameDispatcher {
+public:
+  void
+  add(const NamePattern& pattern, const Handler& handler)
+  {
+    m_routes.emplace_back(pattern, handler);
+  }
+
+  /**
+   * @return handler of the first pattern matched by @p name, or nullptr if there is none
+   */
+  const Handler*
+  find(const Name& name) const
+  {
+    for (const auto& route : m_routes) {
+      if (route.first.match(name)) {
+        return &route.second;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * @brief Call handler of the first pattern matched by @p name with @p args
+   * @return false if no pattern is matched
+   */
+  template<typename... Args>
+  bool
+  dispatch(const Name& name, Args&&... args) const
+  {
+    const Handler* handler = find(name);
+    if (handler == nullptr) {
+      return false;
+    }
+    (*handler)(std::forward<Args>(args)...);
+    return true;
+  }
+
+private:
+  std::vector<std::pair<NamePattern, Handler>> m_routes;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PEC_NAME_DISPATCHER_H
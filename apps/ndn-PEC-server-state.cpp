@@ -0,0 +1,218 @@
+/*
+ * Copyright ( C ) 2020 New Mexico State University- Board of Regents
+ *
+ * See AUTHORS.md for complete list of authors and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * ( at your option ) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ndn-PEC-server-state.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+/**
+ * @brief Write TLV-TYPE or TLV-LENGTH @p number at @p pos
+ * @return position after the written number
+ */
+uint8_t*
+writeVarNumber(uint8_t* pos, uint64_t number)
+{
+  size_t nBytes;
+  if (number < 253) {
+    *pos++ = static_cast<uint8_t>(number);
+    return pos;
+  }
+  else if (number <= 0xFFFF) {
+    *pos++ = 253;
+    nBytes = 2;
+  }
+  else if (number <= 0xFFFFFFFF) {
+    *pos++ = 254;
+    nBytes = 4;
+  }
+  else {
+    *pos++ = 255;
+    nBytes = 8;
+  }
+  for (size_t i = nBytes; i > 0; --i) {
+    *pos++ = static_cast<uint8_t>(number >> (8 * (i - 1)));
+  }
+  return pos;
+}
+
+std::vector<uint8_t>
+toVector(const Block& block)
+{
+  return std::vector<uint8_t>(block.begin(), block.end());
+}
+
+} // namespace
+
+const uint32_t ServerState::MAX_SERVICE;
+
+ServerState::ServerState()
+  : m_utilization(0)
+  , m_services(0)
+{
+}
+
+ServerState::ServerState(const std::string& serverId, uint32_t utilization, uint64_t services)
+  : m_serverId(serverId)
+  , m_utilization(utilization)
+  , m_services(services)
+{
+}
+
+ServerState::ServerState(const Block& wire)
+{
+  wireDecode(wire);
+}
+
+bool
+ServerState::hasService(uint32_t service) const
+{
+  return service <= MAX_SERVICE && (m_services & (uint64_t(1) << service)) != 0;
+}
+
+Block
+ServerState::wireEncode() const
+{
+  ::ndn::EncodingBuffer encoder;
+
+  size_t length = 0;
+  length += ::ndn::encoding::prependNonNegativeIntegerBlock(encoder, TLV_SERVICES, m_services);
+  length += ::ndn::encoding::prependNonNegativeIntegerBlock(encoder, TLV_UTILIZATION, m_utilization);
+  length += ::ndn::encoding::prependStringBlock(encoder, TLV_SERVER_ID, m_serverId);
+  encoder.prependVarNumber(length);
+  encoder.prependVarNumber(TLV_SERVER_STATE);
+
+  return encoder.block();
+}
+
+void
+ServerState::wireDecode(const Block& wire)
+{
+  if (wire.type() != TLV_SERVER_STATE) {
+    throw ::ndn::tlv::Error("Unexpected TLV type when decoding ServerState");
+  }
+  wire.parse();
+
+  m_serverId = ::ndn::encoding::readString(wire.get(TLV_SERVER_ID));
+  m_utilization = ::ndn::encoding::readNonNegativeIntegerAs<uint32_t>(wire.get(TLV_UTILIZATION));
+  m_services = ::ndn::encoding::readNonNegativeInteger(wire.get(TLV_SERVICES));
+}
+
+uint32_t
+ServerState::toUtilization(double utilization)
+{
+  if (!(utilization > 0)) {
+    return 0;
+  }
+  if (utilization >= static_cast<double>(std::numeric_limits<uint32_t>::max())) {
+    return std::numeric_limits<uint32_t>::max();
+  }
+  return static_cast<uint32_t>(utilization);
+}
+
+uint64_t
+ServerState::parseServices(const std::string& services)
+{
+  uint64_t result = 0;
+  std::istringstream is(services);
+  uint32_t service;
+  while (is >> service) {
+    if (service <= MAX_SERVICE) {
+      result |= uint64_t(1) << service;
+    }
+  }
+  return result;
+}
+
+shared_ptr<::ndn::Buffer>
+ServerState::concatenate(const std::vector<Block>& records)
+{
+  size_t size = 0;
+  for (const auto& record : records) {
+    size += record.size();
+  }
+
+  auto buffer = make_shared<::ndn::Buffer>(size);
+  auto out = buffer->begin();
+  for (const auto& record : records) {
+    out = std::copy(record.begin(), record.end(), out);
+  }
+  return buffer;
+}
+
+std::vector<ServerState>
+ServerState::decodeList(const uint8_t* buf, size_t size)
+{
+  std::vector<ServerState> states;
+  size_t offset = 0;
+  while (offset < size) {
+    bool isOk = false;
+    Block record;
+    std::tie(isOk, record) = Block::fromBuffer(buf + offset, size - offset);
+    if (!isOk) {
+      throw ::ndn::tlv::Error("Truncated ServerState record");
+    }
+    offset += record.size();
+    states.emplace_back(record);
+  }
+  return states;
+}
+
+void
+ServerStateEncoder::setServer(const std::string& serverId, uint64_t services)
+{
+  m_serverId = toVector(::ndn::encoding::makeStringBlock(ServerState::TLV_SERVER_ID, serverId));
+  m_services = toVector(::ndn::encoding::makeNonNegativeIntegerBlock(ServerState::TLV_SERVICES,
+                                                                     services));
+
+  // TLV-TYPE and TLV-LENGTH of the record, and the largest Utilization element
+  m_wire.resize(1 + 9 + m_serverId.size() + 1 + 1 + sizeof(uint32_t) + m_services.size());
+}
+
+std::pair<const uint8_t*, size_t>
+ServerStateEncoder::encode(uint32_t utilization)
+{
+  size_t nUtilizationBytes = ::ndn::tlv::sizeOfNonNegativeInteger(utilization);
+  size_t length = m_serverId.size() + 2 + nUtilizationBytes + m_services.size();
+
+  uint8_t* begin = m_wire.data();
+  uint8_t* pos = writeVarNumber(begin, ServerState::TLV_SERVER_STATE);
+  pos = writeVarNumber(pos, length);
+  pos = std::copy(m_serverId.begin(), m_serverId.end(), pos);
+  *pos++ = ServerState::TLV_UTILIZATION;
+  *pos++ = static_cast<uint8_t>(nUtilizationBytes);
+  for (size_t i = nUtilizationBytes; i > 0; --i) {
+    *pos++ = static_cast<uint8_t>(utilization >> (8 * (i - 1)));
+  }
+  pos = std::copy(m_services.begin(), m_services.end(), pos);
+  return {begin, static_cast<size_t>(pos - begin)};
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,160 @@
+/*
+ * Copyright ( C ) 2020 New Mexico State University- Board of Regents
+ *
+ * See AUTHORS.md for complete list of authors and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * ( at your option ) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef NDN_PEC_SERVER_STATE_H
+#define NDN_PEC_SERVER_STATE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <ndn-cxx/encoding/buffer.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndnQoS
+ * @brief State of a PEC server as reported during service discovery
+ *
+ * The state is carried as a compact TLV record:
+ *
+ *     ServerState ::= SERVER-STATE-TYPE TLV-LENGTH
+ *                       ServerId     (string)
+ *                       Utilization  (NonNegativeInteger)
+ *                       Services     (NonNegativeInteger, bit N set if service N is offered)
+ *
+ * PECServer puts a single record into update Interests and service Data, BaseStation
+ * concatenates the records of all gathered servers into the content of its Data, and
+ * intelConsumer decodes either form.
+ */
+class ServerState {
+public:
+  enum {
+    TLV_SERVER_STATE = 200,
+    TLV_SERVER_ID = 201,
+    TLV_UTILIZATION = 202,
+    TLV_SERVICES = 203
+  };
+
+  /// @brief Maximum service number that can be represented
+  static const uint32_t MAX_SERVICE = 63;
+
+  ServerState();
+
+  ServerState(const std::string& serverId, uint32_t utilization, uint64_t services);
+
+  explicit ServerState(const Block& wire);
+
+  const std::string&
+  getServerId() const
+  {
+    return m_serverId;
+  }
+
+  uint32_t
+  getUtilization() const
+  {
+    return m_utilization;
+  }
+
+  uint64_t
+  getServices() const
+  {
+    return m_services;
+  }
+
+  bool
+  hasService(uint32_t service) const;
+
+  Block
+  wireEncode() const;
+
+  /**
+   * @throw ::ndn::tlv::Error if the record is malformed
+   */
+  void
+  wireDecode(const Block& wire);
+
+public:
+  /**
+   * @brief Convert utilization to the reported value, clamped to [0, UINT32_MAX]
+   */
+  static uint32_t
+  toUtilization(double utilization);
+
+  /**
+   * @brief Convert space-separated list of service numbers (e.g., "1 2 3") into a service set
+   */
+  static uint64_t
+  parseServices(const std::string& services);
+
+  /**
+   * @brief Concatenate wire encodings of several records into one buffer (e.g., Data content)
+   */
+  static shared_ptr<::ndn::Buffer>
+  concatenate(const std::vector<Block>& records);
+
+  /**
+   * @brief Decode all records contained in Data content or Interest payload
+   * @param buf  first byte of the sequence of records
+   * @param size size of the sequence
+   * @throw ::ndn::tlv::Error if any of the records is malformed
+   */
+  static std::vector<ServerState>
+  decodeList(const uint8_t* buf, size_t size);
+
+private:
+  std::string m_serverId;
+  uint32_t m_utilization;
+  uint64_t m_services;
+};
+
+/**
+ * @ingroup ndnQoS
+ * @brief Writes the ServerState records of one server without allocating
+ *
+ * Server id and services do not change while the server runs, so they are encoded once by
+ * setServer().  encode() only writes the utilization into a buffer owned by the encoder; the
+ * result is the same as ServerState::wireEncode().
+ */
+class ServerStateEncoder {
+public:
+  void
+  setServer(const std::string& serverId, uint64_t services);
+
+  /**
+   * @return first byte and size of the record, valid until the next call
+   */
+  std::pair<const uint8_t*, size_t>
+  encode(uint32_t utilization);
+
+private:
+  std::vector<uint8_t> m_serverId; ///< @brief encoded ServerId element
+  std::vector<uint8_t> m_services; ///< @brief encoded Services element
+  std::vector<uint8_t> m_wire;     ///< @brief large enough for any utilization
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PEC_SERVER_STATE_H
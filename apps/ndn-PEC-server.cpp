@@ -19,6 +19,7 @@
  */
 
 #include "ndn-PEC-server.hpp"
+#include "ndn-PEC-server-state.hpp"
 #include "ns3/ptr.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -81,8 +82,11 @@ PECServer::GetTypeId( void )
                     MakeTimeAccessor( &PECServer::GetRetxTimer, &PECServer::SetRetxTimer ),
                     MakeTimeChecker() )
 
-      .AddAttribute( "RetransmitPackets", "Retransmit lost packets if set to 1, otherwise do not perform retransmission", IntegerValue( 1 ),
-                    MakeIntegerAccessor( &PECServer::m_doRetransmission ), MakeIntegerChecker<int32_t>() )
+      .AddAttribute( "TaskLifetime",
+                    "Time after which a compute task that is not being computed is forgotten",
+                    StringValue( "10s" ),
+                    MakeTimeAccessor( &PECServer::GetTaskLifetime, &PECServer::SetTaskLifetime ),
+                    MakeTimeChecker() )
 
       .AddAttribute( "Offset", "Random offset to randomize sending of interests", IntegerValue( 0 ),
                     MakeIntegerAccessor( &PECServer::m_offset ), MakeIntegerChecker<int32_t>() )
@@ -123,6 +127,13 @@ PECServer::GetTypeId( void )
       .AddAttribute( "ComRate", "Rate used to multiply against computed com time", DoubleValue( 1 ),
                     MakeIntegerAccessor( &PECServer::m_cr ), MakeDoubleChecker<double>() )
 
+      .AddAttribute( "AnswerObtain",
+                    "Answer obtain Interests with the 1024-byte result once their task is computed, "
+                    "instead of handling them as compute requests like the original server. "
+                    "Changes PEC latency results, as clients then wait for the computation.",
+                    BooleanValue( false ),
+                    MakeBooleanAccessor( &PECServer::m_answerObtain ), MakeBooleanChecker() )
+
 
       .AddTraceSource( "LastRetransmittedInterestDataDelay",
                       "Delay between last retransmitted Interest and received Data",
@@ -165,17 +176,38 @@ PECServer::GetTypeId( void )
 PECServer::PECServer()
     : m_rand( CreateObject<UniformRandomVariable>() )
     , m_comTime( CreateObject<NormalRandomVariable> ())
+    , m_utilRand( CreateObject<UniformRandomVariable>() )
     , m_seq( 0 )
     , m_seqMax( std::numeric_limits<uint32_t>::max() ) // set to max value on uint32
     , m_firstTime ( true )
-    , m_doRetransmission( 1 )
+    , m_serviceSet( 0 )
+    , m_answerObtain( false )
 {
    
    NS_LOG_FUNCTION_NOARGS();
    m_rtt = CreateObject<RttMeanDeviation>();
+   m_retx.SetRttEstimator( m_rtt );
    m_comTime->SetAttribute ("Mean", DoubleValue (1.0));
    m_comTime->SetAttribute ("Variance", DoubleValue (0.03));
 
+   // same classification as the original getSubName comparisons: every compute name, also of
+   // obtain Interests unless AnswerObtain is set, is a compute request, except names that end
+   // with "obtain", which only get empty content
+   m_interestDispatcher.add( NamePattern().at( 1, PECNames::COMPUTE ).at( -2, PECNames::OBTAIN ),
+                             [this] ( shared_ptr<const Interest> i ) {
+                               if ( m_answerObtain ) OnObtainInterest( i );
+                               else OnComputeInterest( i );
+                             } );
+   m_interestDispatcher.add( NamePattern().at( 1, PECNames::COMPUTE ).at( -1, PECNames::OBTAIN ),
+                             [this] ( shared_ptr<const Interest> i ) {
+                               ReplyContent( i->getName(), nullptr, 0 );
+                             } );
+   m_interestDispatcher.add( NamePattern().at( 1, PECNames::COMPUTE ),
+                             [this] ( shared_ptr<const Interest> i ) { OnComputeInterest( i ); } );
+   m_interestDispatcher.add( NamePattern().at( 1, PECNames::BASE_QUERY ),
+                             [this] ( shared_ptr<const Interest> i ) { OnBaseQueryInterest( i ); } );
+   m_dataDispatcher.add( NamePattern().at( 1, PECNames::INPUT ).atLeast( 3 ),
+                         [this] ( shared_ptr<const Data> d ) { OnInputData( d ); } );
 }
 
 
@@ -203,55 +235,43 @@ PECServer::ScheduleNextPacket()
 void
 PECServer::SetRetxTimer( Time retxTimer )
 {
-
-	// Do not restranmit lost packets, if set to 0
-	if ( m_doRetransmission == 1 ) {
-
-		m_retxTimer = retxTimer;
-
-		if ( m_retxEvent.IsRunning() ) {
-
-			//m_retxEvent.Cancel (); // cancel any scheduled cleanup events
-			Simulator::Remove( m_retxEvent ); // slower, but better for memory
-		}
-
-		// Schedule even with new timeout
-		m_retxEvent = Simulator::Schedule( m_retxTimer, &PECServer::CheckRetxTimeout, this );
-	}
+	m_retx.SetGranularity( retxTimer );
 }
 
 
 Time
 PECServer::GetRetxTimer() const
 {
-	return m_retxTimer;
+	return m_retx.GetGranularity();
 }
 
+
 void
-PECServer::CheckRetxTimeout()
+PECServer::SetTaskLifetime( Time lifetime )
 {
-	Time now = Simulator::Now();
+	m_tasks.setLifetime( lifetime );
+}
 
-	Time rto = m_rtt->RetransmitTimeout();
 
-	//NS_LOG_DEBUG ( "Current RTO: " << rto.ToDouble ( Time::S ) << "s" );
+Time
+PECServer::GetTaskLifetime() const
+{
+	return m_tasks.getLifetime();
+}
 
-	while ( !m_seqTimeouts.empty() ) {
 
-		SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-			m_seqTimeouts.get<i_timestamp>().begin();
+int
+PECServer::RandomInteger( int range )
+{
+	// replaces rand() % range, which shared one global state between all applications
+	return range > 0 ? int( m_utilRand->GetInteger( 0, range - 1 ) ) : 0;
+}
 
-		// timeout expired?
-		if ( entry->time + rto <= now ) {
-			uint32_t seqNo = entry->seq;
-			m_seqTimeouts.get<i_timestamp>().erase( entry );
-			OnTimeout( seqNo );
-		} else {
-			break; // nothing else to do. All later packets need not be retransmitted
-		}
-	}
 
-	m_retxEvent = Simulator::Schedule( m_retxTimer, &PECServer::CheckRetxTimeout, this );
+double
+PECServer::GetPromisedUtilization() const
+{
+	return m_utilization + m_tasks.getPromisedUtil();
 }
 
 
@@ -262,22 +282,25 @@ PECServer::StartApplication()
 {
 	NS_LOG_FUNCTION_NOARGS();
 	App::StartApplication();
+	m_retx.SetLifetime( m_interestLifeTime );
         //std::cout<<m_prefix<<std::endl;
         m_prefixWithoutSequence = m_prefix;
 	Name servicePrefix = m_prefix.getSubName(0,1);
-	servicePrefix.append("service");
+	servicePrefix.append(PECNames::SERVICE);
         Name basePrefix = m_prefix.getSubName(0,1);
-	basePrefix.append("baseQuery");
+	basePrefix.append(PECNames::BASE_QUERY);
 	Name computePrefix = m_prefix.getSubName(0,1);
-	computePrefix.append("compute");
+	computePrefix.append(PECNames::COMPUTE);
 	computePrefix.append(m_prefix.getSubName(1,1).toUri());
         FibHelper::AddRoute(GetNode(), servicePrefix, m_face, 0);
         FibHelper::AddRoute(GetNode(), basePrefix , m_face, 0);
 	FibHelper::AddRoute(GetNode(), computePrefix, m_face, 0);
-        m_utilization = rand()%m_uRange+m_uMin;
+        m_utilization = RandomInteger( m_uRange ) + m_uMin;
 
-        std::string server = m_interestName.getSubName(2,1).toUri();
-        m_serverUpdate(GetNode()->GetId(), server, m_utilization);
+        m_serverId = m_interestName.getSubName(2,1).toUri() + m_interestName.getSubName(3,1).toUri().substr(1);
+        m_serviceSet = ServerState::parseServices(m_services);
+        m_stateEncoder.setServer(m_serverId, m_serviceSet);
+        m_serverUpdate(GetNode()->GetId(), m_serverId, m_utilization);
 
         if(!m_inServer)Simulator::Schedule( m_changeInterval, &PECServer::SwitchStatus, this );
 	ScheduleNextPacket();
@@ -293,7 +316,7 @@ PECServer::StopApplication() // Called at time specified by Stop
 
 void
 PECServer::SwitchStatus() {
-   int change = rand()%10000;
+   int change = RandomInteger( 10000 );
    if(change >= 6500)
       accepting = !accepting;
    if(!m_inServer)Simulator::Schedule( m_changeInterval, &PECServer::SwitchStatus, this );
@@ -303,8 +326,6 @@ void
 PECServer::SendPacket()
 {
 
-          std::string server = m_interestName.getSubName(2,1).toUri() + m_interestName.getSubName(3,1).toUri().substr(1);
-
 	// Set default size for payload interets
 	if (  m_virtualPayloadSize == 0 ) {
 		m_virtualPayloadSize = 4;
@@ -334,19 +355,10 @@ PECServer::SendPacket()
 
 	seq = m_seq++;
        	//uint8_t payload[1] = {1};
-        std::string payload = m_interestName.getSubName(2,1).toUri() + m_interestName.getSubName(3,1).toUri().substr(1);
-        double promUtil = m_utilization;
-        for (auto i : pendingUtil) {
-           promUtil += i.second;
-        }
-
-        payload +=  ","+std::to_string(int(promUtil));
-        m_serverUpdate(GetNode()->GetId(), server, promUtil);
-
-        std::vector<std::string> services = SplitString(m_services, ' ');
-	for (uint32_t i = 0; i < services.size(); i++ ){
-		payload +=  ","+services[i];	
-	}
+        double promUtil = GetPromisedUtilization();
+        m_serverUpdate(GetNode()->GetId(), m_serverId, promUtil);
+
+        auto state = m_stateEncoder.encode(ServerState::toUtilization(promUtil));
 	
 	shared_ptr<Name> nameWithSequence = make_shared<Name>( m_interestName );
 
@@ -363,9 +375,7 @@ PECServer::SendPacket()
         else 
 		m_available = 0;
 
-        std::vector<uint8_t> myVector( payload.begin(), payload.end() );
-        uint8_t *p = &myVector[0];
-        interest->setPayload( p, myVector.size()); // Add payload to interest
+        interest->setPayload( state.first, state.second ); // Add server state to interest
 
 
 	interest->setName( *nameWithSequence );
@@ -437,7 +447,10 @@ PECServer::SendInputRequest(Name clientName, int packetsLeft)
   m_transmittedInterests(interest, this, m_face);
   m_appLink->onReceiveInterest(*interest);
   packetsLeft--;
-  pendingInput[clientName]++;
+  PECTaskTable::Task* task = m_tasks.findByInput(clientName);
+  if(task != nullptr){
+     task->nPendingInputs++;
+  }
   if(packetsLeft != 0){
      Simulator::Schedule(Seconds(double(0.001)), &PECServer::SendInputRequest, this, clientName, packetsLeft);
   }
@@ -468,19 +481,7 @@ PECServer::OnData( shared_ptr<const Data> data )
 
 	// Callback for received subscription data
 	m_receivedData( GetNode()->GetId(), data );
-        if(data->getName().getSubName(1,1).toUri()=="/input"){
-            Name clientName = data->getName().getSubName(0,3);
-	    pendingInput[clientName]--;
-	    if(pendingInput[clientName]<=0){
-               pendingInput.erase(clientName);
-               Name dName = inputMap[clientName].getSubName(0,  inputMap[clientName].size()-1) ;
-               dName.append("obtain");
-               dName.append(inputMap[clientName].getSubName(-1, 1));
-               inputMap.erase(clientName);
-               pendingData[dName] = 0;  
-               ScheduleComputeTime(dName);
-	    }
-	}
+	m_dataDispatcher.dispatch( data->getName(), data );
 
 	int hopCount = 0;
 	auto hopCountTag = data->getTag<lp::HopCountTag>();
@@ -495,24 +496,14 @@ PECServer::OnData( shared_ptr<const Data> data )
 
 		// This could be a problem......
 		uint32_t seq = data->getName().at( -1 ).toSequenceNumber();
-		SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find( seq );
-
-		if ( entry != m_seqLastDelay.end() ) {
-			m_lastRetransmittedInterestDataDelay( this, seq, Simulator::Now() - entry->time, hopCount );
-		}
+		RetxTracker::Delays delays;
 
-		entry = m_seqFullDelay.find( seq );
-
-		if ( entry != m_seqFullDelay.end() ) {
-			m_firstInterestDataDelay( this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount );
+		if ( m_retx.Acked( seq, delays ) ) {
+			m_lastRetransmittedInterestDataDelay( this, seq, delays.lastDelay, hopCount );
+			m_firstInterestDataDelay( this, seq, delays.fullDelay, delays.retxCount, hopCount );
 		}
 
-		m_seqRetxCounts.erase( seq );
-		m_seqFullDelay.erase( seq );
-		m_seqLastDelay.erase( seq );
-		m_seqTimeouts.erase( seq );
 		m_retxSeqs.erase( seq );
-		m_rtt->AckSeq( SequenceNumber32( seq ) );
 
 	//data = nullptr;
 	//data.reset();
@@ -532,6 +523,15 @@ PECServer::OnTimeout( uint32_t sequenceNumber )
 	//ScheduleNextPacket();
 }
 
+void
+PECServer::OnInputData(shared_ptr<const Data> data)
+{
+    PECTaskTable::Task* task = m_tasks.findByInput(data->getName().getPrefix(3));
+    if(task != nullptr && --task->nPendingInputs <= 0){
+       ScheduleComputeTime(*task);
+    }
+}
+
 void
 PECServer::OnInterest(shared_ptr<const Interest> interest)
 {
@@ -541,199 +541,156 @@ PECServer::OnInterest(shared_ptr<const Interest> interest)
     if(!accepting)
       return;
 
-
-
     // Callback for received interests
     m_receivedInterest(GetNode()->GetId(), interest);
-    std::string payload = "";
-    bool sendManifest = false;
-    if (interest->getName().getSubName(1,1) == "/compute" && interest->getName().getSubName(-1,1)!="obtain"){
-        
-       /*if(interest->getName().getSubName(3,1) == "/execute"){
-	  pendingUtil.erase(interest->getName().getSubName(2,1).toUri());
-          Name dName = interest->getName().toUri();
-          ScheduleComputeTime(dName);
-	  return;
-       }
-       else{*/ 
-          double util = rand()%m_uRaiseRange+(m_uRaise-m_uRaiseRange/2);
-	  pendingUtil[interest->getName().getSubName(2,1).toUri()] = util;
-
-          std::string server = m_interestName.getSubName(2,1).toUri()  + m_interestName.getSubName(3,1).toUri().substr(1);
-	  double promUtil = m_utilization;
-          for (auto i : pendingUtil) {
-             promUtil += i.second;
-          }
-          m_serverUpdate(GetNode()->GetId(), server, promUtil);
-          Name cname = "prefix/input/";
-	  cname.append(interest->getName().getSubName(-2,1));
-	  pendingInput[cname] = 0;
-	  inputMap[cname] =  interest->getName().toUri();
-	  Simulator::Schedule(Seconds(double(0.001)), &PECServer::SendInputRequest, this, cname, 8);
-
-          //sendManifest = true;
-          //return; 
-	  double BCT = std::max((double)0, m_comTime->GetValue());
-	  double computeTime = BCT * (m_cr+m_utilization/100);
-          payload = std::to_string(computeTime);
-       //}
-    }
-    else if(interest->getName().getSubName(1,1) == "/baseQuery"){
-	SendPacket();
-    }
-    if(interest->getName().getSubName(-11,1) == "/obtain"){
-       if(pendingData.find(interest->getName()) == pendingData.end()) return;
-       if(pendingData[interest->getName()] == 0 || pendingData[interest->getName()] == 1 ){
-          pendingData[interest->getName()] = 1;
-          return;
-       }
-       if(pendingData[interest->getName()] == 2){
-          pendingData.erase(interest->getName());
-       }
+
+    if(!m_interestDispatcher.dispatch(interest->getName(), interest)){
+       OnServiceInterest(interest);
     }
-    if (!m_active)
-        return;
+}
 
-    auto data = make_shared<Data>();
-    data->setName(interest->getName());
-    data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
+void
+PECServer::OnComputeInterest(shared_ptr<const Interest> interest)
+{
+    const Name& name = interest->getName();
+    double util = RandomInteger( m_uRaiseRange ) + ( m_uRaise-m_uRaiseRange/2 );
+    Name cname = name.getPrefix(1);
+    cname.append(PECNames::INPUT);
+    cname.append(name.get(-2));
+    Name dName = name.getPrefix(-1);
+    dName.append(PECNames::OBTAIN);
+    dName.append(name.get(-1));
+    m_tasks.insert(cname, dName, util);
+
+    m_serverUpdate(GetNode()->GetId(), m_serverId, GetPromisedUtilization());
+    Simulator::Schedule(Seconds(double(0.001)), &PECServer::SendInputRequest, this, cname, 8);
+
+    double BCT = std::max((double)0, m_comTime->GetValue());
+    double computeTime = BCT * (m_cr+m_utilization/100);
+    std::string payload = std::to_string(computeTime);
+    ReplyContent(name, reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+}
 
-    std::string serverInfo = "";
-    if(sendManifest){
-       serverInfo += "5";
-    }
-    else{
-       serverInfo += m_interestName.getSubName(2,1).toUri() + m_interestName.getSubName(3,1).toUri().substr(1);
-       double promUtil = m_utilization;
-       for (auto i : pendingUtil) {
-         promUtil += i.second; 
-       }
-
-       serverInfo += ","+std::to_string(int(promUtil));
-       std::vector<std::string> services = SplitString(m_services, ' ');
-       for (uint32_t i= 0; i < services.size(); i++ ){
-          serverInfo +=  ","+services[i];
-       }
-    }
-    if(interest->getName().getSubName(1,1) == "/baseQuery")
-    data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
- 
-    else if (interest->getName().getSubName(1,1) == "/compute"){
-       std::vector<uint8_t> myVector( payload.begin(), payload.end() );
-       uint8_t *p = &myVector[0];
-       data->setContent( p, myVector.size()); // Add payload to interest
+void
+PECServer::OnObtainInterest(shared_ptr<const Interest> interest)
+{
+    if(ReleaseResult(interest->getName())){
+       SendContent(interest->getName(), nullptr, 1024); // result, as sent by SendData
     }
-    else{
-       std::vector<uint8_t> myVector( serverInfo.begin(), serverInfo.end() );  
-       uint8_t *p = &myVector[0];
-       data->setContent( p, myVector.size()); // Add payload to interest
+}
+
+bool
+PECServer::ReleaseResult(const Name& dataName)
+{
+    PECTaskTable::Task* task = m_tasks.findByData(dataName);
+    if(task == nullptr || task->state == PECTaskTable::WAITING_INPUT) return false;
+    if(task->state != PECTaskTable::COMPUTED){
+       task->isObtainPending = true; // data is sent once computed
+       return false;
     }
-    Signature signature;
-    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+    m_tasks.erase(*task);
+    return true;
+}
+
+void
+PECServer::OnBaseQueryInterest(shared_ptr<const Interest> interest)
+{
+    SendPacket();
+    ReplyContent(interest->getName(), nullptr, m_virtualPayloadSize);
+}
 
-    if (m_keyLocator.size() > 0) {
-        signatureInfo.setKeyLocator(m_keyLocator);
+void
+PECServer::OnServiceInterest(shared_ptr<const Interest> interest)
+{
+    double promUtil = GetPromisedUtilization();
+    auto serverInfo = m_stateEncoder.encode(ServerState::toUtilization(promUtil));
+    ReplyContent(interest->getName(), serverInfo.first, serverInfo.second);
+}
+
+void
+PECServer::ReplyContent(const Name& name, const uint8_t* content, size_t contentSize)
+{
+    // the original obtain check looked at the 11th component from the end, or the first one of
+    // shorter names, which PEC names never have there
+    ssize_t obtainIndex = std::max<ssize_t>(static_cast<ssize_t>(name.size()) - 11, 0);
+    if(isComponent(name, obtainIndex, PECNames::OBTAIN) && !ReleaseResult(name)){
+       return;
     }
+    SendContent(name, content, contentSize);
+}
 
-    signature.setInfo(signatureInfo);
-    signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
+void
+PECServer::SendContent(const Name& dataName, const uint8_t* content, size_t contentSize)
+{
+    if (!m_active)
+        return;
 
-    data->setSignature(signature);
+    m_dataTemplate.SetFields(m_freshness, m_signature, m_keyLocator);
+    auto data = m_dataTemplate.Create(dataName, content, contentSize);
 
     NS_LOG_INFO("node(" << GetNode()->GetId() << ") sending DATA for " << data->getName() << " TIME: " << Simulator::Now());
 
-    // to create real wire encoding
-    data->wireEncode();
-
     m_transmittedDatas(data, this, m_face);
     m_appLink->onReceiveData(*data);
 
     // Callback for tranmitted subscription data
     m_sentData(GetNode()->GetId(), data);
-
 }
 
 void
-PECServer::ScheduleComputeTime(const Name &dataName){
+PECServer::ScheduleComputeTime(PECTaskTable::Task& task){
   //get sompute time
   double BCT = std::max((double)0, m_comTime->GetValue());
   double computeTime = BCT * (m_cr+m_utilization/100);
   //std::cout<<"Base time: "<<BCT<<" Real time: "<<computeTime<<std::endl;
-  double util = rand()%m_uRaiseRange+(m_uRaise-m_uRaiseRange/2);
+  double util = RandomInteger( m_uRaiseRange ) + ( m_uRaise-m_uRaiseRange/2 );
   //check if there is enough utilization for request
   if( (m_utilization + util) > 100.0){
-     pendingRequests.push_back(dataName);
+     m_tasks.setState(task, PECTaskTable::QUEUED);
      return;
   }
   m_utilization += util;
-  double promUtil = m_utilization;
-  for (auto i : pendingUtil) {
-     promUtil += i.second;
-  }
+  m_tasks.setState(task, PECTaskTable::COMPUTING);
+  double promUtil = GetPromisedUtilization();
 
-  std::string server = m_interestName.getSubName(2,1).toUri()  + m_interestName.getSubName(3,1).toUri().substr(1);
   if(!accepting){
-     m_serverUpdate(GetNode()->GetId(), server, 1000);
+     m_serverUpdate(GetNode()->GetId(), m_serverId, 1000);
   }
-  else m_serverUpdate(GetNode()->GetId(), server, promUtil);
+  else m_serverUpdate(GetNode()->GetId(), m_serverId, promUtil);
 
-  Simulator::Schedule(Seconds(computeTime), &PECServer::SendData, this, dataName, util);
-  m_executeTime(GetNode()->GetId(), server, computeTime);
+  Simulator::Schedule(Seconds(computeTime), &PECServer::SendData, this, task.id, util);
+  m_executeTime(GetNode()->GetId(), m_serverId, computeTime);
 }
 
 
 void
-PECServer::SendData(const Name &dataName, double util)
+PECServer::SendData(PECTaskTable::TaskId id, double util)
 {
     if (!m_active)
         return;
 
-    if(pendingData[dataName] == 0){
-       pendingData[dataName] = 2;
-       return;
-    }
-    else if(pendingData[dataName] == 2) return;
-
     m_utilization -= util;
-    if(!pendingRequests.empty()){
-       ScheduleComputeTime( pendingRequests.front());
-       pendingRequests.erase(pendingRequests.begin());     
+    PECTaskTable::Task* next = m_tasks.popQueued();
+    if(next != nullptr){
+       ScheduleComputeTime(*next);
     }
 
-    auto data = make_shared<Data>();
-    data->setName(dataName);
-    data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
-
-    data->setContent( make_shared< ::ndn::Buffer>(1024)); // Add payload to interest
-
-    Signature signature;
-    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
-
-    if (m_keyLocator.size() > 0) {
-        signatureInfo.setKeyLocator(m_keyLocator);
+    if(!accepting){
+       m_serverUpdate(GetNode()->GetId(), m_serverId, 1000);
     }
+    else m_serverUpdate(GetNode()->GetId(), m_serverId, m_utilization);
 
-    signature.setInfo(signatureInfo);
-    signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
-
-    data->setSignature(signature);
-
-    NS_LOG_INFO("node(" << GetNode()->GetId() << ") sending DATA for " << data->getName() << " TIME: " << Simulator::Now());
-    // to create real wire encoding
-    data->wireEncode();
-
-    m_transmittedDatas(data, this, m_face);
-    m_appLink->onReceiveData(*data);
-
-    // Callback for tranmitted subscription data
-    m_sentData(GetNode()->GetId(), data);
-
-    std::string server = m_interestName.getSubName(2,1).toUri() + m_interestName.getSubName(3,1).toUri().substr(1);
-  if(!accepting){
-     m_serverUpdate(GetNode()->GetId(), server, 1000);
-  }
-  else m_serverUpdate(GetNode()->GetId(), server, m_utilization);
+    PECTaskTable::Task* task = m_tasks.find(id);
+    if(task == nullptr)
+        return;
+    if(!task->isObtainPending){
+       m_tasks.setState(*task, PECTaskTable::COMPUTED); // wait for the obtain Interest
+       return;
+    }
+    Name dataName = task->dataName;
+    m_tasks.erase(*task);
 
+    SendContent(dataName, nullptr, 1024);
 }
 
 
@@ -741,13 +698,8 @@ void
 PECServer::WillSendOutInterest( uint32_t sequenceNumber )
 {
 	NS_LOG_DEBUG( "Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-			<< m_seqTimeouts.size() << " items" );
-	//m_seqTimeouts.insert( SeqTimeout( sequenceNumber, Simulator::Now() ) );
-	m_seqFullDelay.insert( SeqTimeout( sequenceNumber, Simulator::Now() ) );
-	m_seqLastDelay.erase( sequenceNumber );
-	m_seqLastDelay.insert( SeqTimeout( sequenceNumber, Simulator::Now() ) );
-	m_seqRetxCounts[sequenceNumber]++;
-	m_rtt->SentSeq( SequenceNumber32( sequenceNumber ), 1 );
+			<< m_retx.GetSize() << " items" );
+	m_retx.Sent( sequenceNumber );
 }
 
 
@@ -31,14 +31,15 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
+#include "ns3/ndnSIM/utils/ndn-retx-tracker.hpp"
+#include "ns3/ndnSIM/utils/ndn-data-template.hpp"
+#include "ndn-PEC-task-table.hpp"
+#include "ndn-PEC-server-state.hpp"
+#include "ndn-PEC-name-dispatcher.hpp"
 
 #include <set>
 #include <map>
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include <functional>
 
 namespace ns3 {
 namespace ndn {
@@ -132,12 +133,6 @@ protected:
   void
   ScheduleNextPacket();
 
-  /**
-   * \brief Checks if the packet need to be retransmitted becuase of retransmission timer expiration
-   */
-  void
-  CheckRetxTimeout();
-
   void
   SwitchStatus();
 
@@ -156,23 +151,93 @@ protected:
   GetRetxTimer() const;
 
   void
-  ScheduleComputeTime(const Name &dataName);
+  SetTaskLifetime(Time lifetime);
+
+  Time
+  GetTaskLifetime() const;
+
+  /**
+   * @brief Draw an integer uniformly from [0, range) from the random stream of the server
+   */
+  int
+  RandomInteger(int range);
+
+  /**
+   * @brief Utilization of the server plus the utilization promised to tasks waiting for input
+   *
+   * Both parts are maintained as tasks are admitted and completed, so reports do not iterate
+   * over pending tasks.
+   */
+  double
+  GetPromisedUtilization() const;
+
+  /**
+   * @brief Start computing @p task if enough utilization is left, otherwise queue it
+   */
+  void
+  ScheduleComputeTime(PECTaskTable::Task& task);
 
   /**
-  * @brief Send computation data.
+  * @brief Finish computation of a task and send its data if the obtain Interest arrived.
   */
   void
-  SendData(const Name &dataName, double util);
+  SendData(PECTaskTable::TaskId id, double util);
+
+  /**
+   * @brief Accept a compute request and reply with the expected compute time
+   */
+  void
+  OnComputeInterest(shared_ptr<const Interest> interest);
+
+  /**
+   * @brief Reply with the result of a computed task, or hold the Interest until it is computed
+   *
+   * Only used if AnswerObtain is set.
+   */
+  void
+  OnObtainInterest(shared_ptr<const Interest> interest);
+
+  /**
+   * @brief Remove the computed task of @p dataName, or mark its obtain Interest as pending
+   * @return true if the task was computed and its result can be sent
+   */
+  bool
+  ReleaseResult(const Name& dataName);
+
+  void
+  OnBaseQueryInterest(shared_ptr<const Interest> interest);
+
+  /**
+   * @brief Reply with the state of the server (service discovery)
+   */
+  void
+  OnServiceInterest(shared_ptr<const Interest> interest);
+
+  void
+  OnInputData(shared_ptr<const Data> data);
+
+  /**
+   * @brief Send Data named @p dataName with @p contentSize bytes of @p content, or of zeros if
+   *        @p content is nullptr
+   */
+  void
+  SendContent(const Name& dataName, const uint8_t* content, size_t contentSize);
+
+  /**
+   * @brief Answer the Interest for @p name with @p content, unless the original obtain check
+   *        holds it back
+   */
+  void
+  ReplyContent(const Name& name, const uint8_t* content, size_t contentSize);
 
 protected:
 
   Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
   Ptr<NormalRandomVariable> m_comTime;
+  Ptr<UniformRandomVariable> m_utilRand; ///< @brief utilization and status changes
   uint32_t m_seq;      ///< @brief currently requested sequence number
   uint32_t m_seqMax;   ///< @brief maximum number of sequence number
   EventId m_sendEvent; ///< @brief EventId of pending "send packet" event
-  Time m_retxTimer;    ///< @brief Currently estimated retransmission timer
-  EventId m_retxEvent; ///< @brief Event to check whether or not retransmission should be performed
 
   Time m_txInterval;
   Time m_changeInterval;
@@ -183,12 +248,12 @@ protected:
   bool m_firstTime;
   uint32_t m_available; //subscription value set by the application
   uint32_t m_virtualPayloadSize; //payload size for interest packet
-  uint32_t m_doRetransmission; //retransmit lost interest packets if set to 1
   uint32_t m_offset; //random offset
   Time m_freshness;
   uint32_t m_signature;
   uint32_t m_inServer;
   Name m_keyLocator;
+  DataTemplate m_dataTemplate;
   double m_utilization;
   double m_cr;
   int m_uMin;
@@ -196,11 +261,13 @@ protected:
   int m_uRaise;
   int m_uRaiseRange;
   std::string m_services;
-  std::vector<Name> pendingRequests;
-  std::unordered_map<std::string, double> pendingUtil;
-  std::unordered_map<Name, int> pendingInput;
-  std::unordered_map<Name, int> pendingData;
-  std::unordered_map<Name, Name> inputMap;
+  std::string m_serverId; ///< @brief server id in reports, set when the application starts
+  uint64_t m_serviceSet;  ///< @brief parsed m_services, set when the application starts
+  ServerStateEncoder m_stateEncoder; ///< @brief state reports, set when the application starts
+  bool m_answerObtain;    ///< @brief answer obtain Interests with results (AnswerObtain)
+  PECTaskTable m_tasks; ///< @brief accepted compute tasks
+  NameDispatcher<std::function<void(shared_ptr<const Interest>)>> m_interestDispatcher;
+  NameDispatcher<std::function<void(shared_ptr<const Data>)>> m_dataDispatcher;
   bool accepting = true;
 
   Ptr<RttEstimator> m_rtt; ///< @brief RTT estimator
@@ -213,57 +280,9 @@ protected:
   };
 
   RetxSeqsContainer m_retxSeqs; ///< \brief ordered set of sequence numbers to be retransmitted
-
-  /**
-   * \struct This struct contains a pair of packet sequence number and its timeout
-   */
-  struct SeqTimeout {
-    SeqTimeout(uint32_t _seq, Time _time)
-      : seq(_seq)
-      , time(_time)
-    {
-    }
-
-    uint32_t seq;
-    Time time;
-  };
-  /// @endcond
-
-  /// @cond include_hidden
-  class i_seq {
-  };
-  class i_timestamp {
-  };
   /// @endcond
 
-  /// @cond include_hidden
-   /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
-   */
-  struct SeqTimeoutsContainer
-    : public boost::multi_index::
-        multi_index_container<SeqTimeout,
-                              boost::multi_index::
-                                indexed_by<boost::multi_index::
-                                             ordered_unique<boost::multi_index::tag<i_seq>,
-                                                            boost::multi_index::
-                                                              member<SeqTimeout, uint32_t,
-                                                                     &SeqTimeout::seq>>,
-                                           boost::multi_index::
-                                             ordered_non_unique<boost::multi_index::
-                                                                  tag<i_timestamp>,
-                                                                boost::multi_index::
-                                                                  member<SeqTimeout, Time,
-                                                                         &SeqTimeout::time>>>> {
-  };
-  /// @endcond
-
-  SeqTimeoutsContainer m_seqTimeouts; ///< \brief multi-index for the set of SeqTimeout structs
-
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+  RetxTracker m_retx; ///< @brief tracker of outstanding sequence numbers
 
 
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
@@ -277,34 +296,6 @@ protected:
   TracedCallback <  uint32_t, shared_ptr<const Data> > m_sentData;
   TracedCallback < uint32_t, std::string, int > m_serverUpdate;
   TracedCallback < uint32_t, std::string, double > m_executeTime;
-
-
-  std::vector<std::string>
-  SplitString( std::string strLine, char delimiter ) {
-
-        std::string str = strLine;
-        std::vector<std::string> result;
-        uint32_t i =0;
-        std::string buildStr = "";
-
-        for ( i = 0; i<str.size(); i++) {
-
-           if ( str[i]== delimiter ) {
-              result.push_back( buildStr );
-              buildStr = "";
-           }
-           else {
-              buildStr += str[i];
-           }
-        }
-
-        if(buildStr!="")
-           result.push_back( buildStr );
-
-        return result;
-}
-
-
 };
 
 } // namespace ndn
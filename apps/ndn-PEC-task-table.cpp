@@ -0,0 +1,189 @@
+/*
+ * Copyright ( C ) 2020 New Mexico State University- Board of Regents
+ *
+ * See AUTHORS.md for complete list of authors and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * ( at your option ) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ndn-PEC-task-table.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <functional>
+
+NS_LOG_COMPONENT_DEFINE("ndn.PECTaskTable");
+
+namespace ns3 {
+namespace ndn {
+
+PECTaskTable::PECTaskTable()
+  : m_nextId(0)
+  , m_promisedUtil(0)
+  , m_nQueued(0)
+  , m_deadlines([this] { return m_lifetime; },
+                std::bind(&PECTaskTable::expire, this, std::placeholders::_1))
+  , m_lifetime(Seconds(10))
+{
+}
+
+void
+PECTaskTable::setLifetime(Time lifetime)
+{
+  m_lifetime = lifetime;
+  m_deadlines.arm();
+}
+
+PECTaskTable::Task&
+PECTaskTable::insert(const Name& inputName, const Name& dataName, double promisedUtil)
+{
+  Task* previous = findByInput(inputName);
+  if (previous != nullptr) {
+    NS_LOG_DEBUG("Replace task " << previous->id << " waiting for " << inputName);
+    erase(*previous);
+  }
+  previous = findByData(dataName);
+  if (previous != nullptr) {
+    NS_LOG_DEBUG("Replace task " << previous->id << " for " << dataName);
+    erase(*previous);
+  }
+
+  TaskId id = m_nextId++;
+  Task& task = m_tasks[id];
+  task.id = id;
+  task.state = WAITING_INPUT;
+  task.inputName = inputName;
+  task.dataName = dataName;
+  task.promisedUtil = promisedUtil;
+  task.util = 0;
+  task.nPendingInputs = 0;
+  task.isObtainPending = false;
+  task.isQueued = false;
+
+  m_inputIndex[inputName] = id;
+  m_dataIndex[dataName] = id;
+  m_promisedUtil += promisedUtil;
+
+  m_deadlines.touch(task);
+  return task;
+}
+
+PECTaskTable::Task*
+PECTaskTable::find(TaskId id)
+{
+  auto task = m_tasks.find(id);
+  return task != m_tasks.end() ? &task->second : nullptr;
+}
+
+PECTaskTable::Task*
+PECTaskTable::findByInput(const Name& inputName)
+{
+  auto id = m_inputIndex.find(inputName);
+  return id != m_inputIndex.end() ? find(id->second) : nullptr;
+}
+
+PECTaskTable::Task*
+PECTaskTable::findByData(const Name& dataName)
+{
+  auto id = m_dataIndex.find(dataName);
+  return id != m_dataIndex.end() ? find(id->second) : nullptr;
+}
+
+void
+PECTaskTable::setState(Task& task, TaskState state)
+{
+  if (task.state == WAITING_INPUT && state != WAITING_INPUT) {
+    unindexInput(task);
+  }
+
+  if (task.isQueued) {
+    NS_ASSERT_MSG(state == QUEUED, "Queued task must be popped before it changes state");
+  }
+  else if (state == QUEUED) {
+    m_queue.push_back(task.id);
+    task.isQueued = true;
+    m_nQueued++;
+  }
+
+  task.state = state;
+  if (state == WAITING_INPUT || state == COMPUTED) {
+    m_deadlines.touch(task);
+  }
+  else {
+    m_deadlines.remove(task);
+  }
+}
+
+PECTaskTable::Task*
+PECTaskTable::popQueued()
+{
+  while (!m_queue.empty()) {
+    Task* task = find(m_queue.front());
+    m_queue.pop_front();
+    if (task != nullptr) {
+      task->isQueued = false;
+      m_nQueued--;
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+void
+PECTaskTable::erase(Task& task)
+{
+  if (task.state == WAITING_INPUT) {
+    unindexInput(task);
+  }
+  if (task.isQueued) {
+    m_nQueued--; // the id is skipped when popped
+  }
+  m_dataIndex.erase(task.dataName);
+
+  m_deadlines.remove(task);
+  TaskId id = task.id;
+  m_tasks.erase(id);
+
+  // drop ids of erased tasks once they make up most of the FIFO
+  if (m_queue.size() > 2 * m_nQueued + 16) {
+    m_queue.erase(std::remove_if(m_queue.begin(), m_queue.end(),
+                                 [this] (TaskId id) { return find(id) == nullptr; }),
+                  m_queue.end());
+  }
+}
+
+void
+PECTaskTable::unindexInput(Task& task)
+{
+  m_inputIndex.erase(task.inputName);
+  if (m_inputIndex.empty()) {
+    m_promisedUtil = 0; // do not accumulate rounding errors
+  }
+  else {
+    m_promisedUtil -= task.promisedUtil;
+  }
+}
+
+void
+PECTaskTable::expire(Task& task)
+{
+  NS_LOG_DEBUG("Forget task " << task.id << " in state " << task.state);
+  erase(task);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,182 @@
+/*
+ * Copyright ( C ) 2020 New Mexico State University- Board of Regents
+ *
+ * See AUTHORS.md for complete list of authors and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * ( at your option ) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef NDN_PEC_TASK_TABLE_H
+#define NDN_PEC_TASK_TABLE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-deadline-list.hpp"
+
+#include "ns3/nstime.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndnQoS
+ * @brief Compute tasks accepted by a PEC server
+ *
+ * A task is created when a compute Interest is accepted and goes through the following states:
+ *
+ *     WAITING_INPUT ----------> COMPUTING ---> COMPUTED
+ *           \                     ^
+ *            `----> QUEUED -------'
+ *
+ * Once all input Data has arrived, a task is QUEUED while the server does not have enough
+ * utilization left; queued tasks are kept in FIFO order.  The result of a COMPUTED task waits
+ * for the obtain Interest of the client.  The server erases a task once its result has been
+ * sent.
+ *
+ * Tasks are identified by a compact id and can also be looked up by the name prefix of their
+ * input Data and by the name of their obtain Interest.  A task that waits for input Data or
+ * for the obtain Interest for longer than the lifetime (lost input Data, abandoned obtain) is
+ * forgotten.  QUEUED and COMPUTING tasks do not expire, as they wait for the server only.
+ */
+class PECTaskTable : boost::noncopyable {
+public:
+  typedef uint32_t TaskId;
+
+  enum TaskState {
+    WAITING_INPUT,
+    QUEUED,
+    COMPUTING,
+    COMPUTED
+  };
+
+  struct Task : DeadlineListHook {
+    TaskId id;
+    TaskState state;
+    Name inputName;        ///< @brief name prefix of input Data
+    Name dataName;         ///< @brief name of obtain Interest and result Data
+    double util;           ///< @brief utilization taken while computing
+    int nPendingInputs;    ///< @brief number of requested input Data that did not arrive yet
+    bool isObtainPending;  ///< @brief obtain Interest arrived before the result was computed
+
+  private:
+    double promisedUtil;
+    bool isQueued;
+
+    friend class PECTaskTable;
+  };
+
+  PECTaskTable();
+
+  /**
+   * @brief Set time a task may wait for input Data or for the obtain Interest (default 10s)
+   */
+  void
+  setLifetime(Time lifetime);
+
+  Time
+  getLifetime() const
+  {
+    return m_lifetime;
+  }
+
+  /**
+   * @brief Create a task in WAITING_INPUT state
+   * @param promisedUtil utilization promised to the client until the task leaves WAITING_INPUT
+   *
+   * Tasks with the same input name that are still waiting for input, and tasks with the same
+   * data name, are erased.
+   */
+  Task&
+  insert(const Name& inputName, const Name& dataName, double promisedUtil);
+
+  Task*
+  find(TaskId id);
+
+  Task*
+  findByInput(const Name& inputName);
+
+  Task*
+  findByData(const Name& dataName);
+
+  /**
+   * @brief Change state of @p task
+   *
+   * A task set to QUEUED is appended to the FIFO of queued tasks.  A task in the FIFO must be
+   * removed with popQueued before its state can be changed.
+   */
+  void
+  setState(Task& task, TaskState state);
+
+  /**
+   * @brief Remove the least recently queued task from the FIFO of queued tasks
+   * @return the task, still in QUEUED state, or nullptr if the FIFO is empty
+   */
+  Task*
+  popQueued();
+
+  void
+  erase(Task& task);
+
+  size_t
+  size() const
+  {
+    return m_tasks.size();
+  }
+
+  size_t
+  getNQueued() const
+  {
+    return m_nQueued;
+  }
+
+  /**
+   * @brief Get total utilization promised to tasks in WAITING_INPUT state
+   */
+  double
+  getPromisedUtil() const
+  {
+    return m_promisedUtil;
+  }
+
+private:
+  void
+  unindexInput(Task& task);
+
+  void
+  expire(Task& task);
+
+private:
+  std::unordered_map<TaskId, Task> m_tasks;
+  std::unordered_map<Name, TaskId> m_inputIndex; ///< @brief tasks waiting for input
+  std::unordered_map<Name, TaskId> m_dataIndex;
+  TaskId m_nextId;
+  double m_promisedUtil;
+
+  /// @brief ids of QUEUED tasks in FIFO order; ids of erased tasks are skipped when popped
+  std::deque<TaskId> m_queue;
+  size_t m_nQueued;
+
+  DeadlineList<Task> m_deadlines; ///< @brief tasks waiting for input Data or obtain Interest
+  Time m_lifetime;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PEC_TASK_TABLE_H
@@ -73,9 +73,6 @@ QoSConsumer::GetTypeId( void )
                     MakeTimeAccessor( &QoSConsumer::GetRetxTimer, &QoSConsumer::SetRetxTimer ),
                     MakeTimeChecker() )
 
-      .AddAttribute( "RetransmitPackets", "Retransmit lost packets if set to 1, otherwise do not perform retransmission", IntegerValue( 1 ),
-                    MakeIntegerAccessor( &QoSConsumer::m_doRetransmission ), MakeIntegerChecker<int32_t>() )
-
       .AddAttribute( "Subscription", "Subscription value for the interest. 0-normal interest, 1-soft subscribe, 2-hard subscriber, 3-unsubsribe", IntegerValue( 2 ),
                     MakeIntegerAccessor( &QoSConsumer::m_subscription ), MakeIntegerChecker<int32_t>() )
 
@@ -113,10 +110,10 @@ QoSConsumer::QoSConsumer()
     , m_seq( 0 )
     , m_seqMax( std::numeric_limits<uint32_t>::max() ) // set to max value on uint32
     , m_firstTime ( true )
-    , m_doRetransmission( 1 )
 {
 	NS_LOG_FUNCTION_NOARGS();
 	m_rtt = CreateObject<RttMeanDeviation>();
+	m_retx.SetRttEstimator( m_rtt );
 }
 
 
@@ -144,55 +141,14 @@ QoSConsumer::ScheduleNextPacket()
 void
 QoSConsumer::SetRetxTimer( Time retxTimer )
 {
-
-	// Do not restranmit lost packets, if set to 0
-	if ( m_doRetransmission == 1 ) {
-
-		m_retxTimer = retxTimer;
-
-		if ( m_retxEvent.IsRunning() ) {
-
-			//m_retxEvent.Cancel (); // cancel any scheduled cleanup events
-			Simulator::Remove( m_retxEvent ); // slower, but better for memory
-		}
-
-		// Schedule even with new timeout
-		m_retxEvent = Simulator::Schedule( m_retxTimer, &QoSConsumer::CheckRetxTimeout, this );
-	}
+	m_retx.SetGranularity( retxTimer );
 }
 
 
 Time
 QoSConsumer::GetRetxTimer() const
 {
-	return m_retxTimer;
-}
-
-void
-QoSConsumer::CheckRetxTimeout()
-{
-	Time now = Simulator::Now();
-
-	Time rto = m_rtt->RetransmitTimeout();
-
-	//NS_LOG_DEBUG ( "Current RTO: " << rto.ToDouble ( Time::S ) << "s" );
-
-	while ( !m_seqTimeouts.empty() ) {
-
-		SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-			m_seqTimeouts.get<i_timestamp>().begin();
-
-		// timeout expired?
-		if ( entry->time + rto <= now ) {
-			uint32_t seqNo = entry->seq;
-			m_seqTimeouts.get<i_timestamp>().erase( entry );
-			OnTimeout( seqNo );
-		} else {
-			break; // nothing else to do. All later packets need not be retransmitted
-		}
-	}
-
-	m_retxEvent = Simulator::Schedule( m_retxTimer, &QoSConsumer::CheckRetxTimeout, this );
+	return m_retx.GetGranularity();
 }
 
 
@@ -203,6 +159,7 @@ QoSConsumer::StartApplication()
 {
 	NS_LOG_FUNCTION_NOARGS();
 	App::StartApplication();
+	m_retx.SetLifetime( m_interestLifeTime );
 	ScheduleNextPacket();
 }
 
@@ -314,24 +271,14 @@ QoSConsumer::OnData( shared_ptr<const Data> data )
 
 		// This could be a problem......
 		uint32_t seq = data->getName().at( -1 ).toSequenceNumber();
-		SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find( seq );
-
-		if ( entry != m_seqLastDelay.end() ) {
-			m_lastRetransmittedInterestDataDelay( this, seq, Simulator::Now() - entry->time, hopCount );
-		}
-
-		entry = m_seqFullDelay.find( seq );
+		RetxTracker::Delays delays;
 
-		if ( entry != m_seqFullDelay.end() ) {
-			m_firstInterestDataDelay( this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount );
+		if ( m_retx.Acked( seq, delays ) ) {
+			m_lastRetransmittedInterestDataDelay( this, seq, delays.lastDelay, hopCount );
+			m_firstInterestDataDelay( this, seq, delays.fullDelay, delays.retxCount, hopCount );
 		}
 
-		m_seqRetxCounts.erase( seq );
-		m_seqFullDelay.erase( seq );
-		m_seqLastDelay.erase( seq );
-		m_seqTimeouts.erase( seq );
 		m_retxSeqs.erase( seq );
-		m_rtt->AckSeq( SequenceNumber32( seq ) );
 	}
 
 	//data = nullptr;
@@ -356,13 +303,8 @@ void
 QoSConsumer::WillSendOutInterest( uint32_t sequenceNumber )
 {
 	NS_LOG_DEBUG( "Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-			<< m_seqTimeouts.size() << " items" );
-	//m_seqTimeouts.insert( SeqTimeout( sequenceNumber, Simulator::Now() ) );
-	m_seqFullDelay.insert( SeqTimeout( sequenceNumber, Simulator::Now() ) );
-	m_seqLastDelay.erase( sequenceNumber );
-	m_seqLastDelay.insert( SeqTimeout( sequenceNumber, Simulator::Now() ) );
-	m_seqRetxCounts[sequenceNumber]++;
-	m_rtt->SentSeq( SequenceNumber32( sequenceNumber ), 1 );
+			<< m_retx.GetSize() << " items" );
+	m_retx.Sent( sequenceNumber );
 }
 
 
@@ -175,22 +175,8 @@ QoSProducer::SendData(const Name &dataName)
 
     //std::cout << " ack payload= " << m_virtualPayloadSize << std::endl;
 
-    auto data = make_shared<Data>();
-    data->setName(dataName);
-    data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
-    data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
-
-    Signature signature;
-    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
-
-    if (m_keyLocator.size() > 0) {
-        signatureInfo.setKeyLocator(m_keyLocator);
-    }
-
-    signature.setInfo(signatureInfo);
-    signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
-
-    data->setSignature(signature);
+    m_dataTemplate.SetFields(m_freshness, m_signature, m_keyLocator);
+    auto data = m_dataTemplate.Create(dataName, m_virtualPayloadSize);
 
     if (m_subscription == 0 && m_receivedpayload > 0) {
         NS_LOG_INFO("node(" << GetNode()->GetId() << ") sending ACK: " << data->getName() << " TIME: " << Simulator::Now());
@@ -200,9 +186,6 @@ QoSProducer::SendData(const Name &dataName)
 
     //std::cout << "use count " << data.use_count() << " data content/payload size = " << data->getContent().value_size() << std::endl;
 
-    // to create real wire encoding
-    data->wireEncode();
-
     m_transmittedDatas(data, this, m_face);
     m_appLink->onReceiveData(*data);
 
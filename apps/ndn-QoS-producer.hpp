@@ -25,6 +25,7 @@
 
 #include "ndn-app.hpp"
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-data-template.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
@@ -91,6 +92,7 @@ private:
   
   uint32_t m_signature;
   Name m_keyLocator;
+  DataTemplate m_dataTemplate;
 
 protected:
   TracedCallback <  uint32_t, shared_ptr<const Interest> > m_receivedInterest;
@@ -19,6 +19,7 @@
  */
 
 #include "ndn-baseStation.hpp"
+#include "ndn-PEC-server-state.hpp"
 #include "ns3/log.h"
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
@@ -31,6 +32,7 @@
 #include "helper/ndn-fib-helper.hpp"
 #include <ndn-cxx/lp/tags.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <fstream>
 
@@ -116,7 +118,12 @@ BaseStation::BaseStation()
 {
     NS_LOG_FUNCTION_NOARGS();
   m_rtt = CreateObject<RttMeanDeviation>();
+  m_retx.SetRttEstimator(m_rtt);
 
+  m_interestDispatcher.add(NamePattern().at(1, PECNames::SERVICE),
+                           [this] (shared_ptr<const Interest> i) { OnServiceInterest(i); });
+  m_interestDispatcher.add(NamePattern().at(1, PECNames::UPDATE).atLeast(4),
+                           [this] (shared_ptr<const Interest> i) { OnUpdateInterest(i); });
 }
 
 // inherited from Application base class.
@@ -125,6 +132,7 @@ BaseStation::StartApplication()
 {
     NS_LOG_FUNCTION_NOARGS();
     App::StartApplication();
+    m_retx.SetLifetime(m_interestLifeTime);
 
     m_prefixWithoutSequence = m_prefix; //store prefix without sequence using to be used in log output
 
@@ -162,55 +170,14 @@ BaseStation::ScheduleNextPacket()
 void
 BaseStation::SetRetxTimer( Time retxTimer )
 {
-
-	// Do not restranmit lost packets, if set to 0
-	if ( m_doRetransmission == 1 ) {
-
-		m_retxTimer = retxTimer;
-
-		if ( m_retxEvent.IsRunning() ) {
-
-			//m_retxEvent.Cancel (); // cancel any scheduled cleanup events
-			Simulator::Remove( m_retxEvent ); // slower, but better for memory
-		}
-
-		// Schedule even with new timeout
-		m_retxEvent = Simulator::Schedule( m_retxTimer, &BaseStation::CheckRetxTimeout, this );
-	}
+	m_retx.SetGranularity( retxTimer );
 }
 
 
 Time
 BaseStation::GetRetxTimer() const
 {
-	return m_retxTimer;
-}
-
-void
-BaseStation::CheckRetxTimeout()
-{
-	Time now = Simulator::Now();
-
-	Time rto = m_rtt->RetransmitTimeout();
-
-	//NS_LOG_DEBUG ( "Current RTO: " << rto.ToDouble ( Time::S ) << "s" );
-
-	while ( !m_seqTimeouts.empty() ) {
-
-		SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-			m_seqTimeouts.get<i_timestamp>().begin();
-
-		// timeout expired?
-		if ( entry->time + rto <= now ) {
-			uint32_t seqNo = entry->seq;
-			m_seqTimeouts.get<i_timestamp>().erase( entry );
-			OnTimeout( seqNo );
-		} else {
-			break; // nothing else to do. All later packets need not be retransmitted
-		}
-	}
-
-	m_retxEvent = Simulator::Schedule( m_retxTimer, &BaseStation::CheckRetxTimeout, this );
+	return m_retx.GetGranularity();
 }
 
 void
@@ -273,7 +240,7 @@ BaseStation::SendPacket()
 void
 BaseStation::SendToInServers()
 {
-  for(int i; i<inServers.size();i++){
+  for(size_t i = 0; i<inServers.size();i++){
         // Set default size for payload interets
         if ( !m_active ) {
                 return;
@@ -296,7 +263,7 @@ BaseStation::SendToInServers()
         interest->setNonce( m_rand->GetValue( 0, std::numeric_limits<uint32_t>::max() ) );
         interest->setSubscription( 0 );
         shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName.getSubName(0,1));
-        nameWithSequence->append("service");
+        nameWithSequence->append(PECNames::SERVICE);
         std::string temp = inServers[i].toUri();
 	nameWithSequence->append("server" + temp.substr(1));
         nameWithSequence->append(m_interestName.getSubName(2,1));
@@ -336,21 +303,28 @@ BaseStation::OnData( shared_ptr<const Data> data )
 	App::OnData( data ); // tracing inside
 
         NS_LOG_FUNCTION( this << data );	
-	std::vector<uint8_t> payloadVector( &data->getContent().value()[0], &data->getContent().value()[data->getContent().value_size()] );
-        std::string payload( payloadVector.begin(), payloadVector.end() );
          
-       if(data->getName().getSubName(1,1).toUri()== "/baseQuery"){
+       if(isComponent(data->getName(), 1, PECNames::BASE_QUERY)){
           return;
         }
-        if (newServers.empty()){
-           Simulator::Schedule( Seconds( double( 0.005 ) ), &BaseStation::SendGathered, this );
-         }
          m_overhead( GetNode()->GetId());
 
         //std::cout<<"Datata "<<data->getName()<<" "<<payload<<"hmm"<<std::endl;
 
-	std::vector<std::string> server = SplitString(payload, ',');
-	newServers[server[0]] = std::stoi(server[1]);
+	const Block& content = data->getContent();
+	std::vector<ServerState> states;
+	try {
+		states = ServerState::decodeList(content.value(), content.value_size());
+	}
+	catch (const ::ndn::tlv::Error& e) {
+		NS_LOG_DEBUG( "Malformed server state in " << data->getName() << ": " << e.what() );
+		return;
+	}
+	if (states.empty()) {
+		return;
+	}
+	newServers[states[0].getServerId()] = states[0].wireEncode();
+	ServerReported();
 	
 	// This could be a problem......
 	//uint32_t seq = data->getName().at( -1 ).toSequenceNumber();
@@ -373,24 +347,14 @@ BaseStation::OnData( shared_ptr<const Data> data )
 
 		// This could be a problem......
 		uint32_t seq = data->getName().at( -1 ).toSequenceNumber();
-		SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find( seq );
+		RetxTracker::Delays delays;
 
-		if ( entry != m_seqLastDelay.end() ) {
-			m_lastRetransmittedInterestDataDelay( this, seq, Simulator::Now() - entry->time, hopCount );
+		if ( m_retx.Acked( seq, delays ) ) {
+			m_lastRetransmittedInterestDataDelay( this, seq, delays.lastDelay, hopCount );
+			m_firstInterestDataDelay( this, seq, delays.fullDelay, delays.retxCount, hopCount );
 		}
 
-		entry = m_seqFullDelay.find( seq );
-
-		if ( entry != m_seqFullDelay.end() ) {
-			m_firstInterestDataDelay( this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount );
-		}
-
-		m_seqRetxCounts.erase( seq );
-		m_seqFullDelay.erase( seq );
-		m_seqLastDelay.erase( seq );
-		m_seqTimeouts.erase( seq );
 		m_retxSeqs.erase( seq );
-		m_rtt->AckSeq( SequenceNumber32( seq ) );
 
 	//data = nullptr;
 	//data.reset();
@@ -401,17 +365,9 @@ void
 BaseStation::WillSendOutInterest(uint32_t sequenceNumber)
 {
   NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
-
-  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-
-  m_seqLastDelay.erase(sequenceNumber);
-  m_seqLastDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+                                << m_retx.GetSize() << " items");
 
-  m_seqRetxCounts[sequenceNumber]++;
-
-  m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
+  m_retx.Sent(sequenceNumber);
 }
 
 
@@ -428,26 +384,49 @@ BaseStation::OnTimeout( uint32_t sequenceNumber )
 	ScheduleNextPacket();
 }
 
+void
+BaseStation::ServerReported()
+{
+   // the aggregation round completes with the report of the last expected server
+   if(newServers.size() < inServers.size())
+      return;
+
+   servers.clear();
+   for(auto iter = newServers.begin(); iter != newServers.end(); ++iter){
+      servers[iter->first]=iter->second;
+   }
+   FlushPending();
+}
+
 void
 BaseStation::SendGathered()
 {
-   //std::cout<<"Sending out data "<<Simulator::Now().GetSeconds()<<std::endl;
-   //std::cout<<newServers.size()<<" "<<inServers.size()<<std::endl;
+   // deadline of the aggregation round: if reports are still missing, the partial reports are
+   // not used and pending queries are answered with the servers of the last complete round
    if(newServers.size()>=inServers.size()){
       servers.clear();
       for(auto iter = newServers.begin(); iter != newServers.end(); ++iter){
           servers[iter->first]=iter->second;
       }
-      Simulator::Schedule( Seconds( double( 0.005 ) ), &BaseStation::SendGathered, this );
    }
-   else Simulator::Schedule( Seconds( double( 0.001 ) ), &BaseStation::SendGathered, this );
+   FlushPending();
+}
+
+void
+BaseStation::FlushPending()
+{
+   Simulator::Cancel(m_gatherEvent);
+   if (pending.empty())
+      return;
+
    while (!pending.empty()){
       Name temp = pending.back();
       pending.pop_back();
       SendData(temp, true);
-      isFresh = true;
-      Simulator::Schedule( m_qFresh, &BaseStation::updateFreshness, this );
    }
+   isFresh = true;
+   Simulator::Cancel(m_freshEvent);
+   m_freshEvent = Simulator::Schedule( m_qFresh, &BaseStation::updateFreshness, this );
 }
 
 
@@ -470,50 +449,58 @@ BaseStation::OnInterest(shared_ptr<const Interest> interest)
     m_subscription = interest->getSubscription();
     m_receivedpayload = interest->getPayloadLength();
 
-    std::vector<uint8_t> payloadVector( &interest->getPayload()[0], &interest->getPayload()[interest->getPayloadLength()] );
-    std::string payload( payloadVector.begin(), payloadVector.end() );
-    //std::cout<<"At the base " << payload <<" "<<server<<std::endl;
-    //std::cout<<interest->getName()<<Simulator::Now().GetSeconds()<<std::endl;
-    bool sendPayload = false;
-    if(interest->getName().getSubName(1,1).toUri() == "/service"){
-	if(!m_proactive and !isFresh) {
-            if(pending.empty()){
-	     	Simulator::Schedule( Seconds( double( 0.035 ) ), &BaseStation::SendGathered, this );
-                SendPacket();
-		SendToInServers();
-            }
-            pending.push_back(interest->getName());
-            return;
+    m_interestDispatcher.dispatch(interest->getName(), interest);
+}
+
+void
+BaseStation::OnServiceInterest(shared_ptr<const Interest> interest)
+{
+    if(!m_proactive and !isFresh) {
+        bool startRound = pending.empty();
+        pending.push_back(interest->getName());
+        if(startRound){
+            m_gatherEvent = Simulator::Schedule( Seconds( double( 0.035 ) ), &BaseStation::SendGathered, this );
+            SendPacket();
+            SendToInServers();
         }
-        else 
-		sendPayload = true;
+        return;
     }
-    //else if(interest->getName().getSubName(1,1).toUri() == "/consumerQuery") 
-    
-    //else if(payload == "remove") 
-	    //servers.erase(server);
-    else if (interest->getName().getSubName(1,1).toUri() == "/update"){
+
+    //Normal interest, without a subscription
+    if (m_subscription == 0) {
+        SendData(interest->getName(), true);
+    }
+}
+
+void
+BaseStation::OnUpdateInterest(shared_ptr<const Interest> interest)
+{
+    const Name& name = interest->getName();
     m_overhead( GetNode()->GetId());
 
-     if ( newServers.empty())
-           Simulator::Schedule( Seconds( double( 0.005 ) ), &BaseStation::SendGathered, this );    
- 
-    for(auto iter = servers.begin(); iter != servers.end(); ++iter){
-      //  std::cout << (*iter) << ", " ;
+    std::string server = "/" + name.get(2).toUri() + name.get(3).toUri();
+    Block state;
+    if (interest->getPayloadLength() > 0) {
+      try {
+        state = Block(&interest->getPayload()[0], interest->getPayloadLength());
+        ServerState checked(state);
+      }
+      catch (const ::ndn::tlv::Error& e) {
+        NS_LOG_DEBUG( "Malformed server state in " << name << ": " << e.what() );
+        return;
+      }
     }
-    std::string server = interest->getName().getSubName(2,1).toUri();
-    std::string temp = interest->getName().getSubName(3,1).toUri();
-    server+= temp.substr(1);
-    //std::cout<<server<<" "<<interest->getName()<<std::endl;
-    newServers[server] = payload;
+    newServers[server] = state;
+    if(name.get(2) == PECNames::SERVER){
+      Name inServer = name.getSubName(3,1);
+      if(std::find(inServers.begin(), inServers.end(), inServer) == inServers.end())
+        inServers.push_back(inServer);
     }
-    else return;
+    ServerReported();
+
     //Normal interest, without a subscription
     if (m_subscription == 0) {
-        SendData(interest->getName(), sendPayload);
-    }
-    if(interest->getName().getSubName(2,1).toUri() == "/server"){
-      inServers.push_back(interest->getName().getSubName(3,1)); 
+        SendData(name, false);
     }
 }
 
@@ -555,39 +542,23 @@ BaseStation::SendData(const Name &dataName, bool payload)
 
     //std::cout << " ack payload= " << m_virtualPayloadSize << std::endl;
 
-    auto data = make_shared<Data>();
-    data->setName(dataName);
-    data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
-
-    std::string serverList = "";
-    for(auto iter  : servers){
-       if(iter.second != "")
-       serverList += iter.second + " ";
-    }
+    m_dataTemplate.SetFields(m_freshness, m_signature, m_keyLocator);
+    shared_ptr<Data> data;
 
-    //std::cout << "printing server list\n"<<serverList<<" "<< Simulator::Now().GetSeconds()<<" "<< GetNode()->GetId()<<std::endl;
     if(payload){
-       std::vector<uint8_t> myVector( serverList.begin(), serverList.end() );
-       uint8_t *p = &myVector[0];
-       data->setContent( p, myVector.size()); // Add payload to interest
+       std::vector<Block> serverList;
+       serverList.reserve(servers.size());
+       for(const auto& iter : servers){
+          if(iter.second.isValid())
+             serverList.push_back(iter.second);
+       }
+       data = m_dataTemplate.Create(dataName, serverList); // Add server states to data
     }
 
     else {
-       data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
+       data = m_dataTemplate.Create(dataName, m_virtualPayloadSize);
     }
 
-    Signature signature;
-    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
-
-    if (m_keyLocator.size() > 0) {
-        signatureInfo.setKeyLocator(m_keyLocator);
-    }
-
-    signature.setInfo(signatureInfo);
-    signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
-
-    data->setSignature(signature);
-
     if (m_subscription == 0 && m_receivedpayload > 0) {
         NS_LOG_INFO("node(" << GetNode()->GetId() << ") sending ACK: " << data->getName() << " TIME: " << Simulator::Now());
     } else {
@@ -596,8 +567,6 @@ BaseStation::SendData(const Name &dataName, bool payload)
 
     //std::cout << "use count " << data.use_count() << " data content/payload size = " << data->getContent().value_size() << std::endl;
 
-    // to create real wire encoding
-    data->wireEncode();
     //std::cout<<data->getName()<<std::endl;
     m_transmittedDatas(data, this, m_face);
     m_appLink->onReceiveData(*data);
@@ -609,30 +578,5 @@ BaseStation::SendData(const Name &dataName, bool payload)
     //m_appLink->DanFree();
 }
 
-std::vector<std::string>
-BaseStation::SplitString( std::string strLine, char delimiter ) {
-
-        std::string str = strLine;
-        std::vector<std::string> result;
-        int i =0;
-        std::string buildStr = "";
-
-        for ( i = 0; i<str.size(); i++) {
-
-           if ( str[i]== delimiter ) {
-              result.push_back( buildStr );
-	      buildStr = "";
-	   } 
-	   else {
-              buildStr += str[i];    
-	   }
-        }
-        
-	if(buildStr!="")
-           result.push_back( buildStr );
-
-        return result;
-}
-
 } // namespace ndn
 } // namespace ns3
@@ -28,15 +28,15 @@
 #include "ns3/ptr.h"
 
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
+#include "ns3/ndnSIM/utils/ndn-retx-tracker.hpp"
+#include "ns3/ndnSIM/utils/ndn-data-template.hpp"
+#include "ndn-PEC-name-dispatcher.hpp"
 #include "ns3/random-variable-stream.h"
 
 #include <set>
 #include <map>
+#include <functional>
 
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
 
 
 namespace ns3 {
@@ -71,12 +71,41 @@ public:
   void
   SendData(const Name &dataName, bool payload);
 
+  /**
+   * @brief Answer a service query with the gathered server states, or start a discovery round
+   */
+  void
+  OnServiceInterest(shared_ptr<const Interest> interest);
+
+  /**
+   * @brief Record the state reported by a server
+   */
+  void
+  OnUpdateInterest(shared_ptr<const Interest> interest);
+
   void
   SendTimeout();
 
+  /**
+   * @brief Deadline of the current discovery round: answer pending queries with the
+   *        server states gathered so far
+   */
   void
   SendGathered();
 
+  /**
+   * @brief Called whenever a server report arrives; completes the discovery round once
+   *        reports from all known infrastructure servers have been received
+   */
+  void
+  ServerReported();
+
+  /**
+   * @brief Answer all pending service queries in one batch
+   */
+  void
+  FlushPending();
+
   void
   updateFreshness(){
      isFresh = false;
@@ -100,9 +129,6 @@ public:
   void
   SendToInServers();
 
-  void
-  CheckRetxTimeout();
-
   /**
    * \brief Modifies the frequency of checking the retransmission timeouts
    * \param retxTimer Timeout defining how frequent retransmission timeouts should be checked
@@ -118,9 +144,6 @@ public:
   GetRetxTimer() const;
 
 
-  std::vector<std::string>
-  SplitString( std::string strLine, char delimiter );
-
 public:
   typedef void (*OverheadTraceCallback)( uint32_t );
   typedef void (*ReceivedInterestTraceCallback)( uint32_t, shared_ptr<const Interest> );
@@ -142,8 +165,6 @@ private:
   uint32_t m_seq;      ///< @brief currently requested sequence number
   uint32_t m_seqMax;
   EventId m_sendEvent; ///< @brief EventId of pending "send packet" event
-  Time m_retxTimer;    ///< @brief Currently estimated retransmission timer
-  EventId m_retxEvent; ///< @brief Event to check whether or not retransmission should be performed
 
   Time m_txInterval;
   Name m_interestName;  
@@ -154,23 +175,26 @@ private:
   Time m_qFresh;
   Time m_frequency;
   EventId m_txEvent;
+  EventId m_gatherEvent; ///< @brief deadline of the current discovery round
+  EventId m_freshEvent;  ///< @brief expiration of the gathered query results
   bool m_firstTime;
   uint32_t m_subscription;
   Name m_prefixWithoutSequence;
   size_t m_receivedpayload;
   size_t m_subDataSize; //Size of subscription data, in Kbytes
-  std::unordered_map<std::string, std::string> servers;
-  std::unordered_map<std::string, std::string> newServers; 
+  std::unordered_map<std::string, Block> servers;    ///< @brief encoded ServerState records, by server id
+  std::unordered_map<std::string, Block> newServers; 
   std::vector<Name> inServers; 
   uint32_t m_proactive;
   Name m_keyLocator;
   uint32_t m_signature;
+  DataTemplate m_dataTemplate;
   uint32_t m_hoplimit;
   uint32_t m_offset; //random offset
-  uint32_t m_doRetransmission; //retransmit lost interest packets if set to 1
   Time m_interestLifeTime;
   Ptr<RttEstimator> m_rtt; ///< @brief RTT estimator
   std::vector<Name> pending;
+  NameDispatcher<std::function<void(shared_ptr<const Interest>)>> m_interestDispatcher;
 
   bool isFresh = false;
 
@@ -189,55 +213,9 @@ protected:
   };
 
   RetxSeqsContainer m_retxSeqs; ///< \brief ordered set of sequence numbers to be retransmitted
-
-  /**
-   * \struct This struct contains a pair of packet sequence number and its timeout
-   */
-  struct SeqTimeout {
-    SeqTimeout(uint32_t _seq, Time _time)
-      : seq(_seq)
-      , time(_time)
-    {
-    }
-
-    uint32_t seq;
-    Time time;
-  };
   /// @endcond
 
-  /// @cond include_hidden
-  class i_seq {
-  };
-  class i_timestamp {
-  };
-  /// @endcond
-
-  /// @cond include_hidden
-  /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
-   */
-  struct SeqTimeoutsContainer
-    : public boost::multi_index::
-        multi_index_container<SeqTimeout,
-                              boost::multi_index::
-                                indexed_by<boost::multi_index::
-                                             ordered_unique<boost::multi_index::tag<i_seq>,
-                                                            boost::multi_index::
-                                                              member<SeqTimeout, uint32_t,
-                                                                     &SeqTimeout::seq>>,
-                                           boost::multi_index::
-                                             ordered_non_unique<boost::multi_index::
-                                                                  tag<i_timestamp>,
-                                                                boost::multi_index::
-                                                                  member<SeqTimeout, Time,
-                                                                         &SeqTimeout::time>>>> {
-  };
-
-  SeqTimeoutsContainer m_seqTimeouts; ///< \brief multi-index for the set of SeqTimeout structs
-
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+  RetxTracker m_retx; ///< @brief tracker of outstanding sequence numbers
 
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
     m_lastRetransmittedInterestDataDelay;
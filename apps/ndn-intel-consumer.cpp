@@ -19,6 +19,7 @@
  */
 
 #include "ndn-intel-consumer.hpp"
+#include "ndn-PEC-server-state.hpp"
 #include "ns3/ptr.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -41,6 +42,7 @@
 #include <iomanip>
 #include <iostream>
 #include <stdlib.h>
+#include <algorithm>
 
 #include <fstream>
 
@@ -82,9 +84,6 @@ intelConsumer::GetTypeId( void )
                     MakeTimeAccessor( &intelConsumer::GetRetxTimer, &intelConsumer::SetRetxTimer ),
                     MakeTimeChecker() )
 
-      .AddAttribute( "RetransmitPackets", "Retransmit lost packets if set to 1, otherwise do not perform retransmission", IntegerValue( 1 ),
-                    MakeIntegerAccessor( &intelConsumer::m_doRetransmission ), MakeIntegerChecker<int32_t>() )
-
       .AddAttribute( "Offset", "Random offset to randomize sending of interests", IntegerValue( 0 ),
                     MakeIntegerAccessor( &intelConsumer::m_offset ), MakeIntegerChecker<int32_t>() )
 
@@ -110,6 +109,11 @@ intelConsumer::GetTypeId( void )
                       MakeTraceSourceAccessor( &intelConsumer::m_firstInterestDataDelay ),
                       "ns3::ndn::intelConsumer::FirstInterestDataDelayCallback" )
 
+      .AddTraceSource( "ServiceDelay",
+                      "Delay between service Interest and received result of the computation",
+                      MakeTraceSourceAccessor( &intelConsumer::m_serviceDelay ),
+                      "ns3::ndn::intelConsumer::FirstInterestDataDelayCallback" )
+
       .AddTraceSource( "ReceivedData", "ReceivedData",
                       MakeTraceSourceAccessor( &intelConsumer::m_receivedData ),
                       "ns3::ndn::intelConsumer::ReceivedDataTraceCallback" )
@@ -131,10 +135,18 @@ intelConsumer::intelConsumer()
     , m_seq( 0 )
     , m_seqMax( std::numeric_limits<uint32_t>::max() ) // set to max value on uint32
     , m_firstTime ( true )
-    , m_doRetransmission( 1 )
 {
 	NS_LOG_FUNCTION_NOARGS();
 	m_rtt = CreateObject<RttMeanDeviation>();
+	m_retx.SetRttEstimator( m_rtt );
+
+	// obtain names also start with the compute prefix, so they are matched first
+	m_dataDispatcher.add( NamePattern().at( 1, PECNames::SERVICE ),
+	                      [this] ( shared_ptr<const Data> d ) { OnServiceData( d ); } );
+	m_dataDispatcher.add( NamePattern().at( -2, PECNames::OBTAIN ),
+	                      [this] ( shared_ptr<const Data> d ) { OnObtainData( d ); } );
+	m_dataDispatcher.add( NamePattern().at( 1, PECNames::COMPUTE ),
+	                      [this] ( shared_ptr<const Data> d ) { OnComputeData( d ); } );
 }
 
 
@@ -163,55 +175,14 @@ intelConsumer::ScheduleNextPacket()
 void
 intelConsumer::SetRetxTimer( Time retxTimer )
 {
-
-	// Do not restranmit lost packets, if set to 0
-	if ( m_doRetransmission == 1 ) {
-
-		m_retxTimer = retxTimer;
-
-		if ( m_retxEvent.IsRunning() ) {
-
-			//m_retxEvent.Cancel (); // cancel any scheduled cleanup events
-			Simulator::Remove( m_retxEvent ); // slower, but better for memory
-		}
-
-		// Schedule even with new timeout
-		m_retxEvent = Simulator::Schedule( m_retxTimer, &intelConsumer::CheckRetxTimeout, this );
-	}
+	m_retx.SetGranularity( retxTimer );
 }
 
 
 Time
 intelConsumer::GetRetxTimer() const
 {
-	return m_retxTimer;
-}
-
-void
-intelConsumer::CheckRetxTimeout()
-{
-	Time now = Simulator::Now();
-
-	Time rto = m_rtt->RetransmitTimeout();
-
-	//NS_LOG_DEBUG ( "Current RTO: " << rto.ToDouble ( Time::S ) << "s" );
-
-	while ( !m_seqTimeouts.empty() ) {
-
-		SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-			m_seqTimeouts.get<i_timestamp>().begin();
-
-		// timeout expired?
-		if ( entry->time + rto <= now ) {
-			uint32_t seqNo = entry->seq;
-			m_seqTimeouts.get<i_timestamp>().erase( entry );
-			OnTimeout( seqNo );
-		} else {
-			break; // nothing else to do. All later packets need not be retransmitted
-		}
-	}
-
-	m_retxEvent = Simulator::Schedule( m_retxTimer, &intelConsumer::CheckRetxTimeout, this );
+	return m_retx.GetGranularity();
 }
 
 
@@ -222,8 +193,10 @@ intelConsumer::StartApplication()
 {
 	NS_LOG_FUNCTION_NOARGS();
 	App::StartApplication();
+	// non-service interests are sent with a lifetime of 5s, see SendPacket
+	m_retx.SetLifetime( std::max( m_interestLifeTime, Seconds( 5 ) ) );
         m_interestName = m_queryName;
-	m_interestName.append("service");
+	m_interestName.append(PECNames::SERVICE);
 	m_interestName.append(m_nodeId);
 	ScheduleNextPacket();
 	m_subscription = 1;
@@ -289,7 +262,7 @@ intelConsumer::SendPacket()
 
 	NS_LOG_INFO( "node( " << GetNode()->GetId() << " ) > sending Interest: " << interest->getName() /*m_interestName*/ << " with Payload = " << interest->getPayloadLength() << "bytes" );
 
-        if(interest->getName().getSubName(1,1).toUri()=="/service")
+        if(isComponent(interest->getName(), 1, PECNames::SERVICE))
 		interest->setHopLimit(1);
 	else {
 	   time::milliseconds lifeTime(Seconds( 5 ).GetMilliSeconds());
@@ -317,6 +290,7 @@ intelConsumer::SendPacket()
 	// Callback for sent payload interests
 	if(m_subscription==1){
    	   m_sentInterest( GetNode()->GetId(), interest );
+	   m_serviceSent[seq] = Simulator::Now();
 	}
 }
 
@@ -341,101 +315,8 @@ intelConsumer::OnData( shared_ptr<const Data> data )
 	// This could be a problem......
 	//uint32_t seq = data->getName().at( -1 ).toSequenceNumber();
         
-	if(!chosen && data->getName().getSubName(1,1)=="service"){
-          std::vector<uint8_t> payloadVector( &data->getContent().value()[0], &data->getContent().value()[data->getContent().value_size()] );
-          std::string payload( payloadVector.begin(), payloadVector.end() );
-
-          std::vector<std::string> servers = SplitString(payload, ' ');
-          if(servers.size() > 1)
-	  {
-	     for(int i=0; i < servers.size(); i++)
-	     {
-	        std::vector<std::string> server = SplitString(servers[i], ',');	 
-		bool hasService = false;
-	        for(int k= 2; k < server.size(); k++ ){
-		   if(server[k] == m_service)
-		      hasService = true;
-		}	
-                //std::cout<<servers[i]<<std::endl;
-                if(hasService && PECservers[server[0]] == 0){
-	           PECservers[server[0]] = std::stoi(server[1]);
-                   conMap[server[0]] = false;
-                }
-	     }
-	  }
-	  else 
-	  {
-	     //std::cout<<data->getName()<<std::endl;	  
-	     std::vector<std::string> server = SplitString(servers[0], ',');
-	     bool hasService = false;
-             for(int k= 2; k < server.size(); k++ ){
-                if(server[k] == m_service)
-                   hasService = true;
-             }
-	     if(hasService){
-                PECservers[server[0]] = std::stoi(server[1]);	   
-                conMap[server[0]] = true;
-	     }
-  	  }
-
-          //for (auto i : PECservers) 
-	  //{
-             //if(lowestUtil>i.second){
-             //   lowestUtil=i.second;
-	     //   bestServer = i.first;
-	     //} 
-	  //}
-
-          //Name payloadName = m_interestName.toUri()+payload;
- 
-	  NS_LOG_INFO( "node( " << GetNode()->GetId() << " ) < Received DATA for " << data->getName() << " Content: " << payload << " Current Best:"<< bestServer << " " << lowestUtil << " TIME: " << Simulator::Now() );
-
-	  if (firstResponse){
-	     firstResponse = false;
-             Simulator::Schedule( Seconds(0.05), &intelConsumer::ChooseServer, this );           
-	  }
+	m_dataDispatcher.dispatch( data->getName(), data );
 
-	}
-        /*else if(data->getName().getSubName(3,1)=="request"){
-	   std::vector<uint8_t> payloadVector( &data->getContent().value()[0], 
-			   &data->getContent().value()[data->getContent().value_size()] );
-           std::string payload( payloadVector.begin(), payloadVector.end() );
-
-	   m_dataReq = std::stoi(payload);
-           m_interestName = m_queryName;
-	   m_interestName.append("compute");
-	   m_interestName.append(bestServer);
-	   m_interestName.append("data");
-	   m_interestName.append(std::to_string(GetNode()->GetId()));
-           m_txInterval = m_dataInterval;
-	   ScheduleNextPacket();
-	}*/
-	else if(data->getName().getSubName(1,1)=="compute" && data->getName().getSubName(-2,1)!="obtain")
-	{
-	//std::cout<<"new request\n";
-           firstResponse = true;
-           m_subscription = 1;
-           chosen = false;
-
-	   //clear query related attributes
-           PECservers.clear();
-	   bestServer = "";
-	   lowestUtil = 1000;
-           std::vector<uint8_t> payloadVector( &data->getContent().value()[0], &data->getContent().value()[data->getContent().value_size()] );
-           std::string payload(payloadVector.begin(), payloadVector.end());
-
-	   Simulator::Schedule( Seconds(std::stod(payload)), &intelConsumer::SendObtainPacket, this, data->getName() );
-           m_interestName = m_queryName;
-           m_interestName.append("service");
-	   m_interestName.append(m_nodeId);
-	   m_txInterval = m_longInterval;
-           ScheduleNextPacket();
-
-	   //m_receivedData( GetNode()->GetId(), data, m_intSent );
-	}
-        else if(data->getName().getSubName(-2,1)=="obtain"){
-           m_receivedData( GetNode()->GetId(), data, m_intSent );
-        }
 	// Callback for received subscription data
 	//m_receivedData( GetNode()->GetId(), data );
 
@@ -453,24 +334,14 @@ intelConsumer::OnData( shared_ptr<const Data> data )
 
 		// This could be a problem......
 		uint32_t seq = data->getName().at( -1 ).toSequenceNumber();
-		SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find( seq );
+		RetxTracker::Delays delays;
 
-		if ( entry != m_seqLastDelay.end() ) {
-			m_lastRetransmittedInterestDataDelay( this, seq, Simulator::Now() - entry->time, hopCount );
+		if ( m_retx.Acked( seq, delays ) ) {
+			m_lastRetransmittedInterestDataDelay( this, seq, delays.lastDelay, hopCount );
+			m_firstInterestDataDelay( this, seq, delays.fullDelay, delays.retxCount, hopCount );
 		}
 
-		entry = m_seqFullDelay.find( seq );
-
-		if ( entry != m_seqFullDelay.end() ) {
-			m_firstInterestDataDelay( this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount );
-		}
-
-		m_seqRetxCounts.erase( seq );
-		m_seqFullDelay.erase( seq );
-		m_seqLastDelay.erase( seq );
-		m_seqTimeouts.erase( seq );
 		m_retxSeqs.erase( seq );
-		m_rtt->AckSeq( SequenceNumber32( seq ) );
 	}
 
 	//data = nullptr;
@@ -493,6 +364,105 @@ intelConsumer::OnData( shared_ptr<const Data> data )
 
 }
 
+void
+intelConsumer::OnServiceData( shared_ptr<const Data> data )
+{
+	if ( chosen ) {
+		return;
+	}
+
+	const Block& content = data->getContent();
+	std::vector<ServerState> servers;
+	try {
+		servers = ServerState::decodeList(content.value(), content.value_size());
+	}
+	catch (const ::ndn::tlv::Error& e) {
+		NS_LOG_DEBUG( "Malformed server state in " << data->getName() << ": " << e.what() );
+	}
+	uint64_t service = ServerState::parseServices(m_service);
+
+	if(servers.size() > 1)
+	{
+	   for(size_t i=0; i < servers.size(); i++)
+	   {
+	      bool hasService = (servers[i].getServices() & service) != 0;
+	      if(hasService && PECservers[servers[i].getServerId()] == 0){
+	         PECservers[servers[i].getServerId()] = servers[i].getUtilization();
+	         conMap[servers[i].getServerId()] = false;
+	      }
+	   }
+	}
+	else if(servers.size() == 1)
+	{
+	   bool hasService = (servers[0].getServices() & service) != 0;
+	   if(hasService){
+	      PECservers[servers[0].getServerId()] = servers[0].getUtilization();
+	      conMap[servers[0].getServerId()] = true;
+	   }
+	}
+
+	NS_LOG_INFO( "node( " << GetNode()->GetId() << " ) < Received DATA for " << data->getName() << " Servers: " << servers.size() << " Current Best:"<< bestServer << " " << lowestUtil << " TIME: " << Simulator::Now() );
+
+	if (firstResponse){
+	   firstResponse = false;
+	   Simulator::Schedule( Seconds(0.05), &intelConsumer::ChooseServer, this );
+	}
+}
+
+void
+intelConsumer::OnComputeData( shared_ptr<const Data> data )
+{
+	firstResponse = true;
+	m_subscription = 1;
+	chosen = false;
+
+	//clear query related attributes
+	PECservers.clear();
+	bestServer = "";
+	lowestUtil = 1000;
+	std::vector<uint8_t> payloadVector( &data->getContent().value()[0], &data->getContent().value()[data->getContent().value_size()] );
+	std::string payload(payloadVector.begin(), payloadVector.end());
+
+	Simulator::Schedule( Seconds(std::stod(payload)), &intelConsumer::SendObtainPacket, this, data->getName() );
+	m_interestName = m_queryName;
+	m_interestName.append(PECNames::SERVICE);
+	m_interestName.append(m_nodeId);
+	m_txInterval = m_longInterval;
+	ScheduleNextPacket();
+}
+
+void
+intelConsumer::OnObtainData( shared_ptr<const Data> data )
+{
+	m_receivedData( GetNode()->GetId(), data, m_intSent );
+	TraceServiceDelay( data );
+}
+
+void
+intelConsumer::TraceServiceDelay( shared_ptr<const Data> data )
+{
+	uint32_t seq = data->getName().at( -1 ).toSequenceNumber();
+	if ( seq == 0 ) {
+		return;
+	}
+
+	auto sent = m_serviceSent.find( seq - 1 );
+	if ( sent == m_serviceSent.end() ) {
+		return;
+	}
+
+	int hopCount = 0;
+	auto hopCountTag = data->getTag<lp::HopCountTag>();
+	if ( hopCountTag != nullptr ) {
+		hopCount = *hopCountTag;
+	}
+
+	m_serviceDelay( this, seq - 1, Simulator::Now() - sent->second, 1, hopCount );
+
+	// service Interests of earlier requests can no longer be matched
+	m_serviceSent.erase( m_serviceSent.begin(), ++sent );
+}
+
 void
 intelConsumer::ChooseServer()
 {
@@ -512,7 +482,7 @@ intelConsumer::ChooseServer()
    m_subscription = 0;
    chosen = true;
    m_interestName = m_queryName;
-   m_interestName.append("compute");
+   m_interestName.append(PECNames::COMPUTE);
    m_interestName.append(bestServer);
    //m_interestName.append("request");
    m_interestName.append(m_nodeId);
@@ -540,40 +510,10 @@ void
 intelConsumer::WillSendOutInterest( uint32_t sequenceNumber )
 {
 	NS_LOG_DEBUG( "Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-			<< m_seqTimeouts.size() << " items" );
-	//m_seqTimeouts.insert( SeqTimeout( sequenceNumber, Simulator::Now() ) );
-	m_seqFullDelay.insert( SeqTimeout( sequenceNumber, Simulator::Now() ) );
-	m_seqLastDelay.erase( sequenceNumber );
-	m_seqLastDelay.insert( SeqTimeout( sequenceNumber, Simulator::Now() ) );
-	m_seqRetxCounts[sequenceNumber]++;
-	m_rtt->SentSeq( SequenceNumber32( sequenceNumber ), 1 );
+			<< m_retx.GetSize() << " items" );
+	m_retx.Sent( sequenceNumber );
 }
 
-
-std::vector<std::string>
-intelConsumer::SplitString( std::string strLine, char delimiter ) {
-
-        std::string str = strLine;
-        std::vector<std::string> result;
-        int i =0;
-        std::string buildStr = "";
-
-        for ( i = 0; i<str.size(); i++) {
-
-           if ( str[i]== delimiter ) {
-              result.push_back( buildStr );
-	      buildStr = "";
-	   } 
-	   else {
-              buildStr += str[i];    
-	   }
-        }
-        
-	if(buildStr!="")
-           result.push_back( buildStr );
-
-        return result;
-}
 void
 intelConsumer::SendObtainPacket(Name interestName)
 {
@@ -609,7 +549,7 @@ intelConsumer::SendObtainPacket(Name interestName)
         interest->setSubscription( m_subscription );
         Name se = interestName.getSubName(-1, 1);
         interestName = interestName.getSubName(0,  interestName.size()-1);
-        interestName.append("obtain");
+        interestName.append(PECNames::OBTAIN);
         interestName.append( se );
 
 
@@ -623,7 +563,7 @@ intelConsumer::SendObtainPacket(Name interestName)
 
         NS_LOG_INFO( "node( " << GetNode()->GetId() << " ) > sending Interest: " << interest->getName() /*m_interestName*/ << " with Payload = " << interest->getPayloadLength() << "bytes" );
 
-        if(interest->getName().getSubName(1,1).toUri()=="/service")
+        if(isComponent(interest->getName(), 1, PECNames::SERVICE))
                 interest->setHopLimit(1);
         else {
            time::milliseconds lifeTime(Seconds( 5 ).GetMilliSeconds());
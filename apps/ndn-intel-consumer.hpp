@@ -31,14 +31,12 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
+#include "ns3/ndnSIM/utils/ndn-retx-tracker.hpp"
+#include "ndn-PEC-name-dispatcher.hpp"
 
 #include <set>
 #include <map>
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include <functional>
 
 namespace ns3 {
 namespace ndn {
@@ -120,12 +118,6 @@ protected:
   void
   ScheduleNextPacket();
 
-  /**
-   * \brief Checks if the packet need to be retransmitted becuase of retransmission timer expiration
-   */
-  void
-  CheckRetxTimeout();
-
   /**
    * \brief Modifies the frequency of checking the retransmission timeouts
    * \param retxTimer Timeout defining how frequent retransmission timeouts should be checked
@@ -141,24 +133,44 @@ protected:
   GetRetxTimer() const;
 
 
-  std::vector<std::string>
-  SplitString( std::string strLine, char delimiter );
-
-
   void
   ChooseServer();
 
   void
   SendObtainPacket(Name interestName);
 
+  /**
+   * \brief Fires ServiceDelay for the result Data of an obtain Interest
+   *
+   * The delay of a request is measured from the last service Interest before the compute
+   * Interest, whose sequence number precedes that of the compute Interest and its result Data.
+   */
+  void
+  TraceServiceDelay( shared_ptr<const Data> data );
+
+  /**
+   * \brief Collect server states of a discovery round and choose a server shortly after the
+   *        first response
+   */
+  void
+  OnServiceData( shared_ptr<const Data> data );
+
+  /**
+   * \brief Schedule the obtain Interest after the compute time announced by the server and
+   *        start the next discovery round
+   */
+  void
+  OnComputeData( shared_ptr<const Data> data );
+
+  void
+  OnObtainData( shared_ptr<const Data> data );
+
 protected:
 
   Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
   uint32_t m_seq;      ///< @brief currently requested sequence number
   uint32_t m_seqMax;   ///< @brief maximum number of sequence number
   EventId m_sendEvent; ///< @brief EventId of pending "send packet" event
-  Time m_retxTimer;    ///< @brief Currently estimated retransmission timer
-  EventId m_retxEvent; ///< @brief Event to check whether or not retransmission should be performed
 
   bool chosen = false;
 
@@ -171,7 +183,6 @@ protected:
   bool m_firstTime;
   uint32_t m_subscription; //subscription value set by the application
   uint32_t m_virtualPayloadSize; //payload size for interest packet
-  uint32_t m_doRetransmission; //retransmit lost interest packets if set to 1
   uint32_t m_offset; //random offset
   std::string bestServer;
   std::string m_service;
@@ -193,63 +204,20 @@ protected:
   };
 
   RetxSeqsContainer m_retxSeqs; ///< \brief ordered set of sequence numbers to be retransmitted
-
-  /**
-   * \struct This struct contains a pair of packet sequence number and its timeout
-   */
-  struct SeqTimeout {
-    SeqTimeout(uint32_t _seq, Time _time)
-      : seq(_seq)
-      , time(_time)
-    {
-    }
-
-    uint32_t seq;
-    Time time;
-  };
   /// @endcond
 
-  /// @cond include_hidden
-  class i_seq {
-  };
-  class i_timestamp {
-  };
-  /// @endcond
+  RetxTracker m_retx; ///< @brief tracker of outstanding sequence numbers
 
-  /// @cond include_hidden
-   /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
-   */
-  struct SeqTimeoutsContainer
-    : public boost::multi_index::
-        multi_index_container<SeqTimeout,
-                              boost::multi_index::
-                                indexed_by<boost::multi_index::
-                                             ordered_unique<boost::multi_index::tag<i_seq>,
-                                                            boost::multi_index::
-                                                              member<SeqTimeout, uint32_t,
-                                                                     &SeqTimeout::seq>>,
-                                           boost::multi_index::
-                                             ordered_non_unique<boost::multi_index::
-                                                                  tag<i_timestamp>,
-                                                                boost::multi_index::
-                                                                  member<SeqTimeout, Time,
-                                                                         &SeqTimeout::time>>>> {
-  };
-  /// @endcond
-
-  SeqTimeoutsContainer m_seqTimeouts; ///< \brief multi-index for the set of SeqTimeout structs
-
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+  std::map<uint32_t, Time> m_serviceSent; ///< @brief send time of service Interests by seq
+  NameDispatcher<std::function<void(shared_ptr<const Data>)>> m_dataDispatcher;
 
 
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
     m_lastRetransmittedInterestDataDelay;
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */,
                  uint32_t /*retx count*/, int32_t /*hop count*/> m_firstInterestDataDelay;
+  TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */,
+                 uint32_t /*retx count*/, int32_t /*hop count*/> m_serviceDelay;
 
   TracedCallback < uint32_t, shared_ptr<const Interest> > m_sentInterest;
   TracedCallback < uint32_t, shared_ptr<const Data>, int > m_receivedData;
@@ -24,6 +24,7 @@
 
 #include "ndn-app.hpp"
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-data-template.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
@@ -67,6 +68,8 @@ private:
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  DataTemplate m_dataTemplate;
 };
 
 } // namespace ndn
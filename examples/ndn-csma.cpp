@@ -72,6 +72,8 @@ main(int argc, char* argv[])
   // Install NDN stack on all nodes
   ndn::StackHelper ndnHelper;
   ndnHelper.SetDefaultRoutes(true);
+  // Interests are broadcast on the bus, Data is sent only to the node that requested it
+  ndnHelper.setUnicastReplies();
   ndnHelper.InstallAll();
 
   // Installing applications
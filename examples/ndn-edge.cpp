@@ -25,8 +25,8 @@
 #include "ns3/ndnSIM-module.h"
 
 
+#include <chrono>
 #include <fstream>
-#include <iomanip>
 #include <iostream>
 #include <stdlib.h>
 
@@ -76,10 +76,10 @@ void ExecuteCallback( uint32_t nodeid, std::string server, double time);
 std::vector<std::string> SplitString(std::string strLine);
 
 
-std::ofstream tracefile;
-std::ofstream tracefileInput;
-std::ofstream tracefile1;
-std::ofstream tracefileE;
+Ptr<ndn::TraceSink> tracefile;
+Ptr<ndn::TraceSink> tracefileInput;
+Ptr<ndn::TraceSink> tracefile1;
+Ptr<ndn::TraceSink> tracefileE;
 
 int
 main(int argc, char* argv[])
@@ -94,6 +94,8 @@ main(int argc, char* argv[])
   std::string PECChange = "1.5";
   double userRequest = 1;
   double discovery = 1;
+  std::string outputDir = "";
+  double latencyHistogram = 0;
   // Read optional command-line parameters (e.g., enable visualizer with ./waf --run=<> --visualize
   CommandLine cmd;
   cmd.AddValue("Run", "Run", run);
@@ -101,9 +103,16 @@ main(int argc, char* argv[])
   cmd.AddValue("PECChange", "PECChange", PECChange);
   cmd.AddValue("UserRequest", "UserRequest", userRequest);
   cmd.AddValue("Discovery", "Discovery", discovery);
+  cmd.AddValue("OutputDir", "Directory for trace files (default: current directory)", outputDir);
+  cmd.AddValue("LatencyHistogram", "Period (s) of request latency histograms written to latency-*.txt (0: disabled)",
+               latencyHistogram);
   cmd.Parse(argc, argv);
 
+  // rand() only shapes the scenario; applications draw from their own ns-3 random streams
   srand( run );
+  RngSeedManager::SetRun( run );
+  if ( !outputDir.empty() && outputDir.back() != '/' )
+    outputDir += '/';
   PointToPointHelper p2p;
 
   ndn::AppHelper consumerHelper("ns3::ndn::IntelConsumer");
@@ -186,7 +195,6 @@ main(int argc, char* argv[])
 			     	serverHelper.SetAttribute("UpdatePrefix",StringValue("/prefix/update/server/"+std::to_string(servercount)));
 	 	  	     	serverHelper.SetAttribute("Frequency", StringValue("1")); // update base station every second
 			     	serverHelper.SetAttribute( "PayloadSize", StringValue( "200" ) );
-			     	serverHelper.SetAttribute( "RetransmitPackets", IntegerValue( 0 ) );
 		  	     	serverHelper.SetAttribute( "Offset", IntegerValue( 0 ) );
 			     	serverHelper.SetAttribute( "LifeTime", StringValue( "10s" ) );
 				serverHelper.SetAttribute("UtilMin", IntegerValue(10));
@@ -243,7 +251,6 @@ main(int argc, char* argv[])
 				consumerHelper.SetAttribute("Frequency", StringValue(std::to_string(userRequest))); // 10 interests a second
 				consumerHelper.SetAttribute("Service", StringValue(temp));
 				consumerHelper.SetAttribute( "PayloadSize", StringValue( "200" ) );
-				consumerHelper.SetAttribute( "RetransmitPackets", IntegerValue( 0 ) );
 				consumerHelper.SetAttribute( "Offset", IntegerValue( 0 ) );
 				consumerHelper.SetAttribute( "LifeTime", StringValue( "10s" ) );
            		  	consumerHelper.SetAttribute( "NodeID", StringValue( netParams[0] ) );
@@ -283,7 +290,6 @@ main(int argc, char* argv[])
 			     	serverHelper.SetAttribute("UpdatePrefix",StringValue("/prefix/update/PECserver/"+std::to_string(servercount)));
 	 	  	     	serverHelper.SetAttribute("Frequency", StringValue("1")); // update base station every second
 			     	serverHelper.SetAttribute( "PayloadSize", StringValue( "200" ) );
-			     	serverHelper.SetAttribute( "RetransmitPackets", IntegerValue( 0 ) );
 		  	     	serverHelper.SetAttribute( "Offset", IntegerValue( 0 ) );
 			     	serverHelper.SetAttribute( "LifeTime", StringValue( "10s" ) );
 				serverHelper.SetAttribute("UtilMin", IntegerValue(20));
@@ -323,40 +329,38 @@ main(int argc, char* argv[])
 
   //Open trace file for writing
   char trace[100];
-  if(proactive)
-  	sprintf( trace, "ndn-proactive-%lf-%lf-%lf-run%d.csv", std::stod(PECChange), discovery, userRequest, run );
-  else
-  	sprintf( trace, "ndn-reactive-%lf-%lf-%lf-run%d.csv", std::stod(PECChange), discovery, userRequest, run );
+  sprintf( trace, "-%s-%lf-%lf-%lf-run%d.csv", proactive ? "proactive" : "reactive",
+           std::stod(PECChange), discovery, userRequest, run );
 
-  tracefile.open( trace, std::ios::out );
-  tracefile << "nodeid,event,name,time" << std::endl;
-  if(proactive)
-	  sprintf( trace, "choice-proactive-%lf-%lf-%lf-run%d.csv", std::stod(PECChange), discovery, userRequest, run );
-  else
-	  sprintf( trace, "choice-reactive-%lf-%lf-%lf-run%d.csv", std::stod(PECChange), discovery, userRequest, run );
+  tracefile = Create<ndn::TraceSink>( outputDir + "ndn" + trace );
+  tracefile->Write( "nodeid", "event", "name", "time" );
 
-  tracefile1.open( trace, std::ios::out );
-  tracefile1 << "nodeid,event,name,time" << std::endl;
-  if(proactive)
-          sprintf( trace, "execute-proactive-%lf-%lf-%lf-run%d.csv", std::stod(PECChange), discovery, userRequest, run );
-  else
-          sprintf( trace, "execute-reactive-%lf-%lf-%lf-run%d.csv", std::stod(PECChange), discovery, userRequest, run );
+  tracefile1 = Create<ndn::TraceSink>( outputDir + "choice" + trace );
+  tracefile1->Write( "nodeid", "event", "name", "time" );
 
-  tracefileE.open( trace, std::ios::out );
-  tracefileE << "nodeid,event,server,util,time,list,connected" << std::endl;
+  tracefileE = Create<ndn::TraceSink>( outputDir + "execute" + trace );
+  tracefileE->Write( "nodeid", "event", "server", "util", "time", "list", "connected" );
 
-  if(proactive)
-          sprintf( trace, "input-proactive-%lf-%lf-%lf-run%d.csv", std::stod(PECChange), discovery, userRequest, run );
-  else
-          sprintf( trace, "input-reactive-%lf-%lf-%lf-run%d.csv", std::stod(PECChange), discovery, userRequest, run );
+  tracefileInput = Create<ndn::TraceSink>( outputDir + "input" + trace );
+  tracefileInput->Write( "nodeid", "event", "name", "time" );
 
-  tracefileInput.open( trace, std::ios::out );
-  tracefileInput << "nodeid,event,name,time" << std::endl;
+  // percentiles of ServiceDelay (the latency of requests) without post-processing the ndn trace
+  if ( latencyHistogram > 0 ) {
+    std::string latencyTrace( trace );
+    latencyTrace.replace( latencyTrace.size() - 4, 4, ".txt" );
+    ndn::AppDelayTracer::SetHistogramPeriod( Seconds( latencyHistogram ) );
+    ndn::AppDelayTracer::InstallAll( outputDir + "latency" + latencyTrace );
+  }
 
 
   Simulator::Stop(Seconds(1000));
 
+  auto wallClockStart = std::chrono::steady_clock::now();
   Simulator::Run();
+  std::chrono::duration<double> wallClock = std::chrono::steady_clock::now() - wallClockStart;
+
+  std::cout << "Executed events: " << Simulator::GetEventCount()
+            << ", wall-clock time: " << wallClock.count() << "s" << std::endl;
   Simulator::Destroy();
 
   return 0;
@@ -364,24 +368,20 @@ main(int argc, char* argv[])
 
 
 void SentInterestCallback( uint32_t nodeid, shared_ptr<const ndn::Interest> interest){
-  tracefile << nodeid << ",sent," << interest->getName() << "," << std::fixed << setprecision( 9 ) << 
-	  ( Simulator::Now().GetNanoSeconds() )/1000000000.0 << std::endl;
+  tracefile->Write( nodeid, "sent", interest->getName(), Simulator::Now() );
 }
 
 void SentInterestPECCallback( uint32_t nodeid, shared_ptr<const ndn::Interest> interest){
-  tracefileInput << nodeid << ",sent," << interest->getName() << "," << std::fixed << setprecision( 9 ) <<
-          ( Simulator::Now().GetNanoSeconds() )/1000000000.0 << std::endl;
+  tracefileInput->Write( nodeid, "sent", interest->getName(), Simulator::Now() );
 }
 
 
 void BaseStationCallback( uint32_t nodeid){
-  tracefile << nodeid << ",over," << "__"<< "," << std::fixed << setprecision( 9 ) <<
-          ( Simulator::Now().GetNanoSeconds() )/1000000000.0 << std::endl;
+  tracefile->Write( nodeid, "over", "__", Simulator::Now() );
 }
 
 void DisStartCallback( uint32_t nodeid, shared_ptr<const ndn::Interest>){
-  tracefile << nodeid << ",dis," << "__"<< "," << std::fixed << setprecision( 9 ) <<
-          ( Simulator::Now().GetNanoSeconds() )/1000000000.0 << std::endl;
+  tracefile->Write( nodeid, "dis", "__", Simulator::Now() );
 }
 
 
@@ -393,34 +393,28 @@ void ReceivedDataCallback( uint32_t nodeid, shared_ptr<const ndn::Data> data, in
   uint32_t seq = data->getName().at( -1 ).toSequenceNumber();
   traceName.appendSequenceNumber(seq-1);
 
-  tracefile << nodeid << ",received," << traceName << "," << std::fixed << setprecision( 9 ) << 
-	  ( Simulator::Now().GetNanoSeconds() )/1000000000.0 << std::endl;
+  tracefile->Write( nodeid, "received", traceName, Simulator::Now() );
 }
 
 void  ReceivedDataPECCallback( uint32_t nodeid, shared_ptr<const ndn::Data> data){
-  tracefileInput << nodeid << ",received," << data->getName() << "," << std::fixed << setprecision( 9 ) <<
-          ( Simulator::Now().GetNanoSeconds() )/1000000000.0 << std::endl;
+  tracefileInput->Write( nodeid, "received", data->getName(), Simulator::Now() );
 }
 
 
 void ReceivedInterestCallback( uint32_t nodeid, shared_ptr<const ndn::Interest> interest ){
-  tracefile << nodeid << ",compute," << interest->getName() << "," << std::fixed << setprecision( 9 ) <<
-          ( Simulator::Now().GetNanoSeconds() )/1000000000.0 << std::endl;
+  tracefile->Write( nodeid, "compute", interest->getName(), Simulator::Now() );
 }
 
 void ServerChoiceCallback( uint32_t nodeid, std::string serverChoice, int serverUtil, std::string ser, bool connected){
-  tracefile1 << nodeid << ",choice," << serverChoice << "," << serverUtil << "," << std::fixed << setprecision( 9 ) <<
-          ( Simulator::Now().GetNanoSeconds() )/1000000000.0 << "," << ser << "," << connected<<std::endl;
+  tracefile1->Write( nodeid, "choice", serverChoice, serverUtil, Simulator::Now(), ser, connected );
 }
 
 void ExecuteCallback( uint32_t nodeid, std::string server,double time){
-  tracefileE << nodeid << ",exec," << server << "," << time << "," << std::fixed << setprecision( 9 ) <<
-          ( Simulator::Now().GetNanoSeconds() )/1000000000.0 << std::endl;
+  tracefileE->Write( nodeid, "exec", server, time, Simulator::Now() );
 }
 
 void ServerUpdateCallback( uint32_t nodeid, std::string server, int serverUtil){
-  tracefile1 << nodeid << ",update," << server << "," << serverUtil << "," << std::fixed << setprecision( 9 ) <<
-          ( Simulator::Now().GetNanoSeconds() )/1000000000.0 << std::endl;
+  tracefile1->Write( nodeid, "update", server, serverUtil, Simulator::Now() );
 }
 
 
@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-partition-topology.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM/utils/topology/annotated-topology-reader.hpp"
+#include "ns3/ndnSIM/utils/topology/topology-partitioner.hpp"
+
+#include <fstream>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * This program assigns system ids (MPI ranks) to the routers of an annotated topology file, so
+ * that the topology can be used in a parallel simulation with the given number of ranks:
+ *
+ *     ./waf --run="ndn-partition-topology --input=src/ndnSIM/examples/topologies/topo-tree.txt
+ *                  --output=topo-tree-2.txt --partitions=2"
+ *
+ * The output is a copy of the topology with the system id as the last column of the router
+ * section.  The number of links between partitions, the lookahead (the smallest delay of these
+ * links), and the estimated load of each partition are printed to the standard output.
+ */
+
+int
+main(int argc, char* argv[])
+{
+  std::string input;
+  std::string output;
+  uint32_t nPartitions = 2;
+  double imbalance = 0.1;
+  double degreeWeight = 1;
+
+  CommandLine cmd;
+  cmd.AddValue("input", "Annotated topology file", input);
+  cmd.AddValue("output", "Annotated topology file with system ids", output);
+  cmd.AddValue("partitions", "Number of partitions (MPI ranks)", nPartitions);
+  cmd.AddValue("imbalance", "Allowed excess of partition load over the average", imbalance);
+  cmd.AddValue("degreeWeight", "Load of a link relative to the load of a node", degreeWeight);
+  cmd.Parse(argc, argv);
+
+  if (!std::ifstream(input).is_open()) {
+    std::cerr << "File " << input << " cannot be opened for reading" << std::endl;
+    return 1;
+  }
+  if (output.empty()) {
+    std::cerr << "Output file is not specified" << std::endl;
+    return 1;
+  }
+
+  AnnotatedTopologyReader reader;
+  reader.SetFileName(input);
+  reader.Read();
+
+  if (nPartitions == 0 || nPartitions > reader.GetNodes().GetN()) {
+    std::cerr << "Number of partitions must be between 1 and the number of nodes ("
+              << reader.GetNodes().GetN() << ")" << std::endl;
+    return 1;
+  }
+
+  TopologyPartitioner partitioner;
+  partitioner.SetImbalance(imbalance);
+  partitioner.SetDegreeWeight(degreeWeight);
+  partitioner.Partition(reader, nPartitions);
+
+  reader.SaveTopology(output);
+
+  std::cout << "Links between partitions: " << partitioner.GetNCutLinks() << std::endl;
+  if (partitioner.GetNCutLinks() > 0) {
+    std::cout << "Lookahead: " << partitioner.GetLookahead().As(Time::MS) << std::endl;
+  }
+  for (uint32_t systemId = 0; systemId < nPartitions; ++systemId) {
+    std::cout << "Load of partition " << systemId << ": " << partitioner.GetLoad(systemId)
+              << std::endl;
+  }
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
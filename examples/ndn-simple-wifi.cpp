@@ -108,6 +108,8 @@ main(int argc, char* argv[])
   ndnHelper.setPolicy("nfd::cs::lru");
   ndnHelper.setCsSize(1000);
   ndnHelper.SetDefaultRoutes(true);
+  // reply to Interests with unicast (acknowledged) frames
+  ndnHelper.setUnicastReplies();
   ndnHelper.Install(nodes);
 
   // Set BestRoute strategy
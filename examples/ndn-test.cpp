@@ -184,7 +184,6 @@ main(int argc, char* argv[])
   consumerHelper.SetPrefix("/prefix");
   consumerHelper.SetAttribute("Frequency", StringValue(".1")); // 10 interests a second
   consumerHelper.SetAttribute( "PayloadSize", StringValue( "200" ) );
-  consumerHelper.SetAttribute( "RetransmitPackets", IntegerValue( 0 ) );
   consumerHelper.SetAttribute( "Offset", IntegerValue( 0 ) );
   consumerHelper.SetAttribute( "LifeTime", StringValue( "10s" ) );
   auto app = consumerHelper.Install(nodes.Get(0));      // first node
@@ -239,7 +238,6 @@ main(int argc, char* argv[])
   serverHelper.SetAttribute("UpdatePrefix",StringValue("/prefix/update/server1"));
   serverHelper.SetAttribute("Frequency", StringValue("1")); // update base station every second
   serverHelper.SetAttribute( "PayloadSize", StringValue( "200" ) );
-  serverHelper.SetAttribute( "RetransmitPackets", IntegerValue( 0 ) );
   serverHelper.SetAttribute( "Offset", IntegerValue( 0 ) );
   serverHelper.SetAttribute( "LifeTime", StringValue( "10s" ) );
   serverHelper.Install(nodes.Get(2));      // first node
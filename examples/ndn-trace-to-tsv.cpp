@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-trace-to-tsv.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM/utils/tracers/ndn-binary-trace.hpp"
+
+#include <fstream>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * This program converts binary traces, written by tracers after SetBinaryOutput(true), e.g.,
+ *
+ *     ndn::L3RateTracer::SetBinaryOutput(true);
+ *     ndn::L3RateTracer::InstallAll("rate-trace.bin", Seconds(0.5));
+ *
+ * back to the tab-separated text format expected by existing post-processing scripts:
+ *
+ *     ./waf --run="ndn-trace-to-tsv --input=rate-trace.bin --output=rate-trace.txt"
+ *
+ * If output is not specified, the text is written to the standard output.
+ */
+
+int
+main(int argc, char* argv[])
+{
+  std::string input;
+  std::string output = "-";
+
+  CommandLine cmd;
+  cmd.AddValue("input", "Binary trace file", input);
+  cmd.AddValue("output", "Text trace file (- for standard output)", output);
+  cmd.Parse(argc, argv);
+
+  std::ifstream is(input, std::ios_base::in | std::ios_base::binary);
+  if (!is.is_open()) {
+    std::cerr << "File " << input << " cannot be opened for reading" << std::endl;
+    return 1;
+  }
+
+  std::ofstream os;
+  if (output != "-") {
+    os.open(output, std::ios_base::out | std::ios_base::trunc);
+    if (!os.is_open()) {
+      std::cerr << "File " << output << " cannot be opened for writing" << std::endl;
+      return 1;
+    }
+  }
+
+  try {
+    ndn::BinaryTraceReader::ConvertToTsv(is, output != "-" ? os : std::cout);
+  }
+  catch (const ndn::BinaryTraceReader::Error& e) {
+    std::cerr << input << ": " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -20,156 +20,166 @@
 
 #include "ns3/ndnSIM/helper/ndn-global-routing-helper.hpp"
 
-#include <boost/graph/dijkstra_shortest_paths.hpp>
-#include <boost/graph/graph_utility.hpp>
-
-#include "ns3/ndnSIM/helper/boost-graph-ndn-global-routing-helper.hpp"
 #include "ns3/ndnSIM/helper/lfid/abstract-fib.hpp"
 #include "ns3/ndnSIM/helper/lfid/remove-loops.hpp"
 #include "ns3/ndnSIM/helper/ndn-fib-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-global-routing-graph.hpp"
 #include "ns3/ndnSIM/model/ndn-global-router.hpp"
 
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
 NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelperLfid");
 
 namespace ns3 {
 namespace ndn {
 
-using std::get;
 using std::unordered_map;
 
 void
 GlobalRoutingHelper::CalculateLfidRoutes()
 {
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
-
-  // Creates graph from nodeList:
-  boost::NdnGlobalRouterGraph graph{};
+  // Snapshot of the topology; all Dijkstra runs work on the snapshot, so that sources can be
+  // processed concurrently
+  GlobalRoutingGraph graph;
+
+  // same as boost::WeightInf; paths of this cost or more are treated as loops back to the source
+  const GlobalRoutingGraph::Distance weightInf = std::numeric_limits<uint16_t>::max();
+
+  // vertex -> node id (-1 for channels)
+  std::vector<int> vertexNodeId(graph.getNVertices(), -1);
+  for (GlobalRoutingGraph::Vertex v = 0; v < graph.getNVertices(); v++) {
+    Ptr<Node> node = graph.getRouter(v)->GetObject<Node>();
+    if (node != nullptr) {
+      vertexNodeId[v] = static_cast<int>(node->GetId());
+    }
+  }
 
-  AbstractFib::AllNodeFib allNodeFIB;
+  std::vector<GlobalRoutingGraph::Vertex> sources;
+  std::vector<AbstractFib> nodeFibs;
 
-  // Store mapping nodeId -> faceId -> Ptr<Face>
-  unordered_map<int, unordered_map<nfd::FaceId, shared_ptr<Face>>> faceMap;
+  // Store mapping nodeId -> neighbor nodeId -> Ptr<Face>
+  unordered_map<int, unordered_map<int, shared_ptr<Face>>> faceMap;
 
-  // For all existing nodes:
   for (auto node = NodeList::Begin(); node != NodeList::End(); node++) {
-
     int nodeId = static_cast<int>((*node)->GetId());
-    const Ptr<GlobalRouter>& source = (*node)->GetObject<GlobalRouter>();
-
-    AbstractFib nodeFib = AbstractFib{source, static_cast<int>(NodeList::GetNNodes())};
-
+    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
     if (source == nullptr) {
       NS_LOG_ERROR("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
       continue;
     }
 
-    // map: neighborId -> DistancesMap
-    unordered_map<int, boost::DistancesMap> nbSp;
-
-    // map: Destination (GlobalRouter) -> Distance
-    boost::DistancesMap distMap;
-    unordered_map<int, boost::DistancesMap> neighborSpMap;
-
-    dijkstra_shortest_paths(graph, source,
-                            distance_map(boost::ref(distMap))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
+    GlobalRoutingGraph::Vertex sourceVertex = graph.getVertex(source);
+    sources.push_back(sourceVertex);
+    nodeFibs.emplace_back(source, static_cast<int>(NodeList::GetNNodes()));
 
-    // 1. Get all neighbors of node.
-    unordered_map<nfd::FaceId, uint64_t> originalMetrics;
     auto& originalFace = faceMap[nodeId];
-
-    const GlobalRouter::IncidencyList& neighbors = source->GetIncidencies();
-    // Set link weight of all neighbors to infinity
-    for (const auto& neighbor : neighbors) {
-      int nbId = get<2>(neighbor)->GetObject<ns3::Node>()->GetId();
-      NS_ABORT_UNLESS(nbId != nodeId);
-
-      auto& face = get<shared_ptr<Face>>(neighbor);
-      NS_ABORT_UNLESS(face != nullptr);
-
-      originalMetrics[nbId] = face->getMetric();
-      originalFace[nbId] = face; // Is only a copy
-      face->setMetric(get<uint16_t>(boost::WeightInf));
+    GlobalRoutingGraph::Edge first, last;
+    std::tie(first, last) = graph.getOutEdges(sourceVertex);
+    for (GlobalRoutingGraph::Edge e = first; e < last; e++) {
+      int nbId = vertexNodeId[graph.getTarget(e)];
+      NS_ABORT_UNLESS(nbId >= 0 && nbId != nodeId);
+      NS_ABORT_UNLESS(graph.getFace(e) != nullptr);
+
+      originalFace[nbId] = graph.getFace(e);
     }
+  }
 
-    // 2. Calculate Dijkstra for neighbors
-    for (const auto& neighbor : neighbors) {
-      const auto& nSource = get<0>(neighbor);
-      const auto& target = get<2>(neighbor);
+  struct WorkerState {
+    std::vector<GlobalRoutingGraph::Distance> spDistance;
+    GlobalRoutingGraph::ShortestPaths paths;
+    GlobalRoutingGraph::WeightOverlay overlay;
+    // neighbor vertex -> edge to it (last edge, if there are several)
+    std::vector<std::pair<GlobalRoutingGraph::Vertex, GlobalRoutingGraph::Edge>> neighbors;
+  };
+  std::vector<WorkerState> workspace(GetNumberOfThreads());
 
-      int nbId = target->GetObject<ns3::Node>()->GetId();
-      Ptr<GlobalRouter> nbRouter = target;
+  AbstractFib::AllNodeFib allNodeFIB;
 
-      NS_ABORT_UNLESS(target != source && nbId != nodeId);
-      NS_ABORT_UNLESS(nSource == source);
+  ProcessSources(sources.size(),
+    [&] (size_t i, size_t thread) {
+      auto& state = workspace[thread];
+      GlobalRoutingGraph::Vertex source = sources[i];
+      AbstractFib& nodeFib = nodeFibs[i];
+
+      // 1. Shortest paths from the node
+      graph.calculateShortestPaths(source, state.paths);
+      state.spDistance = state.paths.distance;
+
+      // 2. Get all neighbors of node, set link weight of all neighbors to infinity
+      GlobalRoutingGraph::Edge first, last;
+      std::tie(first, last) = graph.getOutEdges(source);
+
+      state.neighbors.clear();
+      for (GlobalRoutingGraph::Edge e = first; e < last; e++) {
+        auto nb = std::find_if(state.neighbors.begin(), state.neighbors.end(),
+                               [&] (const std::pair<GlobalRoutingGraph::Vertex,
+                                                    GlobalRoutingGraph::Edge>& item) {
+                                 return item.first == graph.getTarget(e);
+                               });
+        if (nb != state.neighbors.end()) {
+          nb->second = e;
+        }
+        else {
+          state.neighbors.emplace_back(graph.getTarget(e), e);
+        }
+      }
 
-      dijkstra_shortest_paths(graph, nbRouter,
-                              distance_map(boost::ref(neighborSpMap[nbId]))
-                                .distance_inf(boost::WeightInf)
-                                .distance_zero(boost::WeightZero)
-                                .distance_compare(boost::WeightCompare())
-                                .distance_combine(boost::WeightCombine()));
-    }
+      state.overlay.vertex = source;
+      state.overlay.weights.assign(last - first, weightInf);
 
-    // 3. Reset link weights
-    for (const auto& neighbor : neighbors) {
-      int nbId = get<2>(neighbor)->GetObject<ns3::Node>()->GetId();
-      NS_ABORT_UNLESS(nbId != nodeId);
+      // 3. Dijkstra for each neighbor, and 4. fill Abstract FIB
+      for (const auto& neighbor : state.neighbors) {
+        int neighborId = vertexNodeId[neighbor.first];
+        int originalMetric = static_cast<int>(graph.getWeight(neighbor.second));
 
-      const auto& face = get<shared_ptr<Face>>(neighbor);
-      NS_ABORT_UNLESS(face->getMetric() == get<uint16_t>(boost::WeightInf));
-      face->setMetric(originalMetrics.at(nbId));
-    }
+        graph.calculateShortestPaths(neighbor.first, state.paths, state.overlay);
 
-    // 4. Fill Abstract FIB:
-    // For each destination:
-    for (const auto& dstEntry : distMap) {
-      Ptr<GlobalRouter> dstRouter = dstEntry.first;
-      int dstId = dstRouter->GetObject<ns3::Node>()->GetId();
-      if (dstRouter == source)
-        continue; // Skip destination == source.
+        // For each destination:
+        for (GlobalRoutingGraph::Vertex dst = 0; dst < graph.getNVertices(); dst++) {
+          int dstId = vertexNodeId[dst];
+          if (dst == source || dstId < 0 || state.spDistance[dst] >= weightInf)
+            continue; // Skip destination == source, channels, and unreachable destinations
 
-      int spTotalCost = static_cast<int>(get<uint32_t>(dstEntry.second));
+          // Skip routers that would loop back
+          if (state.paths.distance[dst] >= weightInf)
+            continue;
 
-      // For each neighbor:
-      for (const auto& nb : neighborSpMap) {
-        int neighborId = nb.first;
-        const uint32_t nbDist{get<uint32_t>(nb.second.at(dstRouter))};
+          int spTotalCost = static_cast<int>(state.spDistance[dst]);
+          int neighborCost = static_cast<int>(state.paths.distance[dst]);
+          int neighborTotalCost = neighborCost + originalMetric;
 
-        int neighborCost = static_cast<int>(nbDist);
-        int neighborTotalCost = neighborCost + static_cast<int>(originalFace.at(neighborId)->getMetric());
+          NS_ABORT_UNLESS(neighborTotalCost >= spTotalCost);
 
-        NS_ABORT_UNLESS(neighborTotalCost >= spTotalCost);
+          if (neighborTotalCost >= static_cast<int>(weightInf))
+            continue;
 
-        // Skip routers that would loop back
-        if (neighborTotalCost >= static_cast<int>(get<uint16_t>(boost::WeightInf)))
-          continue;
+          NextHopType nbType;
+          if (neighborCost < spTotalCost) {
+            nbType = NextHopType::DOWNWARD;
+          }
+          else {
+            nbType = NextHopType::UPWARD;
+          }
 
-        NextHopType nbType;
-        if (neighborCost < spTotalCost) {
-          nbType = NextHopType::DOWNWARD;
-        }
-        else {
-          nbType = NextHopType::UPWARD;
+          int costDelta = neighborTotalCost - spTotalCost;
+          FibNextHop nh = {neighborTotalCost, neighborId, costDelta, nbType};
+          nodeFib.insert(dstId, nh);
         }
-
-        int costDelta = neighborTotalCost - spTotalCost;
-        FibNextHop nh = {neighborTotalCost, neighborId, costDelta, nbType};
-        nodeFib.insert(dstId, nh);
       }
 
-    } // End for all dsts
-
-    nodeFib.checkFib();
-    allNodeFIB.emplace(nodeId, nodeFib);
-  } // End for all nodes
+      nodeFib.checkFib();
+    },
+    [&] (size_t i) {
+      allNodeFIB.emplace(vertexNodeId[sources[i]], std::move(nodeFibs[i]));
+    });
 
   ///  4. Remove loops and Deadends ///
-  removeLoops(allNodeFIB, true);
+  removeLoops(allNodeFIB, true, GetNumberOfThreads());
   removeDeadEnds(allNodeFIB, true);
 
   // 5. Insert from AbsFIB into real FIB!
@@ -177,6 +187,7 @@ GlobalRoutingHelper::CalculateLfidRoutes()
   for (const auto& nodeEntry : allNodeFIB) {
     int nodeId = nodeEntry.first;
     const auto& fib = nodeEntry.second;
+    std::vector<FibHelper::RouteSpec> routes;
 
     // For each destination:
     for (const auto& dst : fib) {
@@ -189,11 +200,12 @@ GlobalRoutingHelper::CalculateLfidRoutes()
         int neighborTotalCost = nh.getCost();
 
         for (const auto& prefix : dstRouter->GetLocalPrefixes()) {
-          Ptr<Node> node = NodeList::GetNode(static_cast<uint32_t>(nodeId));
-          FibHelper::AddRoute(node, *prefix, faceMap.at(nodeId).at(neighborId), neighborTotalCost);
+          routes.push_back({*prefix, faceMap.at(nodeId).at(neighborId), neighborTotalCost});
         }
       }
     }
+
+    FibHelper::AddRoutes(NodeList::GetNode(static_cast<uint32_t>(nodeId)), routes);
   }
 }
 
@@ -20,11 +20,11 @@
 
 #include "remove-loops.hpp"
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
-#include <boost/graph/properties.hpp>
-#include <boost/property_map/property_map.hpp>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
 #include <queue>
+#include <thread>
 
 #include "ns3/abort.h"
 #include "ns3/ndnSIM/helper/lfid/abstract-fib.hpp"
@@ -35,30 +35,6 @@ namespace ndn {
 using std::set;
 using AllNodeFib = AbstractFib::AllNodeFib;
 
-/**
- * Fill directed graph only with edges existing in the FIB.
- */
-void
-getDigraphFromFib(DiGraph& dg, const AllNodeFib& allNodeFIB, const int dstId)
-{
-
-  // 1. Erase All Arcs:
-  dg.clear();
-
-  // 2. Add Arcs from FIB
-  for (const auto& node : allNodeFIB) {
-    int nodeId = node.first;
-    if (dstId == nodeId) {
-      continue;
-    }
-
-    for (const auto& fibNh : node.second.getNexthops(dstId)) {
-      NS_ABORT_UNLESS(fibNh.getType() <= NextHopType::UPWARD);
-      boost::add_edge(static_cast<uint64_t>(nodeId), static_cast<uint64_t>(fibNh.getNexthopId()), 1, dg);
-    }
-  }
-}
-
 class NodePrio {
 public:
   NodePrio(int nodeId, int remainingNh, set<FibNextHop> nhSet)
@@ -142,107 +118,277 @@ operator<<(std::ostream& os, const NodePrio& node)
             << ", remaining UW: " << node.getRemainingUw() << " ";
 }
 
-int
-removeLoops(AllNodeFib& allNodeFIB, bool printOutput)
-{
-  int removedLoopCounter = 0;
-  int upwardCounter = 0;
+/**
+ * Nexthops towards one destination as a directed graph with edge removal.
+ *
+ * Edges are kept in compressed (CSR) form in both directions and removed edges are only
+ * flagged, so the graph is rebuilt without allocations for every destination.  Reachability
+ * is checked with a bidirectional BFS that stops as soon as both searches meet, instead of
+ * computing distances to all vertices.
+ */
+class NexthopGraph {
+public:
+  NexthopGraph()
+    : m_generation{0}
+  {
+  }
 
-  const int NUM_NODES{static_cast<int>(allNodeFIB.size())};
+  /**
+   * Fill graph only with edges existing in the FIB.
+   */
+  void
+  assign(const AllNodeFib& allNodeFIB, int dstId)
+  {
+    int numVertices = 0;
+    m_sources.clear();
+    m_targets.clear();
+    for (const auto& node : allNodeFIB) {
+      int nodeId = node.first;
+      numVertices = std::max(numVertices, nodeId + 1);
+      if (dstId == nodeId) {
+        continue;
+      }
 
-  // Build graph with boost graph library:
-  DiGraph dg{};
+      for (const auto& fibNh : node.second.getNexthops(dstId)) {
+        NS_ABORT_UNLESS(fibNh.getType() <= NextHopType::UPWARD);
+        m_sources.push_back(nodeId);
+        m_targets.push_back(fibNh.getNexthopId());
+        numVertices = std::max(numVertices, fibNh.getNexthopId() + 1);
+      }
+    }
 
-  // Add all Arcs that fit into FIB. // O(n)
-  for (int dstId = 0; dstId < NUM_NODES; dstId++) {
-    // 1. Get DiGraph from Fib //
-    getDigraphFromFib(dg, allNodeFIB, dstId);
+    const int numEdges = static_cast<int>(m_sources.size());
+    m_isAlive.assign(numEdges, true);
+    m_outOffsets.assign(numVertices + 1, 0);
+    m_inOffsets.assign(numVertices + 1, 0);
+    for (int edge = 0; edge < numEdges; edge++) {
+      m_outOffsets[m_sources[edge] + 1]++;
+      m_inOffsets[m_targets[edge] + 1]++;
+    }
+    std::partial_sum(m_outOffsets.begin(), m_outOffsets.end(), m_outOffsets.begin());
+    std::partial_sum(m_inOffsets.begin(), m_inOffsets.end(), m_inOffsets.begin());
+
+    m_outEdges.resize(numEdges);
+    m_inEdges.resize(numEdges);
+    std::vector<int> nextOut(m_outOffsets.begin(), m_outOffsets.end() - 1);
+    std::vector<int> nextIn(m_inOffsets.begin(), m_inOffsets.end() - 1);
+    for (int edge = 0; edge < numEdges; edge++) {
+      m_outEdges[nextOut[m_sources[edge]]++] = edge;
+      m_inEdges[nextIn[m_targets[edge]]++] = edge;
+    }
 
-    // NodeId -> set<UwNexthops>
-    std::priority_queue<NodePrio> q;
+    if (m_forwardMarks.size() < static_cast<size_t>(numVertices)) {
+      m_forwardMarks.resize(numVertices, 0);
+      m_backwardMarks.resize(numVertices, 0);
+    }
+  }
 
-    // 2. Put nodes in the queue, ordered by # remaining nexthops, then CostDelta // O(n^2)
-    for (const auto& node : allNodeFIB) {
-      int nodeId{node.first};
-      const AbstractFib& fib{node.second};
-      if (nodeId == dstId) {
-        continue;
+  /**
+   * @return Edge from @p from to @p to, -1 if there is none
+   */
+  int
+  findEdge(int from, int to) const
+  {
+    for (int i = m_outOffsets[from]; i < m_outOffsets[from + 1]; i++) {
+      if (m_targets[m_outEdges[i]] == to && m_isAlive[m_outEdges[i]]) {
+        return m_outEdges[i];
       }
+    }
+    return -1;
+  }
 
-      const auto& uwNhSet = fib.getUpwardNexthops(dstId);
-      if (!uwNhSet.empty()) {
-        upwardCounter += uwNhSet.size();
+  void
+  setAlive(int edge, bool isAlive)
+  {
+    m_isAlive[edge] = isAlive;
+  }
+
+  /**
+   * Is @p to reachable from @p from over edges that are not removed?
+   */
+  bool
+  isReachable(int from, int to)
+  {
+    if (++m_generation == 0) {
+      std::fill(m_forwardMarks.begin(), m_forwardMarks.end(), 0);
+      std::fill(m_backwardMarks.begin(), m_backwardMarks.end(), 0);
+      m_generation = 1;
+    }
 
-        int fibSize{fib.numEnabledNhPerDst(dstId)};
-        // NodePrio tmpNode {nodeId, fibSize, uwNhSet};
-        q.emplace(nodeId, fibSize, uwNhSet);
+    m_forward.assign(1, from);
+    m_backward.assign(1, to);
+    m_forwardMarks[from] = m_generation;
+    m_backwardMarks[to] = m_generation;
+
+    // expand the smaller frontier by one level, until the searches meet or one runs out
+    while (!m_forward.empty() && !m_backward.empty()) {
+      bool isForward = m_forward.size() <= m_backward.size();
+      std::vector<int>& frontier = isForward ? m_forward : m_backward;
+      std::vector<uint32_t>& marks = isForward ? m_forwardMarks : m_backwardMarks;
+      const std::vector<uint32_t>& otherMarks = isForward ? m_backwardMarks : m_forwardMarks;
+      const std::vector<int>& offsets = isForward ? m_outOffsets : m_inOffsets;
+      const std::vector<int>& edges = isForward ? m_outEdges : m_inEdges;
+      const std::vector<int>& ends = isForward ? m_targets : m_sources;
+
+      m_next.clear();
+      for (int vertex : frontier) {
+        for (int i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+          int edge = edges[i];
+          if (!m_isAlive[edge]) {
+            continue;
+          }
+          int other = ends[edge];
+          if (otherMarks[other] == m_generation) {
+            return true;
+          }
+          if (marks[other] != m_generation) {
+            marks[other] = m_generation;
+            m_next.push_back(other);
+          }
+        }
       }
+      frontier.swap(m_next);
     }
+    return false;
+  }
 
-    // 3. Iterate PriorityQueue //
-    while (!q.empty()) {
-      NodePrio node = q.top();
-      q.pop();
+private:
+  std::vector<int> m_sources;
+  std::vector<int> m_targets;
+  std::vector<bool> m_isAlive;
+  std::vector<int> m_outOffsets;
+  std::vector<int> m_outEdges;
+  std::vector<int> m_inOffsets;
+  std::vector<int> m_inEdges;
+
+  // search workspace
+  uint32_t m_generation;
+  std::vector<uint32_t> m_forwardMarks;
+  std::vector<uint32_t> m_backwardMarks;
+  std::vector<int> m_forward;
+  std::vector<int> m_backward;
+  std::vector<int> m_next;
+};
 
-      int nodeId = node.getId();
-      int nhId = node.popHighestCostUw().getNexthopId();
+/**
+ * Find upward nexthops towards @p dstId that loop back, without changing the FIB.
+ *
+ * Only FIB entries of @p dstId are read, so different destinations can be processed
+ * concurrently and their loops erased afterwards.
+ *
+ * @param[out] loops Pairs (nodeId, nexthopId) of looping upward nexthops
+ * @return Number of upward nexthops towards @p dstId
+ */
+static int
+findLoops(const AllNodeFib& allNodeFIB, int dstId, NexthopGraph& dg,
+          std::vector<std::pair<int, int>>& loops)
+{
+  int upwardCounter = 0;
 
-      // Remove opposite of Uphill link
-      //      int arcId1 {getArcId(arcMap, nhId, nodeId)};
-      auto res = boost::edge(static_cast<uint64_t>(nhId), static_cast<uint64_t>(nodeId), dg);
+  // 1. Get nexthop graph from Fib //
+  dg.assign(allNodeFIB, dstId);
 
-      auto arc = res.first;
-      bool arcExists = res.second;
+  // NodeId -> set<UwNexthops>
+  std::priority_queue<NodePrio> q;
 
-      if (arcExists) {
-        boost::remove_edge(arc, dg);
-      }
+  // 2. Put nodes in the queue, ordered by # remaining nexthops, then CostDelta // O(n^2)
+  for (const auto& node : allNodeFIB) {
+    int nodeId{node.first};
+    const AbstractFib& fib{node.second};
+    if (nodeId == dstId) {
+      continue;
+    }
 
-      // 2. Loop Check: Is the current node still reachable for the uphill nexthop?
-      // Uses BFS:
-      // bool willLoop = bfs(dg).run(dg.nodeFromId(nhId), dg.nodeFromId(nodeId)); // O(m^2n)
+    const auto& uwNhSet = fib.getUpwardNexthops(dstId);
+    if (!uwNhSet.empty()) {
+      upwardCounter += uwNhSet.size();
 
-      std::vector<int> dists(num_vertices(dg));
+      int fibSize{fib.numEnabledNhPerDst(dstId)};
+      q.emplace(nodeId, fibSize, uwNhSet);
+    }
+  }
 
-      auto weightmap = get(boost::edge_weight, dg);
+  // 3. Iterate PriorityQueue //
+  while (!q.empty()) {
+    NodePrio node = q.top();
+    q.pop();
 
-      const auto& x = boost::edges(dg);
-      for (auto e = x.first; e != x.second; e++) {
-        int weight = get(weightmap, *e);
-        NS_ABORT_UNLESS(weight == 1); // Only use uniform weights.
-      }
+    int nodeId = node.getId();
+    int nhId = node.popHighestCostUw().getNexthopId();
 
-      // TODO: Could be replaced by BFS/DFS to improve speed.
-      dijkstra_shortest_paths(dg, static_cast<uint64_t>(nhId),
-                              distance_map(
-                                boost::make_iterator_property_map(dists.begin(), get(boost::vertex_index, dg))));
+    // Remove opposite of Uphill link
+    int reverseArc = dg.findEdge(nhId, nodeId);
+    if (reverseArc >= 0) {
+      dg.setAlive(reverseArc, false);
+    }
 
-      bool willLoop = (dists.at(static_cast<size_t>(nodeId)) < (std::numeric_limits<int>::max() - 1));
+    // Loop Check: Is the current node still reachable for the uphill nexthop?
+    bool willLoop = dg.isReachable(nhId, nodeId);
 
-      // Uphill nexthop loops back to original node
-      if (willLoop) {
-        node.reduceRemainingNh();
-        removedLoopCounter++;
+    // Uphill nexthop loops back to original node
+    if (willLoop) {
+      node.reduceRemainingNh();
+      loops.emplace_back(nodeId, nhId);
 
-        // Erase FIB entry
-        allNodeFIB.at(node.getId()).erase(dstId, nhId);
+      int arc = dg.findEdge(nodeId, nhId);
+      NS_ABORT_UNLESS(arc >= 0);
+      dg.setAlive(arc, false);
+    }
 
-        auto res2 = boost::edge(static_cast<uint64_t>(node.getId()), static_cast<uint64_t>(nhId), dg);
-        auto arc2 = res2.first;
-        NS_ABORT_UNLESS(res.second);
+    // Add opposite of UW link back:
+    if (reverseArc >= 0) {
+      dg.setAlive(reverseArc, true);
+    }
 
-        boost::remove_edge(arc2, dg);
-      }
+    // If not has further UW nexthops: Requeue.
+    if (node.getRemainingUw() > 0) {
+      q.push(node);
+    }
+  }
 
-      // Add opposite of UW link back:
-      if (arcExists) {
-        boost::add_edge(static_cast<uint64_t>(nhId), static_cast<uint64_t>(nodeId), 1, dg);
-      }
+  return upwardCounter;
+}
 
-      // If not has further UW nexthops: Requeue.
-      if (node.getRemainingUw() > 0) {
-        q.push(node);
-      }
+int
+removeLoops(AllNodeFib& allNodeFIB, bool printOutput, size_t numThreads)
+{
+  const int NUM_NODES{static_cast<int>(allNodeFIB.size())};
+  numThreads = std::max<size_t>(1, std::min<size_t>(numThreads, NUM_NODES));
+
+  // Destinations are independent: find loops of all destinations (concurrently), then erase
+  // them from the FIBs.
+  std::vector<std::vector<std::pair<int, int>>> loops(NUM_NODES);
+  std::vector<int> upwardCounters(NUM_NODES, 0);
+
+  std::atomic<int> nextDstId{0};
+  auto worker = [&] {
+    NexthopGraph dg;
+    for (int dstId = nextDstId++; dstId < NUM_NODES; dstId = nextDstId++) {
+      upwardCounters[dstId] = findLoops(allNodeFIB, dstId, dg, loops[dstId]);
+    }
+  };
+
+  if (numThreads == 1) {
+    worker();
+  }
+  else {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numThreads; i++) {
+      threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  int removedLoopCounter = 0;
+  int upwardCounter = 0;
+  for (int dstId = 0; dstId < NUM_NODES; dstId++) {
+    upwardCounter += upwardCounters[dstId];
+    for (const auto& loop : loops[dstId]) {
+      // Erase FIB entry
+      allNodeFIB.at(loop.first).erase(dstId, loop.second);
+      removedLoopCounter++;
     }
   }
 
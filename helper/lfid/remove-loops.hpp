@@ -21,24 +21,20 @@
 #ifndef LFID_REMOVE_LOOPS_H
 #define LFID_REMOVE_LOOPS_H
 
-#include <boost/graph/adjacency_list.hpp>
-
 #include "ns3/ndnSIM/helper/lfid/abstract-fib.hpp"
 
 namespace ns3 {
 namespace ndn {
 
-// No Vertex Property
-// Edge Property: Weight.
-using DiGraph =
-  boost::adjacency_list<boost::listS, boost::vecS, boost::bidirectionalS, boost::no_property,
-                        boost::property<boost::edge_weight_t, int>>;
-
-void
-getDigraphFromFib(DiGraph& dg, const AbstractFib::AllNodeFib& allNodeFIB, const int dstId);
-
+/**
+ * Remove upward nexthops that cause loops.
+ *
+ * @param numThreads Number of threads; destinations are processed independently
+ * @return Number of removed nexthops
+ */
 int
-removeLoops(AbstractFib::AllNodeFib& allNodeFIB, bool printOutput = true);
+removeLoops(AbstractFib::AllNodeFib& allNodeFIB, bool printOutput = true,
+            size_t numThreads = 1);
 
 int
 removeDeadEnds(AbstractFib::AllNodeFib& allNodeFIB, bool printOutput = true);
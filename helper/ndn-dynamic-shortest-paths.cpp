@@ -0,0 +1,257 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-dynamic-shortest-paths.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <tuple>
+
+namespace ns3 {
+namespace ndn {
+
+DynamicShortestPaths::DynamicShortestPaths(const GlobalRoutingGraph& graph,
+                                           std::vector<Vertex> sources)
+  : m_graph(graph)
+  , m_sources(std::move(sources))
+  , m_rows(m_sources.size())
+  , m_markGeneration(0)
+{
+  const size_t nVertices = m_graph.getNVertices();
+  const size_t nEdges = m_graph.getNEdges();
+
+  m_edgeSources.resize(nEdges);
+  m_inOffsets.assign(nVertices + 1, 0);
+  for (Vertex u = 0; u < nVertices; u++) {
+    Edge first, last;
+    std::tie(first, last) = m_graph.getOutEdges(u);
+    for (Edge e = first; e < last; e++) {
+      m_edgeSources[e] = u;
+      m_inOffsets[m_graph.getTarget(e) + 1]++;
+    }
+  }
+  std::partial_sum(m_inOffsets.begin(), m_inOffsets.end(), m_inOffsets.begin());
+
+  m_inEdges.resize(nEdges);
+  std::vector<Edge> next(m_inOffsets.begin(), m_inOffsets.end() - 1);
+  for (Edge e = 0; e < nEdges; e++) {
+    m_inEdges[next[m_graph.getTarget(e)]++] = e;
+  }
+
+  m_marks.assign(nVertices, 0);
+}
+
+void
+DynamicShortestPaths::calculate(size_t source, GlobalRoutingGraph::ShortestPaths& workspace)
+{
+  m_graph.calculateShortestPaths(m_sources[source], workspace);
+  m_rows[source].distance = workspace.distance;
+  m_rows[source].firstHop = workspace.firstHop;
+}
+
+std::vector<DynamicShortestPaths::Change>
+DynamicShortestPaths::setWeights(const std::vector<std::pair<Edge, Distance>>& weights)
+{
+  m_changes.clear();
+
+  for (const auto& edgeWeight : weights) {
+    Edge e = edgeWeight.first;
+    Distance oldWeight = m_graph.getWeight(e);
+    Distance newWeight = edgeWeight.second;
+    if (newWeight == oldWeight)
+      continue;
+
+    m_graph.setWeight(e, newWeight);
+    for (size_t source = 0; source < m_sources.size(); source++) {
+      if (m_rows[source].distance.empty())
+        continue; // not calculated
+
+      if (newWeight > oldWeight) {
+        increaseWeight(source, e, oldWeight);
+      }
+      else {
+        decreaseWeight(source, e);
+      }
+    }
+  }
+
+  std::vector<Change> changes;
+  for (const auto& item : m_changes) {
+    const Change& change = item.second;
+    const Row& row = m_rows[change.source];
+    if (row.distance[change.target] != change.oldDistance ||
+        row.firstHop[change.target] != change.oldFirstHop) {
+      changes.push_back(change);
+    }
+  }
+  std::sort(changes.begin(), changes.end(), [] (const Change& a, const Change& b) {
+      return a.source < b.source || (a.source == b.source && a.target < b.target);
+    });
+  return changes;
+}
+
+void
+DynamicShortestPaths::increaseWeight(size_t source, Edge e, Distance oldWeight)
+{
+  Row& row = m_rows[source];
+  Vertex u = m_edgeSources[e];
+  Vertex v = m_graph.getTarget(e);
+
+  if (row.distance[u] == GlobalRoutingGraph::INFINITE_DISTANCE ||
+      row.distance[u] + oldWeight != row.distance[v]) {
+    return; // e is not on any shortest path from the source
+  }
+
+  if (++m_markGeneration == 0) {
+    m_marks.assign(m_marks.size(), 0);
+    m_markGeneration = 1;
+  }
+
+  // vertices that have a shortest path through e, i.e., reachable from v over tight edges
+  m_affected.clear();
+  m_marks[v] = m_markGeneration;
+  m_affected.push_back(v);
+  for (size_t i = 0; i < m_affected.size(); i++) {
+    Vertex a = m_affected[i];
+    Edge first, last;
+    std::tie(first, last) = m_graph.getOutEdges(a);
+    for (Edge out = first; out < last; out++) {
+      Vertex b = m_graph.getTarget(out);
+      Distance weight = out == e ? oldWeight : m_graph.getWeight(out);
+      if (weight == GlobalRoutingGraph::INFINITE_DISTANCE || m_marks[b] == m_markGeneration ||
+          b == m_sources[source]) {
+        continue;
+      }
+      if (row.distance[a] + weight == row.distance[b]) {
+        m_marks[b] = m_markGeneration;
+        m_affected.push_back(b);
+      }
+    }
+  }
+
+  for (Vertex a : m_affected) {
+    touch(source, a);
+    row.distance[a] = GlobalRoutingGraph::INFINITE_DISTANCE;
+    row.firstHop[a] = GlobalRoutingGraph::INVALID_EDGE;
+  }
+
+  // re-attach affected vertices to the unaffected part of the tree
+  m_heap.clear();
+  for (Vertex a : m_affected) {
+    for (Edge i = m_inOffsets[a]; i < m_inOffsets[a + 1]; i++) {
+      Edge in = m_inEdges[i];
+      Vertex y = m_edgeSources[in];
+      Distance weight = m_graph.getWeight(in);
+      if (m_marks[y] == m_markGeneration || weight == GlobalRoutingGraph::INFINITE_DISTANCE ||
+          row.distance[y] == GlobalRoutingGraph::INFINITE_DISTANCE) {
+        continue;
+      }
+      if (row.distance[y] + weight < row.distance[a]) {
+        relax(row, a, row.distance[y] + weight, getFirstHopVia(row, y, in));
+      }
+    }
+  }
+
+  settle(source, true);
+}
+
+void
+DynamicShortestPaths::decreaseWeight(size_t source, Edge e)
+{
+  Row& row = m_rows[source];
+  Vertex u = m_edgeSources[e];
+  Vertex v = m_graph.getTarget(e);
+
+  if (row.distance[u] == GlobalRoutingGraph::INFINITE_DISTANCE)
+    return;
+
+  Distance distance = row.distance[u] + m_graph.getWeight(e);
+  if (distance >= row.distance[v])
+    return; // no path gets shorter
+
+  m_heap.clear();
+  touch(source, v);
+  relax(row, v, distance, getFirstHopVia(row, u, e));
+  settle(source, false);
+}
+
+DynamicShortestPaths::Edge
+DynamicShortestPaths::getFirstHopVia(const Row& row, Vertex u, Edge e) const
+{
+  Edge firstHop = row.firstHop[u];
+  return (firstHop != GlobalRoutingGraph::INVALID_EDGE && m_graph.getFace(firstHop) != nullptr)
+           ? firstHop : e;
+}
+
+void
+DynamicShortestPaths::touch(size_t source, Vertex v)
+{
+  const Row& row = m_rows[source];
+  uint64_t key = (static_cast<uint64_t>(source) << 32) | v;
+  m_changes.emplace(key, Change{source, v, row.distance[v], row.firstHop[v]});
+}
+
+void
+DynamicShortestPaths::relax(Row& row, Vertex v, Distance distance, Edge firstHop)
+{
+  row.distance[v] = distance;
+  row.firstHop[v] = firstHop;
+
+  m_heap.emplace_back(distance, v);
+  std::push_heap(m_heap.begin(), m_heap.end(), std::greater<std::pair<Distance, Vertex>>());
+}
+
+void
+DynamicShortestPaths::settle(size_t source, bool isRestricted)
+{
+  typedef std::pair<Distance, Vertex> HeapEntry;
+  Row& row = m_rows[source];
+
+  while (!m_heap.empty()) {
+    std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<HeapEntry>());
+    Distance distance = m_heap.back().first;
+    Vertex a = m_heap.back().second;
+    m_heap.pop_back();
+
+    if (distance > row.distance[a])
+      continue; // stale entry
+
+    Edge first, last;
+    std::tie(first, last) = m_graph.getOutEdges(a);
+    for (Edge out = first; out < last; out++) {
+      Vertex b = m_graph.getTarget(out);
+      Distance weight = m_graph.getWeight(out);
+      if (weight == GlobalRoutingGraph::INFINITE_DISTANCE ||
+          (isRestricted && m_marks[b] != m_markGeneration)) {
+        continue;
+      }
+      if (distance + weight < row.distance[b]) {
+        // affected vertices were touched already, see increaseWeight
+        if (!isRestricted) {
+          touch(source, b);
+        }
+        relax(row, b, distance + weight, getFirstHopVia(row, a, out));
+      }
+    }
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_DYNAMIC_SHORTEST_PATHS_H
+#define NDN_DYNAMIC_SHORTEST_PATHS_H
+
+#include "ns3/ndnSIM/helper/ndn-global-routing-graph.hpp"
+
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Shortest paths from a set of sources that are kept up to date when edge weights change
+ *
+ * After a weight change only the affected part of each source's shortest path tree is
+ * recomputed: on an increase (e.g., link failure) the vertices that had a shortest path
+ * through the edge are re-attached to the unaffected part of the tree and settled with a
+ * Dijkstra restricted to them; on a decrease (e.g., link recovery) Dijkstra is resumed from the
+ * edge's target only as far as distances improve.
+ *
+ * Among equal-cost paths, the first hop kept for a vertex may differ from the one a full
+ * recomputation would select, but it is always the first hop of a shortest path.
+ */
+class DynamicShortestPaths {
+public:
+  typedef GlobalRoutingGraph::Vertex Vertex;
+  typedef GlobalRoutingGraph::Edge Edge;
+  typedef GlobalRoutingGraph::Distance Distance;
+
+  /**
+   * @brief Distance or first hop change of a vertex, as seen from one source
+   *
+   * The new values are available from getDistances() and getFirstHops().
+   */
+  struct Change {
+    size_t source;
+    Vertex target;
+    Distance oldDistance;
+    Edge oldFirstHop;
+  };
+
+  /**
+   * @param graph   topology snapshot (copied; weights are changed only through setWeights)
+   * @param sources source vertices; shortest paths of source i are set by calculate(i)
+   */
+  DynamicShortestPaths(const GlobalRoutingGraph& graph, std::vector<Vertex> sources);
+
+  const GlobalRoutingGraph&
+  getGraph() const
+  {
+    return m_graph;
+  }
+
+  size_t
+  getNSources() const
+  {
+    return m_sources.size();
+  }
+
+  Vertex
+  getSource(size_t source) const
+  {
+    return m_sources[source];
+  }
+
+  const std::vector<Distance>&
+  getDistances(size_t source) const
+  {
+    return m_rows[source].distance;
+  }
+
+  const std::vector<Edge>&
+  getFirstHops(size_t source) const
+  {
+    return m_rows[source].firstHop;
+  }
+
+  /**
+   * @brief Calculate shortest paths of @p source from scratch
+   *
+   * The result is also left in @p workspace.  Different sources can be calculated
+   * concurrently, each with its own workspace.
+   */
+  void
+  calculate(size_t source, GlobalRoutingGraph::ShortestPaths& workspace);
+
+  /**
+   * @brief Change weights of edges and update shortest paths of all sources
+   *
+   * @param weights pairs of edge and its new weight (INFINITE_DISTANCE if the edge is down)
+   * @return vertices whose distance or first hop has changed, ordered by source and target
+   */
+  std::vector<Change>
+  setWeights(const std::vector<std::pair<Edge, Distance>>& weights);
+
+private:
+  struct Row {
+    std::vector<Distance> distance;
+    std::vector<Edge> firstHop;
+  };
+
+  void
+  increaseWeight(size_t source, Edge e, Distance oldWeight);
+
+  void
+  decreaseWeight(size_t source, Edge e);
+
+  /**
+   * @brief First hop of the path to @p u extended by @p e, same as in
+   *        GlobalRoutingGraph::calculateShortestPaths
+   */
+  Edge
+  getFirstHopVia(const Row& row, Vertex u, Edge e) const;
+
+  /**
+   * @brief Remember distance and first hop of @p v before its first change
+   */
+  void
+  touch(size_t source, Vertex v);
+
+  void
+  relax(Row& row, Vertex v, Distance distance, Edge firstHop);
+
+  void
+  settle(size_t source, bool isRestricted);
+
+private:
+  GlobalRoutingGraph m_graph;
+  std::vector<Vertex> m_sources;
+  std::vector<Row> m_rows;
+
+  // in-edges in CSR form
+  std::vector<Vertex> m_edgeSources;
+  std::vector<Edge> m_inOffsets;
+  std::vector<Edge> m_inEdges;
+
+  // workspace of setWeights
+  std::vector<uint32_t> m_marks;
+  uint32_t m_markGeneration;
+  std::vector<Vertex> m_affected;
+  std::vector<std::pair<Distance, Vertex>> m_heap;
+  std::unordered_map<uint64_t, Change> m_changes;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_DYNAMIC_SHORTEST_PATHS_H
@@ -39,6 +39,8 @@
 #include "ns3/data-rate.h"
 
 #include "daemon/mgmt/fib-manager.hpp"
+#include "daemon/fw/forwarder.hpp"
+#include "daemon/table/fib.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 
@@ -47,6 +49,32 @@ namespace ndn {
 
 NS_LOG_COMPONENT_DEFINE("ndn.FibHelper");
 
+bool FibHelper::s_useCommandInterests = false;
+
+void
+FibHelper::SetUseCommandInterests(bool value)
+{
+  s_useCommandInterests = value;
+}
+
+bool
+FibHelper::IsUsingCommandInterests()
+{
+  return s_useCommandInterests;
+}
+
+bool
+FibHelper::UsesCommandInterests(Ptr<Node> node)
+{
+  if (!s_useCommandInterests) {
+    return false;
+  }
+
+  // forwarding-only nodes have no management to process commands
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  return l3protocol == nullptr || !l3protocol->isForwardingOnly();
+}
+
 void
 FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
@@ -81,12 +109,75 @@ FibHelper::RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node)
   l3protocol->injectInterest(*command);
 }
 
+void
+FibHelper::AddNextHopDirect(Ptr<Node> node, const Name& prefix, Face& face, int32_t metric)
+{
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(l3protocol != 0, "Ndn stack should be installed on the node");
+  NS_ASSERT_MSG(prefix.size() <= nfd::fib::Fib::getMaxDepth(),
+                "Prefix " << prefix << " exceeds maximum FIB depth");
+
+  nfd::fib::Fib& fib = l3protocol->getForwarder()->getFib();
+  nfd::fib::Entry* entry = fib.insert(prefix).first;
+  fib.addOrUpdateNextHop(*entry, face, static_cast<uint64_t>(metric));
+}
+
+void
+FibHelper::RemoveNextHopDirect(Ptr<Node> node, const Name& prefix, const Face& face)
+{
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(l3protocol != 0, "Ndn stack should be installed on the node");
+
+  nfd::fib::Fib& fib = l3protocol->getForwarder()->getFib();
+  nfd::fib::Entry* entry = fib.findExactMatch(prefix);
+  if (entry == nullptr) {
+    return;
+  }
+  fib.removeNextHop(*entry, face);
+
+  // entry could have been erased by removeNextHop, look it up again
+  entry = fib.findExactMatch(prefix);
+  if (entry != nullptr && !entry->hasNextHops()) {
+    fib.erase(*entry);
+  }
+}
+
+void
+FibHelper::AddRoutes(Ptr<Node> node, const std::vector<RouteSpec>& routes)
+{
+  if (UsesCommandInterests(node)) {
+    for (const auto& route : routes) {
+      AddRoute(node, route.prefix, route.face, route.metric);
+    }
+    return;
+  }
+
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(l3protocol != 0, "Ndn stack should be installed on the node");
+
+  nfd::fib::Fib& fib = l3protocol->getForwarder()->getFib();
+  for (const auto& route : routes) {
+    NS_LOG_LOGIC("[" << node->GetId() << "]$ route add " << route.prefix << " via "
+                     << route.face->getLocalUri() << " metric " << route.metric);
+    NS_ASSERT_MSG(route.prefix.size() <= nfd::fib::Fib::getMaxDepth(),
+                  "Prefix " << route.prefix << " exceeds maximum FIB depth");
+
+    nfd::fib::Entry* entry = fib.insert(route.prefix).first;
+    fib.addOrUpdateNextHop(*entry, *route.face, static_cast<uint64_t>(route.metric));
+  }
+}
+
 void
 FibHelper::AddRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face, int32_t metric)
 {
   NS_LOG_LOGIC("[" << node->GetId() << "]$ route add " << prefix << " via " << face->getLocalUri()
                    << " metric " << metric);
 
+  if (!UsesCommandInterests(node)) {
+    AddNextHopDirect(node, prefix, *face, metric);
+    return;
+  }
+
   ControlParameters parameters;
   parameters.setName(prefix);
   parameters.setFaceId(face->getId());
@@ -174,10 +265,10 @@ FibHelper::RemoveRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face
 {
   NS_LOG_LOGIC("[" << node->GetId() << "]$ route del " << prefix << " via " << face->getLocalUri());
 
-  // Get L3Protocol object
-  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol>();
-  // Get the forwarder instance
-  shared_ptr<nfd::Forwarder> m_forwarder = L3protocol->getForwarder();
+  if (!UsesCommandInterests(node)) {
+    RemoveNextHopDirect(node, prefix, *face);
+    return;
+  }
 
   ControlParameters parameters;
   parameters.setName(prefix);
@@ -28,6 +28,8 @@
 
 #include <ndn-cxx/mgmt/nfd/control-parameters.hpp>
 
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 
@@ -37,12 +39,52 @@ using ::ndn::nfd::ControlParameters;
  * @ingroup ndn-helpers
  * @brief Forwarding Information Base (FIB) helper
  *
- * The FIB helper interacts with the FIB manager of NFD by sending special Interest
- * commands to the manager in order to add/remove a next hop from FIB entries or add
- * routes to the FIB manually (manual configuration of FIB).
+ * By default, the FIB helper writes next hops directly into the FIB of the node's
+ * forwarder.  Alternatively (see SetUseCommandInterests), it can interact with the FIB
+ * manager of NFD by sending special Interest commands to the manager in order to
+ * add/remove a next hop from FIB entries.
  */
 class FibHelper {
 public:
+  /**
+   * \brief Single route for the bulk AddRoutes call
+   */
+  struct RouteSpec
+  {
+    Name prefix;
+    shared_ptr<Face> face;
+    int32_t metric;
+  };
+
+  /**
+   * \brief Select how routes are installed
+   *
+   * \param value If true, every route change is wire-encoded into a signed
+   *              `/localhost/nfd/fib/{add,remove}-nexthop` command Interest and processed
+   *              by NFD's FibManager (the changes become effective once the simulator
+   *              processes the command).  If false (default), next hops are written into
+   *              the forwarder's FIB immediately.
+   */
+  static void
+  SetUseCommandInterests(bool value);
+
+  /**
+   * \brief Check whether routes are installed via management command Interests
+   */
+  static bool
+  IsUsingCommandInterests();
+
+  /**
+   * \brief Add a batch of forwarding entries to the FIB of a node
+   *
+   * In direct mode, the forwarder's FIB is looked up only once for the whole batch.
+   *
+   * \param node   Node
+   * \param routes Routes to add
+   */
+  static void
+  AddRoutes(Ptr<Node> node, const std::vector<RouteSpec>& routes);
+
   /**
    * \brief Add forwarding entry to FIB
    *
@@ -159,6 +201,18 @@ private:
 
   static void
   RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node);
+
+  static void
+  AddNextHopDirect(Ptr<Node> node, const Name& prefix, Face& face, int32_t metric);
+
+  static bool
+  UsesCommandInterests(Ptr<Node> node);
+
+  static void
+  RemoveNextHopDirect(Ptr<Node> node, const Name& prefix, const Face& face);
+
+private:
+  static bool s_useCommandInterests;
 };
 
 } // namespace ndn
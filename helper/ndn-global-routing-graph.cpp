@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-global-routing-graph.hpp"
+
+#include "model/ndn-global-router.hpp"
+
+#include "ns3/node-list.h"
+#include "ns3/channel-list.h"
+#include "ns3/channel.h"
+#include "ns3/node.h"
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace ns3 {
+namespace ndn {
+
+const GlobalRoutingGraph::Vertex GlobalRoutingGraph::INVALID_VERTEX;
+const GlobalRoutingGraph::Edge GlobalRoutingGraph::INVALID_EDGE;
+const GlobalRoutingGraph::Distance GlobalRoutingGraph::INFINITE_DISTANCE;
+
+GlobalRoutingGraph::GlobalRoutingGraph()
+{
+  // same vertex set as boost::NdnGlobalRouterGraph
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter>();
+    if (gr != nullptr)
+      m_routers.push_back(gr);
+  }
+  for (ChannelList::Iterator channel = ChannelList::Begin(); channel != ChannelList::End();
+       channel++) {
+    Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter>();
+    if (gr != nullptr)
+      m_routers.push_back(gr);
+  }
+
+  for (Vertex v = 0; v < m_routers.size(); v++) {
+    uint32_t id = m_routers[v]->GetId();
+    if (id >= m_vertexById.size()) {
+      m_vertexById.resize(id + 1, INVALID_VERTEX);
+    }
+    m_vertexById[id] = v;
+  }
+
+  m_offsets.reserve(m_routers.size() + 1);
+  for (const auto& router : m_routers) {
+    m_offsets.push_back(m_targets.size());
+
+    for (const auto& incidency : router->GetIncidencies()) {
+      Vertex target = getVertex(std::get<2>(incidency));
+      if (target == INVALID_VERTEX)
+        continue;
+
+      const shared_ptr<Face>& face = std::get<1>(incidency);
+      m_targets.push_back(target);
+      // edges without face (channel to node) have zero weight, see boost::EdgeWeights
+      m_weights.push_back(face == nullptr ? 0 : static_cast<uint16_t>(face->getMetric()));
+      m_faces.push_back(face);
+    }
+  }
+  m_offsets.push_back(m_targets.size());
+}
+
+GlobalRoutingGraph::Vertex
+GlobalRoutingGraph::getVertex(const Ptr<GlobalRouter>& router) const
+{
+  uint32_t id = router->GetId();
+  if (id >= m_vertexById.size() || m_vertexById[id] == INVALID_VERTEX ||
+      m_routers[m_vertexById[id]] != router) {
+    return INVALID_VERTEX;
+  }
+  return m_vertexById[id];
+}
+
+void
+GlobalRoutingGraph::calculateShortestPaths(Vertex source, ShortestPaths& result) const
+{
+  doCalculateShortestPaths(source, result, nullptr);
+}
+
+void
+GlobalRoutingGraph::calculateShortestPaths(Vertex source, ShortestPaths& result,
+                                           const WeightOverlay& overlay) const
+{
+  NS_ASSERT(overlay.vertex < m_routers.size());
+  NS_ASSERT(overlay.weights.size() == m_offsets[overlay.vertex + 1] - m_offsets[overlay.vertex]);
+
+  doCalculateShortestPaths(source, result, &overlay);
+}
+
+void
+GlobalRoutingGraph::doCalculateShortestPaths(Vertex source, ShortestPaths& result,
+                                             const WeightOverlay* overlay) const
+{
+  typedef std::pair<Distance, Vertex> HeapEntry;
+
+  result.distance.assign(m_routers.size(), INFINITE_DISTANCE);
+  result.firstHop.assign(m_routers.size(), INVALID_EDGE);
+
+  auto& heap = result.heap;
+  heap.clear();
+
+  result.distance[source] = 0;
+  heap.emplace_back(0, source);
+
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+    Distance distance = heap.back().first;
+    Vertex u = heap.back().second;
+    heap.pop_back();
+
+    if (distance > result.distance[u])
+      continue; // stale entry
+
+    const Distance* weights = m_weights.data() + m_offsets[u];
+    if (overlay != nullptr && overlay->vertex == u) {
+      weights = overlay->weights.data();
+    }
+
+    Edge uFirstHop = result.firstHop[u];
+    for (Edge e = m_offsets[u]; e < m_offsets[u + 1]; e++) {
+      Distance weight = weights[e - m_offsets[u]];
+      if (weight == INFINITE_DISTANCE)
+        continue; // edge is down
+
+      Vertex v = m_targets[e];
+      Distance newDistance = distance + weight;
+      if (newDistance < result.distance[v]) {
+        result.distance[v] = newDistance;
+        // the first hop is the first edge on the path that has a face
+        result.firstHop[v] =
+          (uFirstHop != INVALID_EDGE && m_faces[uFirstHop] != nullptr) ? uFirstHop : e;
+
+        heap.emplace_back(newDistance, v);
+        std::push_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+      }
+    }
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
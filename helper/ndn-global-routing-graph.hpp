@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_GLOBAL_ROUTING_GRAPH_H
+#define NDN_GLOBAL_ROUTING_GRAPH_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class GlobalRouter;
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Compact snapshot of the topology formed by GlobalRouter objects
+ *
+ * Vertices (GlobalRouters of nodes and channels) are numbered 0..N-1 and edges are stored in
+ * compressed sparse row (CSR) form: out-edges of vertex v are edges offset(v)..offset(v+1)-1,
+ * each with target vertex, weight (face metric at the time of the snapshot), and face.  This
+ * allows shortest path computation without touching Ptr<GlobalRouter>, face objects, or maps.
+ *
+ * Distances are 32-bit sums of 16-bit face metrics.  Only INFINITE_DISTANCE marks unreachable
+ * vertices and down edges: unlike the former Boost-based calculation, which used 65535
+ * (boost::WeightInf) as infinity, paths that cost 65535 or more are reachable.
+ */
+class GlobalRoutingGraph {
+public:
+  typedef uint32_t Vertex;
+  typedef uint32_t Edge;
+  typedef uint32_t Distance;
+
+  static const Vertex INVALID_VERTEX = std::numeric_limits<Vertex>::max();
+  static const Edge INVALID_EDGE = std::numeric_limits<Edge>::max();
+  static const Distance INFINITE_DISTANCE = std::numeric_limits<Distance>::max();
+
+  /**
+   * @brief Result of single-source shortest path computation
+   */
+  struct ShortestPaths {
+    /// distance from the source to each vertex, INFINITE_DISTANCE if unreachable
+    std::vector<Distance> distance;
+    /// source's out-edge on the shortest path to each vertex, INVALID_EDGE for the source
+    /// itself and unreachable vertices
+    std::vector<Edge> firstHop;
+
+    /// workspace: binary heap of (distance, vertex) with lazy deletion
+    std::vector<std::pair<Distance, Vertex>> heap;
+  };
+
+  /**
+   * @brief Replacement weights for the out-edges of one vertex
+   *
+   * Used to evaluate paths with some faces disabled or re-weighted (e.g., by
+   * CalculateAllPossibleRoutes and CalculateLfidRoutes) without changing face metrics, so
+   * that several overlays can be evaluated concurrently on the same snapshot.
+   */
+  struct WeightOverlay {
+    Vertex vertex;
+    /// weights of edges getOutEdges(vertex).first, ..., getOutEdges(vertex).second - 1
+    std::vector<Distance> weights;
+  };
+
+  /**
+   * @brief Take snapshot of all GlobalRouters on nodes and channels
+   */
+  GlobalRoutingGraph();
+
+  size_t
+  getNVertices() const
+  {
+    return m_routers.size();
+  }
+
+  size_t
+  getNEdges() const
+  {
+    return m_targets.size();
+  }
+
+  const Ptr<GlobalRouter>&
+  getRouter(Vertex v) const
+  {
+    return m_routers[v];
+  }
+
+  /**
+   * @brief Get vertex of @p router, INVALID_VERTEX if not part of the snapshot
+   */
+  Vertex
+  getVertex(const Ptr<GlobalRouter>& router) const;
+
+  /**
+   * @brief Get range [first, last) of out-edges of @p v
+   */
+  std::pair<Edge, Edge>
+  getOutEdges(Vertex v) const
+  {
+    return {m_offsets[v], m_offsets[v + 1]};
+  }
+
+  Vertex
+  getTarget(Edge e) const
+  {
+    return m_targets[e];
+  }
+
+  Distance
+  getWeight(Edge e) const
+  {
+    return m_weights[e];
+  }
+
+  /**
+   * @brief Change weight of @p e
+   *
+   * Edges with weight INFINITE_DISTANCE (e.g., of failed links) are not part of any path.
+   */
+  void
+  setWeight(Edge e, Distance weight)
+  {
+    m_weights[e] = weight;
+  }
+
+  const shared_ptr<Face>&
+  getFace(Edge e) const
+  {
+    return m_faces[e];
+  }
+
+  /**
+   * @brief Calculate shortest paths from @p source using Dijkstra's algorithm
+   *
+   * Paths are compared by the sum of face metrics, as done by GlobalRoutingHelper.  The vectors
+   * of @p result are reused, so the same object should be passed for consecutive sources.  The
+   * graph is not modified, so different threads can compute paths using their own @p result.
+   */
+  void
+  calculateShortestPaths(Vertex source, ShortestPaths& result) const;
+
+  /**
+   * @brief Calculate shortest paths from @p source, with weights of out-edges of
+   *        `overlay.vertex` taken from @p overlay
+   */
+  void
+  calculateShortestPaths(Vertex source, ShortestPaths& result,
+                         const WeightOverlay& overlay) const;
+
+private:
+  void
+  doCalculateShortestPaths(Vertex source, ShortestPaths& result,
+                           const WeightOverlay* overlay) const;
+
+private:
+  std::vector<Ptr<GlobalRouter>> m_routers;
+  std::vector<Edge> m_offsets;
+  std::vector<Vertex> m_targets;
+  std::vector<Distance> m_weights;
+  std::vector<shared_ptr<Face>> m_faces;
+
+  std::vector<Vertex> m_vertexById; ///< @brief GlobalRouter::GetId() to vertex
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_GLOBAL_ROUTING_GRAPH_H
@@ -29,6 +29,8 @@
 #include "helper/ndn-fib-helper.hpp"
 #include "model/ndn-net-device-transport.hpp"
 #include "model/ndn-global-router.hpp"
+#include "helper/ndn-global-routing-graph.hpp"
+#include "helper/ndn-dynamic-shortest-paths.hpp"
 
 #include "daemon/table/fib.hpp"
 #include "daemon/fw/forwarder.hpp"
@@ -46,23 +48,113 @@
 #include "ns3/node-list.h"
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
-
-#include <boost/lexical_cast.hpp>
-#include <boost/foreach.hpp>
-#include <boost/concept/assert.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
-
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <map>
+#include <set>
+#include <thread>
 #include <unordered_map>
 
-#include "boost-graph-ndn-global-routing-helper.hpp"
-
-#include <math.h>
-
 NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelper");
 
 namespace ns3 {
 namespace ndn {
 
+/**
+ * @brief Shortest paths kept by CalculateRoutes for incremental updates
+ */
+struct GlobalRoutingHelper::IncrementalRoutingState {
+  IncrementalRoutingState(const GlobalRoutingGraph& graph,
+                          const std::vector<GlobalRoutingGraph::Vertex>& sources)
+    : paths(graph, sources)
+  {
+  }
+
+  DynamicShortestPaths paths;
+  /// node id of each source
+  std::vector<uint32_t> nodeIds;
+  /// whether a vertex has local prefixes
+  std::vector<bool> isOrigin;
+  /// prefix -> vertices that announce it, in the order CalculateRoutes installed their routes
+  std::map<Name, std::vector<GlobalRoutingGraph::Vertex>> prefixOrigins;
+  /// channel id -> edges over the channel, with their weights while the link is up
+  std::unordered_map<uint32_t,
+                     std::vector<std::pair<GlobalRoutingGraph::Edge,
+                                           GlobalRoutingGraph::Distance>>> channelEdges;
+};
+
+uint32_t GlobalRoutingHelper::s_nThreads = 1;
+bool GlobalRoutingHelper::s_isIncrementalRouting = false;
+std::unique_ptr<GlobalRoutingHelper::IncrementalRoutingState>
+  GlobalRoutingHelper::s_incrementalRoutingState;
+
+namespace {
+
+/**
+ * @brief Route of a source node to an origin vertex, computed by a worker thread
+ */
+struct Route {
+  GlobalRoutingGraph::Vertex origin;
+  GlobalRoutingGraph::Edge firstHop;
+  GlobalRoutingGraph::Distance distance;
+};
+
+void
+getSources(const GlobalRoutingGraph& graph, std::vector<Ptr<Node>>& nodes,
+           std::vector<GlobalRoutingGraph::Vertex>& sources)
+{
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
+    if (source == 0) {
+      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
+      continue;
+    }
+    nodes.push_back(*node);
+    sources.push_back(graph.getVertex(source));
+  }
+}
+
+/**
+ * @brief Get vertices that have local prefixes
+ */
+std::vector<GlobalRoutingGraph::Vertex>
+getOrigins(const GlobalRoutingGraph& graph)
+{
+  std::vector<GlobalRoutingGraph::Vertex> origins;
+  for (GlobalRoutingGraph::Vertex v = 0; v < graph.getNVertices(); v++) {
+    if (!graph.getRouter(v)->GetLocalPrefixes().empty()) {
+      origins.push_back(v);
+    }
+  }
+  return origins;
+}
+
+/**
+ * @brief Install @p routes on @p node and release them
+ */
+void
+installRoutes(const GlobalRoutingGraph& graph, Ptr<Node> node, std::vector<Route>& routes)
+{
+  std::vector<FibHelper::RouteSpec> specs;
+  for (const auto& route : routes) {
+    const shared_ptr<Face>& face = graph.getFace(route.firstHop);
+    for (const auto& prefix : graph.getRouter(route.origin)->GetLocalPrefixes()) {
+      NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face " << *face
+                   << " with distance " << route.distance);
+
+      specs.push_back({*prefix, face, static_cast<int32_t>(route.distance)});
+    }
+  }
+  FibHelper::AddRoutes(node, specs);
+
+  std::vector<Route>().swap(routes);
+}
+
+} // namespace
+
 void
 GlobalRoutingHelper::Install(Ptr<Node> node)
 {
@@ -217,171 +309,318 @@ GlobalRoutingHelper::AddOriginsForAll()
 void
 GlobalRoutingHelper::CalculateRoutes()
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
+  // Snapshot of the topology in compact (CSR) form, so Dijkstra for every node works on integer
+  // arrays instead of Ptr<GlobalRouter> lists and maps
+  GlobalRoutingGraph graph;
+
+  std::vector<Ptr<Node>> nodes;
+  std::vector<GlobalRoutingGraph::Vertex> sources;
+  getSources(graph, nodes, sources);
+  std::vector<GlobalRoutingGraph::Vertex> origins = getOrigins(graph);
+
+  // paths of all sources are kept for UpdateLinkState
+  std::unique_ptr<IncrementalRoutingState> state;
+  if (s_isIncrementalRouting) {
+    state = make_unique<IncrementalRoutingState>(graph, sources);
+  }
 
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+  std::vector<GlobalRoutingGraph::ShortestPaths> workspace(GetNumberOfThreads());
+  std::vector<std::vector<Route>> results(sources.size());
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  ProcessSources(sources.size(),
+    [&] (size_t i, size_t thread) {
+      auto& paths = workspace[thread];
+      if (state != nullptr) {
+        state->paths.calculate(i, paths);
+      }
+      else {
+        graph.calculateShortestPaths(sources[i], paths);
+      }
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
-      continue;
+      for (GlobalRoutingGraph::Vertex v : origins) {
+        GlobalRoutingGraph::Edge firstHop = paths.firstHop[v];
+        if (v == sources[i] || firstHop == GlobalRoutingGraph::INVALID_EDGE ||
+            graph.getFace(firstHop) == nullptr) {
+          continue;
+        }
+        results[i].push_back({v, firstHop, paths.distance[v]});
+      }
+    },
+    [&] (size_t i) {
+      NS_LOG_DEBUG("Reachability from Node: " << nodes[i]->GetId());
+      installRoutes(graph, nodes[i], results[i]);
+    });
+
+  if (state != nullptr) {
+    for (const auto& node : nodes) {
+      state->nodeIds.push_back(node->GetId());
+    }
+    state->isOrigin.resize(graph.getNVertices(), false);
+    for (GlobalRoutingGraph::Vertex v : origins) {
+      state->isOrigin[v] = true;
+      for (const auto& prefix : graph.getRouter(v)->GetLocalPrefixes()) {
+        state->prefixOrigins[*prefix].push_back(v);
+      }
+    }
+    for (GlobalRoutingGraph::Edge e = 0; e < graph.getNEdges(); e++) {
+      auto transport = graph.getFace(e) == nullptr ? nullptr :
+                         dynamic_cast<NetDeviceTransport*>(graph.getFace(e)->getTransport());
+      if (transport != nullptr && transport->GetNetDevice()->GetChannel() != nullptr) {
+        uint32_t channelId = transport->GetNetDevice()->GetChannel()->GetId();
+        state->channelEdges[channelId].emplace_back(e, graph.getWeight(e));
+      }
     }
 
-    boost::DistancesMap distances;
-
-    dijkstra_shortest_paths(graph, source,
-                            // predecessor_map (boost::ref(predecessors))
-                            // .
-                            distance_map(boost::ref(distances))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
-
-    // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+    // the state refers to faces, so it must not outlive the simulation
+    Simulator::ScheduleDestroy(&GlobalRoutingHelper::ResetIncrementalRoutingState);
+  }
+  s_incrementalRoutingState = std::move(state);
+}
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+void
+GlobalRoutingHelper::CalculateAllPossibleRoutes()
+{
+  GlobalRoutingGraph graph;
+
+  std::vector<Ptr<Node>> nodes;
+  std::vector<GlobalRoutingGraph::Vertex> sources;
+  getSources(graph, nodes, sources);
+  std::vector<GlobalRoutingGraph::Vertex> origins = getOrigins(graph);
+
+  // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
+  const GlobalRoutingGraph::Distance disabledWeight = std::numeric_limits<uint16_t>::max() - 1;
+
+  struct WorkerState {
+    GlobalRoutingGraph::ShortestPaths paths;
+    GlobalRoutingGraph::WeightOverlay overlay;
+  };
+  std::vector<WorkerState> workspace(GetNumberOfThreads());
+  std::vector<std::vector<Route>> results(sources.size());
+
+  // Instead of temporarily setting metrics of all but one face of the source to max-1, the
+  // same weights are applied as an overlay on the snapshot, one overlay per face
+  ProcessSources(sources.size(),
+    [&] (size_t i, size_t thread) {
+      auto& state = workspace[thread];
+      GlobalRoutingGraph::Edge first, last;
+      std::tie(first, last) = graph.getOutEdges(sources[i]);
+
+      state.overlay.vertex = sources[i];
+      for (GlobalRoutingGraph::Edge enabled = first; enabled < last; enabled++) {
+        const Face* face = graph.getFace(enabled).get();
+        if (face == nullptr) {
+          continue;
+        }
+        // each face only once, even if it leads to several vertices
+        bool isSeen = false;
+        for (GlobalRoutingGraph::Edge e = first; e < enabled; e++) {
+          isSeen = isSeen || graph.getFace(e).get() == face;
+        }
+        if (isSeen) {
+          continue;
+        }
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
-    for (const auto& dist : distances) {
-      if (dist.first == source)
-        continue;
-      else {
-        // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-        if (std::get<0>(dist.second) == 0) {
-          // cout << " is unreachable" << endl;
+        state.overlay.weights.clear();
+        for (GlobalRoutingGraph::Edge e = first; e < last; e++) {
+          state.overlay.weights.push_back(graph.getFace(e).get() == face ? graph.getWeight(e)
+                                                                         : disabledWeight);
         }
-        else {
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
-                         << " with distance " << std::get<1>(dist.second) << " with delay "
-                         << std::get<2>(dist.second));
+        graph.calculateShortestPaths(sources[i], state.paths, state.overlay);
 
-            FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
+        for (GlobalRoutingGraph::Vertex v : origins) {
+          GlobalRoutingGraph::Edge firstHop = state.paths.firstHop[v];
+          if (v == sources[i] || firstHop == GlobalRoutingGraph::INVALID_EDGE ||
+              graph.getFace(firstHop).get() != face) {
+            continue;
           }
+          results[i].push_back({v, firstHop, state.paths.distance[v]});
         }
       }
-    }
+    },
+    [&] (size_t i) {
+      NS_LOG_DEBUG("Reachability from Node: " << nodes[i]->GetId() << " ("
+                                              << Names::FindName(nodes[i]) << ")");
+      installRoutes(graph, nodes[i], results[i]);
+    });
+}
+
+void
+GlobalRoutingHelper::SetIncrementalRouting(bool isEnabled)
+{
+  s_isIncrementalRouting = isEnabled;
+  if (!isEnabled) {
+    ResetIncrementalRoutingState();
   }
 }
 
 void
-GlobalRoutingHelper::CalculateAllPossibleRoutes()
+GlobalRoutingHelper::ResetIncrementalRoutingState()
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
+  s_incrementalRoutingState.reset();
+}
 
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+size_t
+GlobalRoutingHelper::UpdateLinkState(Ptr<Channel> channel, bool isUp)
+{
+  if (s_incrementalRoutingState == nullptr) {
+    return 0;
+  }
+  IncrementalRoutingState& state = *s_incrementalRoutingState;
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  auto edges = state.channelEdges.find(channel->GetId());
+  if (edges == state.channelEdges.end()) {
+    return 0;
+  }
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
-      continue;
+  std::vector<std::pair<GlobalRoutingGraph::Edge, GlobalRoutingGraph::Distance>> weights;
+  for (const auto& edge : edges->second) {
+    weights.emplace_back(edge.first, isUp ? edge.second : GlobalRoutingGraph::INFINITE_DISTANCE);
+  }
+  std::vector<DynamicShortestPaths::Change> changes = state.paths.setWeights(weights);
+
+  const GlobalRoutingGraph& graph = state.paths.getGraph();
+  auto getFace = [&graph] (GlobalRoutingGraph::Edge e) {
+    return e == GlobalRoutingGraph::INVALID_EDGE ? nullptr : graph.getFace(e);
+  };
+
+  using NextHops = std::vector<std::pair<shared_ptr<Face>, GlobalRoutingGraph::Distance>>;
+
+  // changes are ordered by source, so routes to add can be installed per node in bulk
+  size_t nFibChanges = 0;
+  for (auto change = changes.begin(); change != changes.end();) {
+    size_t source = change->source;
+    Ptr<Node> node = NodeList::GetNode(state.nodeIds[source]);
+    const auto& distances = state.paths.getDistances(source);
+    const auto& firstHops = state.paths.getFirstHops(source);
+
+    // paths to the changed origins before the change
+    std::unordered_map<GlobalRoutingGraph::Vertex, const DynamicShortestPaths::Change*> oldPaths;
+    std::vector<const Name*> prefixes;
+    for (; change != changes.end() && change->source == source; change++) {
+      if (!state.isOrigin[change->target]) {
+        continue;
+      }
+      oldPaths[change->target] = &*change;
+      for (const auto& prefix : graph.getRouter(change->target)->GetLocalPrefixes()) {
+        prefixes.push_back(prefix.get());
+      }
     }
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
-
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId() << " ("
-                                            << Names::FindName(source->GetObject<Node>()) << ")");
-
-    Ptr<L3Protocol> l3 = source->GetObject<L3Protocol>();
-    NS_ASSERT(l3 != 0);
-
-    // remember interface statuses
-    std::list<nfd::FaceId> faceIds;
-    std::unordered_map<nfd::FaceId, uint16_t> originalMetrics;
-    for (auto& nfdFace : l3->getFaceTable()) {
-      faceIds.push_back(nfdFace.getId());
-      originalMetrics[nfdFace.getId()] = nfdFace.getMetric();
-      nfdFace.setMetric(std::numeric_limits<uint16_t>::max() - 1);
-      // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
-    }
+    // A prefix may be announced by several origins that share next hops, so next hops are
+    // compared over all origins of the prefix.  As in CalculateRoutes, the cost of a face is the
+    // distance to the last origin reached through it.
+    auto getNextHops = [&] (const Name& prefix, bool isOld) {
+      NextHops nextHops;
+      for (GlobalRoutingGraph::Vertex v : state.prefixOrigins.at(prefix)) {
+        if (v == state.paths.getSource(source)) {
+          continue;
+        }
+        GlobalRoutingGraph::Edge firstHop = firstHops[v];
+        GlobalRoutingGraph::Distance distance = distances[v];
+        auto oldPath = oldPaths.find(v);
+        if (isOld && oldPath != oldPaths.end()) {
+          firstHop = oldPath->second->oldFirstHop;
+          distance = oldPath->second->oldDistance;
+        }
+        shared_ptr<Face> face = getFace(firstHop);
+        if (face == nullptr) {
+          continue;
+        }
+        auto nextHop = std::find_if(nextHops.begin(), nextHops.end(),
+                                    [&face] (const NextHops::value_type& hop) {
+                                      return hop.first == face;
+                                    });
+        if (nextHop != nextHops.end()) {
+          nextHop->second = distance;
+        }
+        else {
+          nextHops.emplace_back(face, distance);
+        }
+      }
+      return nextHops;
+    };
 
-    for (auto& faceId : faceIds) {
-      auto* face = l3->getFaceTable().get(faceId);
-      NS_ASSERT(face != nullptr);
-      auto transport = dynamic_cast<NetDeviceTransport*>(face->getTransport());
-      if (transport == nullptr) {
-        NS_LOG_DEBUG("Skipping non ndnSIM-specific transport face");
+    std::vector<FibHelper::RouteSpec> routes;
+    std::set<Name> updatedPrefixes;
+    for (const Name* prefix : prefixes) {
+      if (!updatedPrefixes.insert(*prefix).second) {
         continue;
       }
+      NextHops oldNextHops = getNextHops(*prefix, true);
+      NextHops newNextHops = getNextHops(*prefix, false);
+
+      for (const auto& oldHop : oldNextHops) {
+        if (std::none_of(newNextHops.begin(), newNextHops.end(),
+                         [&oldHop] (const NextHops::value_type& hop) {
+                           return hop.first == oldHop.first;
+                         })) {
+          FibHelper::RemoveRoute(node, *prefix, oldHop.first);
+          nFibChanges++;
+        }
+      }
+      for (const auto& newHop : newNextHops) {
+        if (std::find(oldNextHops.begin(), oldNextHops.end(), newHop) == oldNextHops.end()) {
+          routes.push_back({*prefix, newHop.first, static_cast<int32_t>(newHop.second)});
+          nFibChanges++;
+        }
+      }
+    }
+    FibHelper::AddRoutes(node, routes);
+  }
 
-      // enabling only faceId
-      face->setMetric(originalMetrics[faceId]);
+  NS_LOG_INFO("Channel " << channel->GetId() << (isUp ? " up" : " down") << ": "
+              << changes.size() << " path changes, " << nFibChanges << " FIB changes");
+  return nFibChanges;
+}
 
-      boost::DistancesMap distances;
+void
+GlobalRoutingHelper::SetNumberOfThreads(uint32_t nThreads)
+{
+  s_nThreads = nThreads;
+}
 
-      NS_LOG_DEBUG("-----------");
+uint32_t
+GlobalRoutingHelper::GetNumberOfThreads()
+{
+  if (s_nThreads == 0) {
+    return std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  return s_nThreads;
+}
 
-      dijkstra_shortest_paths(graph, source,
-                              // predecessor_map (boost::ref(predecessors))
-                              // .
-                              distance_map(boost::ref(distances))
-                                .distance_inf(boost::WeightInf)
-                                .distance_zero(boost::WeightZero)
-                                .distance_compare(boost::WeightCompare())
-                                .distance_combine(boost::WeightCombine()));
+void
+GlobalRoutingHelper::ProcessSources(size_t nSources,
+                                    const std::function<void(size_t, size_t)>& compute,
+                                    const std::function<void(size_t)>& commit)
+{
+  const size_t nThreads = GetNumberOfThreads();
+  const size_t chunkSize = 64 * nThreads;
 
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+  for (size_t begin = 0; begin < nSources; begin += chunkSize) {
+    const size_t end = std::min(begin + chunkSize, nSources);
 
-      for (const auto& dist : distances) {
-        if (dist.first == source)
-          continue;
-        else {
-          // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-          if (std::get<0>(dist.second) == 0) {
-            // cout << " is unreachable" << endl;
-          }
-          else {
-            for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-              NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face "
-                           << *std::get<0>(dist.second)
-                           << " with distance " << std::get<1>(dist.second)
-                           << " with delay " << std::get<2>(dist.second));
-
-              if (std::get<0>(dist.second)->getMetric() == std::numeric_limits<uint16_t>::max() - 1)
-                continue;
-
-              FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                  std::get<1>(dist.second));
-            }
+    if (nThreads == 1) {
+      for (size_t i = begin; i < end; i++) {
+        compute(i, 0);
+      }
+    }
+    else {
+      std::atomic<size_t> next(begin);
+      std::vector<std::thread> workers;
+      for (size_t thread = 0; thread < std::min(nThreads, end - begin); thread++) {
+        workers.emplace_back([&, thread] {
+          for (size_t i = next++; i < end; i = next++) {
+            compute(i, thread);
           }
-        }
+        });
+      }
+      for (auto& worker : workers) {
+        worker.join();
       }
-
-      // disabling the face again
-      face->setMetric(std::numeric_limits<uint16_t>::max() - 1);
     }
 
-    // recover original interface statuses
-    for (auto& i : originalMetrics) {
-      l3->getFaceTable().get(i.first)->setMetric(i.second);
+    for (size_t i = begin; i < end; i++) {
+      commit(i);
     }
   }
 }
@@ -24,6 +24,9 @@
 
 #include "ns3/ptr.h"
 
+#include <functional>
+#include <memory>
+
 namespace ns3 {
 
 class Node;
@@ -96,10 +99,41 @@ public:
 
   /**
    * @brief Calculate for every node shortest path trees and install routes to all prefix origins
+   *
+   * Paths are computed on a compact snapshot of the topology (GlobalRoutingGraph) and routes of
+   * each node are installed in bulk with FibHelper::AddRoutes.
    */
   static void
   CalculateRoutes();
 
+  /**
+   * @brief Keep shortest paths calculated by CalculateRoutes, so that routes can be updated
+   *        incrementally after link state changes (default false)
+   *
+   * With incremental routing, LinkControlHelper::FailLink and LinkControlHelper::UpLink update
+   * the routes through UpdateLinkState.  The kept state takes memory quadratic in the number of
+   * nodes and is released by Simulator::Destroy.
+   */
+  static void
+  SetIncrementalRouting(bool isEnabled);
+
+  /**
+   * @brief Update routes calculated by CalculateRoutes after a link went down or up
+   *
+   * Only paths that used the link (when it goes down) or that become shorter (when it comes
+   * up) are recomputed.  Only the changed next hops are installed or removed through
+   * FibHelper; a next hop of a prefix is kept as long as some origin of the prefix is still
+   * reached through it.  As with CalculateRoutes, a manually added route with the same prefix
+   * and face is overwritten or removed.  This call does nothing unless incremental routing is
+   * enabled and CalculateRoutes has been called.
+   *
+   * @param channel channel of the link
+   * @param isUp    new state of the link
+   * @return number of next hops that were added, updated, or removed
+   */
+  static size_t
+  UpdateLinkState(Ptr<Channel> channel, bool isUp);
+
   /**
    * @brief Calculates a set of loop-free multipath routes.
    *
@@ -124,9 +158,49 @@ public:
   static void
   CalculateAllPossibleRoutes();
 
+  /**
+   * @brief Set number of threads used to calculate routes (default 1)
+   *
+   * CalculateRoutes, CalculateAllPossibleRoutes, and CalculateLfidRoutes compute paths of
+   * different source nodes concurrently on an immutable snapshot of the topology.  FIB entries
+   * are installed afterwards from the calling thread in node order, so the resulting FIBs do
+   * not depend on the number of threads.
+   *
+   * @param nThreads number of threads, 0 to use std::thread::hardware_concurrency()
+   */
+  static void
+  SetNumberOfThreads(uint32_t nThreads);
+
+  static uint32_t
+  GetNumberOfThreads();
+
 private:
   void
   Install(Ptr<Channel> channel);
+
+  /**
+   * @brief Run @p compute for sources 0..nSources-1 on worker threads and @p commit for each
+   *        of them on the calling thread
+   *
+   * Sources are processed in chunks: after compute of all sources in a chunk has finished,
+   * commit is called for them in order, so results only need to be kept for one chunk.
+   * @p compute receives the index of the calling thread (0..GetNumberOfThreads()-1) to select
+   * per-thread workspace, and must not touch ns-3 objects (Ptr reference counts are not
+   * thread-safe) or NFD tables.
+   */
+  static void
+  ProcessSources(size_t nSources, const std::function<void(size_t source, size_t thread)>& compute,
+                 const std::function<void(size_t source)>& commit);
+
+  static void
+  ResetIncrementalRoutingState();
+
+private:
+  static uint32_t s_nThreads;
+
+  struct IncrementalRoutingState;
+  static bool s_isIncrementalRouting;
+  static std::unique_ptr<IncrementalRoutingState> s_incrementalRoutingState;
 };
 
 } // namespace ndn
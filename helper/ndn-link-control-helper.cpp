@@ -31,6 +31,7 @@
 #include "ns3/double.h"
 #include "ns3/pointer.h"
 
+#include "helper/ndn-global-routing-helper.hpp"
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-transport.hpp"
 #include "NFD/daemon/face/face.hpp"
@@ -42,7 +43,7 @@ NS_LOG_COMPONENT_DEFINE("ndn.LinkControlHelper");
 namespace ns3 {
 namespace ndn {
 
-void
+Ptr<Channel>
 LinkControlHelper::setErrorRate(Ptr<Node> node1, Ptr<Node> node2, double errorRate)
 {
   NS_LOG_FUNCTION(node1 << node2 << errorRate);
@@ -85,16 +86,18 @@ LinkControlHelper::setErrorRate(Ptr<Node> node1, Ptr<Node> node2, double errorRa
 
       nd1->SetAttribute("ReceiveErrorModel", PointerValue(errorFactory.Create<ErrorModel>()));
       nd2->SetAttribute("ReceiveErrorModel", PointerValue(errorFactory.Create<ErrorModel>()));
-      return;
+      return channel;
     }
   }
   NS_FATAL_ERROR("There is no link to fail between the requested nodes");
+  return nullptr;
 }
 
 void
 LinkControlHelper::FailLink(Ptr<Node> node1, Ptr<Node> node2)
 {
-  setErrorRate(node1, node2, 1.0);
+  Ptr<Channel> channel = setErrorRate(node1, node2, 1.0);
+  GlobalRoutingHelper::UpdateLinkState(channel, false);
 }
 
 void
@@ -106,7 +109,8 @@ LinkControlHelper::FailLinkByName(const std::string& node1, const std::string& n
 void
 LinkControlHelper::UpLink(Ptr<Node> node1, Ptr<Node> node2)
 {
-  setErrorRate(node1, node2, -0.1); // this will ensure error model is disabled
+  Ptr<Channel> channel = setErrorRate(node1, node2, -0.1); // this will ensure error model is disabled
+  GlobalRoutingHelper::UpdateLinkState(channel, true);
 }
 
 void
@@ -24,6 +24,7 @@
 
 #include "ns3/ptr.h"
 #include "ns3/node.h"
+#include "ns3/channel.h"
 
 namespace ns3 {
 namespace ndn {
@@ -43,6 +44,9 @@ public:
    *
    * Note that only PointToPointChannels are supported by this helper method
    *
+   * If incremental routing is enabled (see GlobalRoutingHelper::SetIncrementalRouting), routes
+   * that used the link are recalculated.
+   *
    * @param node1 one node
    * @param node2 another node
    */
@@ -73,6 +77,9 @@ public:
    *
    * Note that only PointToPointChannels are supported by this helper method
    *
+   * If incremental routing is enabled (see GlobalRoutingHelper::SetIncrementalRouting), routes
+   * that become shorter through the link are recalculated.
+   *
    * @param node1 one node
    * @param node2 another node
    */
@@ -96,7 +103,7 @@ public:
   UpLinkByName(const std::string& node1, const std::string& node2);
 
 private:
-  static void
+  static Ptr<Channel>
   setErrorRate(Ptr<Node> node1, Ptr<Node> node2, double errorRate);
 }; // LinkControlHelper
 
@@ -41,6 +41,7 @@
 #include <boost/lexical_cast.hpp>
 
 #include "ns3/ndnSIM/NFD/daemon/face/generic-link-service.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
 #include "ns3/ndnSIM/NFD/daemon/table/cs-policy-priority-fifo.hpp"
 #include "ns3/ndnSIM/NFD/daemon/table/cs-policy-lru.hpp"
 
@@ -52,6 +53,8 @@ namespace ndn {
 StackHelper::StackHelper()
   : m_isForwarderStatusManagerDisabled(false)
   , m_isStrategyChoiceManagerDisabled(false)
+  , m_isForwardingOnly(false)
+  , m_hasUnicastReplies(false)
   , m_needSetDefaultRoutes(false)
 {
   setCustomNdnCxxClocks();
@@ -164,21 +167,31 @@ StackHelper::doInstall(Ptr<Node> node) const
   // async install to ensure proper context
   Ptr<L3Protocol> ndn = m_ndnFactory.Create<L3Protocol>();
 
-  if (m_isForwarderStatusManagerDisabled) {
-    ndn->getConfig().put("ndnSIM.disable_forwarder_status_manager", true);
+  if (m_isForwardingOnly) {
+    ndn->setForwardingOnly(true);
   }
+  else {
+    if (m_isForwarderStatusManagerDisabled) {
+      ndn->getConfig().put("ndnSIM.disable_forwarder_status_manager", true);
+    }
 
-  if (m_isStrategyChoiceManagerDisabled) {
-    ndn->getConfig().put("ndnSIM.disable_strategy_choice_manager", true);
-  }
+    if (m_isStrategyChoiceManagerDisabled) {
+      ndn->getConfig().put("ndnSIM.disable_strategy_choice_manager", true);
+    }
 
-  ndn->getConfig().put("tables.cs_max_packets", m_maxCsSize);
+    ndn->getConfig().put("tables.cs_max_packets", m_maxCsSize);
+  }
 
   ndn->setCsReplacementPolicy(m_csPolicyCreationFunc);
 
   // Aggregate L3Protocol on node (must be after setting ndnSIM CS)
   node->AggregateObject(ndn);
 
+  if (m_isForwardingOnly) {
+    // no tables config section to apply the limit
+    ndn->getForwarder()->getCs().setLimit(m_maxCsSize);
+  }
+
   for (uint32_t index = 0; index < node->GetNDevices(); index++) {
     Ptr<NetDevice> device = node->GetDevice(index);
     // This check does not make sense: LoopbackNetDevice is installed only if IP stack is installed,
@@ -249,6 +262,10 @@ StackHelper::DefaultNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
                                                    constructFaceUri(netDevice),
                                                    "netdev://[ff:ff:ff:ff:ff:ff]");
 
+  if (m_hasUnicastReplies) {
+    transport->enableUnicastReplies(Seconds(4));
+  }
+
   auto face = std::make_shared<Face>(std::move(linkService), std::move(transport));
   face->setMetric(1);
 
@@ -383,6 +400,18 @@ StackHelper::disableForwarderStatusManager()
   m_isForwarderStatusManagerDisabled = true;
 }
 
+void
+StackHelper::setForwardingOnly(bool isForwardingOnly)
+{
+  m_isForwardingOnly = isForwardingOnly;
+}
+
+void
+StackHelper::setUnicastReplies(bool isEnabled)
+{
+  m_hasUnicastReplies = isEnabled;
+}
+
 void
 StackHelper::SetLinkDelayAsFaceMetric()
 {
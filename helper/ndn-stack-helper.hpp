@@ -221,6 +221,35 @@ public:
   void
   disableForwarderStatusManager();
 
+  /**
+   * \brief Install forwarding-only stacks (no NFD management, RIB, or NFD config)
+   *
+   * Saves memory and install time on large topologies.  Routes and strategies on such nodes
+   * can be configured only with FibHelper, GlobalRoutingHelper, and StrategyChoiceHelper,
+   * which access the tables directly.
+   *
+   * \see L3Protocol::setForwardingOnly
+   */
+  void
+  setForwardingOnly(bool isForwardingOnly = true);
+
+  /**
+   * \brief Send Data and Nacks unicast to the requesting node on multi-access channels
+   *
+   * Faces created by the default callback (all NetDevices other than PointToPoint) remember
+   * which node sent each Interest, for at least 4 seconds, and send the Data or Nack for it to
+   * this node only.  Unicast frames are dropped by the NetDevices of the other nodes, which do
+   * not need to decode them.  Replies are broadcast if the requester is not known.
+   *
+   * Interests are still broadcast and decoded by every node on the channel, so each node still
+   * receives the Interests of all N nodes: per-node receive work is reduced for replies only,
+   * and remains O(N) per Interest.
+   *
+   * \see NetDeviceTransport::enableUnicastReplies
+   */
+  void
+  setUnicastReplies(bool isEnabled = true);
+
   /**
    * @brief Set face metric of all faces connected through PointToPoint channel to channel latency
    */
@@ -246,6 +275,8 @@ private:
 
   bool m_isForwarderStatusManagerDisabled;
   bool m_isStrategyChoiceManagerDisabled;
+  bool m_isForwardingOnly;
+  bool m_hasUnicastReplies;
 
 public:
   void
@@ -19,16 +19,19 @@
 
 #include "ndn-block-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
-
 #include <ndn-cxx/encoding/tlv.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/lp/packet.hpp>
 
-namespace io = boost::iostreams;
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
 namespace nfdFace = nfd::face;
 
 namespace ns3 {
@@ -73,38 +76,431 @@ BlockHeader::Serialize(ns3::Buffer::Iterator start) const
   start.Write(m_block.wire(), m_block.size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
+/**
+ * @brief Read NDN-TLV VAR-NUMBER from ns-3 buffer
+ * @return false if the buffer does not contain enough bytes
+ */
+static bool
+readVarNumber(ns3::Buffer::Iterator& i, uint64_t& number)
+{
+  if (i.GetRemainingSize() < 1) {
+    return false;
+  }
+
+  uint8_t firstOctet = i.ReadU8();
+  if (firstOctet < 253) {
+    number = firstOctet;
+  }
+  else if (firstOctet == 253) {
+    if (i.GetRemainingSize() < 2) {
+      return false;
+    }
+    number = i.ReadNtohU16();
+  }
+  else if (firstOctet == 254) {
+    if (i.GetRemainingSize() < 4) {
+      return false;
+    }
+    number = i.ReadNtohU32();
+  }
+  else {
+    if (i.GetRemainingSize() < 8) {
+      return false;
+    }
+    number = i.ReadNtohU64();
+  }
+  return true;
+}
+
+uint32_t
+BlockHeader::Deserialize(ns3::Buffer::Iterator start)
+{
+  // peek TLV-TYPE and TLV-LENGTH to learn the size of the whole block
+  ns3::Buffer::Iterator i = start;
+  uint64_t type = 0;
+  uint64_t length = 0;
+  if (!readVarNumber(i, type) || !readVarNumber(i, length)) {
+    throw ::ndn::tlv::Error("Insufficient data during TLV parsing");
+  }
+
+  uint32_t headerSize = start.GetRemainingSize() - i.GetRemainingSize();
+  if (length > i.GetRemainingSize()) {
+    throw ::ndn::tlv::Error("Not enough data in the buffer to fully parse TLV");
+  }
+
+  // single bulk copy of the whole TLV element
+  auto buffer = make_shared<::ndn::Buffer>(headerSize + static_cast<size_t>(length));
+  start.Read(buffer->data(), buffer->size());
+
+  m_block = Block(std::move(buffer));
+  return m_block.size();
+}
+
+namespace {
+
+/**
+ * @brief Content of Data shorter than this is copied as usual
+ */
+const size_t MIN_ZERO_AREA_SIZE = 256;
+
+/**
+ * @brief Part of the wire of a block that precedes its zero-filled area in ns-3 packet
+ */
+class BlockPrefix : public Header {
+public:
+  static ns3::TypeId
+  GetTypeId()
+  {
+    static ns3::TypeId tid =
+      ns3::TypeId("ns3::ndn::BlockPrefix")
+      .SetGroupName("Ndn")
+      .SetParent<Header>()
+      .AddConstructor<BlockPrefix>()
+      ;
+    return tid;
+  }
+
+  BlockPrefix(const uint8_t* begin = nullptr, const uint8_t* end = nullptr)
+    : m_begin(begin)
+    , m_size(end - begin)
+  {
+  }
+
+  TypeId
+  GetInstanceTypeId(void) const override
+  {
+    return GetTypeId();
+  }
+
+  uint32_t
+  GetSerializedSize(void) const override
+  {
+    return m_size;
+  }
+
+  void
+  Serialize(ns3::Buffer::Iterator start) const override
+  {
+    start.Write(m_begin, m_size);
+  }
+
+  uint32_t
+  Deserialize(ns3::Buffer::Iterator) override
+  {
+    return 0; // size is only known from the packet metadata
+  }
+
+  uint32_t
+  Deserialize(ns3::Buffer::Iterator start, ns3::Buffer::Iterator end) override
+  {
+    m_size = end.GetDistanceFrom(start);
+    return m_size;
+  }
+
+  void
+  Print(std::ostream& os) const override
+  {
+    os << "size: " << m_size;
+  }
+
+private:
+  const uint8_t* m_begin; ///< @brief only valid while the packet is created
+  uint32_t m_size;
+};
+
+/**
+ * @brief Part of the wire of a block that follows its zero-filled area in ns-3 packet
+ */
+class BlockSuffix : public Trailer {
+public:
+  static ns3::TypeId
+  GetTypeId()
+  {
+    static ns3::TypeId tid =
+      ns3::TypeId("ns3::ndn::BlockSuffix")
+      .SetGroupName("Ndn")
+      .SetParent<Trailer>()
+      .AddConstructor<BlockSuffix>()
+      ;
+    return tid;
+  }
+
+  BlockSuffix(const uint8_t* begin = nullptr, const uint8_t* end = nullptr)
+    : m_begin(begin)
+    , m_size(end - begin)
+  {
+  }
+
+  TypeId
+  GetInstanceTypeId(void) const override
+  {
+    return GetTypeId();
+  }
+
+  uint32_t
+  GetSerializedSize(void) const override
+  {
+    return m_size;
+  }
+
+  void
+  Serialize(ns3::Buffer::Iterator end) const override
+  {
+    end.Prev(m_size);
+    end.Write(m_begin, m_size);
+  }
+
+  uint32_t
+  Deserialize(ns3::Buffer::Iterator) override
+  {
+    return 0; // size is only known from the packet metadata
+  }
+
+  uint32_t
+  Deserialize(ns3::Buffer::Iterator start, ns3::Buffer::Iterator end) override
+  {
+    m_size = end.GetDistanceFrom(start);
+    return m_size;
+  }
+
+  void
+  Print(std::ostream& os) const override
+  {
+    os << "size: " << m_size;
+  }
+
+private:
+  const uint8_t* m_begin; ///< @brief only valid while the packet is created
+  uint32_t m_size;
+};
+
+/**
+ * @brief Narrow [@p begin, @p end) to the value of the first TLV element of @p type in it
+ * @return false, leaving the range unchanged, if there is no such well-formed element
+ */
+bool
+findElement(const uint8_t*& begin, const uint8_t*& end, uint32_t type)
+{
+  const uint8_t* pos = begin;
+  while (pos != end) {
+    uint32_t elementType = 0;
+    uint64_t length = 0;
+    if (!::ndn::tlv::readType(pos, end, elementType) || !::ndn::tlv::readVarNumber(pos, end, length)
+        || length > static_cast<uint64_t>(end - pos)) {
+      return false;
+    }
+    if (elementType == type) {
+      begin = pos;
+      end = pos + length;
+      return true;
+    }
+    pos += length;
+  }
+  return false;
+}
+
+/**
+ * @brief Narrow [@p begin, @p end) from the wire of a network or NDNLP packet to the content
+ *        of Data, if the content is long enough to be carried in a zero-filled area
+ * @param[out] dataBegin, dataEnd wire of the Data
+ */
+bool
+findContent(const uint8_t*& begin, const uint8_t*& end,
+            const uint8_t*& dataBegin, const uint8_t*& dataEnd)
+{
+  if (findElement(begin, end, ::ndn::lp::tlv::LpPacket)
+      && !findElement(begin, end, ::ndn::lp::tlv::Fragment)) {
+    return false;
+  }
+  dataBegin = begin;
+  dataEnd = end;
+  return findElement(begin, end, ::ndn::tlv::Data) && findElement(begin, end, ::ndn::tlv::Content)
+         && static_cast<size_t>(end - begin) >= MIN_ZERO_AREA_SIZE;
+}
+
+/**
+ * @brief Number of Data the virtual payload table remembers
+ */
+const size_t VIRTUAL_PAYLOAD_TABLE_SIZE = 16384;
+
+/**
+ * @brief Data whose content is virtual payload
+ *
+ * NFD copies the wire of Data whenever it is sent, so marked Data is recognized by all bytes of
+ * its wire except the content: name, fields, signature, and the TLV-LENGTHs that fix the
+ * content size.  The table keeps the Data most recently marked or sent; Data that is no longer
+ * in it is sent with its content copied.
+ */
+class VirtualPayloadTable {
 public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
+  static VirtualPayloadTable&
+  get()
   {
+    static VirtualPayloadTable table;
+    return table;
   }
 
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
+  void
+  insert(const uint8_t* dataBegin, const uint8_t* contentBegin, const uint8_t* contentEnd,
+         const uint8_t* dataEnd)
   {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
+    if (find(dataBegin, contentBegin, contentEnd, dataEnd)) {
+      return;
     }
-    if (i == 0) {
-      return -1;
+
+    size_t hash = boost::hash_range(dataBegin, contentBegin);
+    m_entries.push_front({hash, std::vector<uint8_t>(dataBegin, contentBegin),
+                          std::vector<uint8_t>(contentEnd, dataEnd)});
+    m_index.emplace(hash, m_entries.begin());
+
+    if (m_entries.size() > VIRTUAL_PAYLOAD_TABLE_SIZE) {
+      auto oldest = std::prev(m_entries.end());
+      auto range = m_index.equal_range(oldest->hash);
+      for (auto i = range.first; i != range.second; ++i) {
+        if (i->second == oldest) {
+          m_index.erase(i);
+          break;
+        }
+      }
+      m_entries.erase(oldest);
     }
-    else {
-      return i;
+  }
+
+  /**
+   * @brief Check whether the Data is marked, and keep it if so
+   */
+  bool
+  find(const uint8_t* dataBegin, const uint8_t* contentBegin, const uint8_t* contentEnd,
+       const uint8_t* dataEnd)
+  {
+    size_t headSize = contentBegin - dataBegin;
+    size_t tailSize = dataEnd - contentEnd;
+    auto range = m_index.equal_range(boost::hash_range(dataBegin, contentBegin));
+    for (auto i = range.first; i != range.second; ++i) {
+      const Entry& entry = *i->second;
+      if (entry.head.size() == headSize && entry.tail.size() == tailSize
+          && std::equal(entry.head.begin(), entry.head.end(), dataBegin)
+          && std::equal(entry.tail.begin(), entry.tail.end(), contentEnd)) {
+        m_entries.splice(m_entries.begin(), m_entries, i->second);
+        return true;
+      }
     }
+    return false;
   }
 
 private:
-  ns3::Buffer::Iterator& m_is;
+  struct Entry {
+    size_t hash;
+    std::vector<uint8_t> head; ///< @brief wire before the content
+    std::vector<uint8_t> tail; ///< @brief wire after the content
+  };
+
+  std::list<Entry> m_entries; ///< @brief most recently used first
+  std::unordered_multimap<size_t, std::list<Entry>::iterator> m_index;
 };
 
-uint32_t
-BlockHeader::Deserialize(ns3::Buffer::Iterator start)
+/**
+ * @brief Marks ns-3 packets whose zero-filled area is the content of Data
+ *
+ * The zero-filled area does not show in the bytes of the packet, so the tag tells the receiving
+ * NetDeviceTransport to mark the Data as virtual payload again.
+ */
+class VirtualPayloadTag : public Tag {
+public:
+  static ns3::TypeId
+  GetTypeId()
+  {
+    static ns3::TypeId tid =
+      ns3::TypeId("ns3::ndn::VirtualPayloadTag")
+      .SetGroupName("Ndn")
+      .SetParent<Tag>()
+      .AddConstructor<VirtualPayloadTag>()
+      ;
+    return tid;
+  }
+
+  TypeId
+  GetInstanceTypeId(void) const override
+  {
+    return GetTypeId();
+  }
+
+  uint32_t
+  GetSerializedSize(void) const override
+  {
+    return 0;
+  }
+
+  void
+  Serialize(TagBuffer) const override
+  {
+  }
+
+  void
+  Deserialize(TagBuffer) override
+  {
+  }
+
+  void
+  Print(std::ostream& os) const override
+  {
+    os << "virtual payload";
+  }
+};
+
+NS_OBJECT_ENSURE_REGISTERED(VirtualPayloadTag);
+
+} // namespace
+
+bool
+BlockHeader::findName(const Block& packet, uint32_t& type, const uint8_t*& begin, const uint8_t*& end)
 {
-  io::stream<Ns3BufferIteratorSource> is(start);
-  m_block = ::ndn::Block::fromStream(is);
-  return m_block.size();
+  const uint8_t* first = packet.wire();
+  const uint8_t* last = first + packet.size();
+  bool isNack = false;
+
+  if (findElement(first, last, ::ndn::lp::tlv::LpPacket)) {
+    const uint8_t* fieldBegin = first;
+    const uint8_t* fieldEnd = last;
+    if (findElement(fieldBegin, fieldEnd, ::ndn::lp::tlv::FragCount)) {
+      try {
+        if (::ndn::tlv::readNonNegativeInteger(fieldEnd - fieldBegin, fieldBegin, fieldEnd) != 1) {
+          return false; // fragment of a larger packet
+        }
+      }
+      catch (const ::ndn::tlv::Error&) {
+        return false;
+      }
+    }
+    fieldBegin = first;
+    fieldEnd = last;
+    isNack = findElement(fieldBegin, fieldEnd, ::ndn::lp::tlv::Nack);
+
+    if (!findElement(first, last, ::ndn::lp::tlv::Fragment)) {
+      return false; // IDLE packet
+    }
+  }
+
+  const uint8_t* netBegin = first;
+  const uint8_t* netEnd = last;
+  if (findElement(netBegin, netEnd, ::ndn::tlv::Interest)) {
+    type = isNack ? ::ndn::lp::tlv::Nack : ::ndn::tlv::Interest;
+  }
+  else if (!isNack && findElement(first, last, ::ndn::tlv::Data)) {
+    type = ::ndn::tlv::Data;
+    netBegin = first;
+    netEnd = last;
+  }
+  else {
+    return false;
+  }
+
+  if (!findElement(netBegin, netEnd, ::ndn::tlv::Name)) {
+    return false;
+  }
+  begin = netBegin;
+  end = netEnd;
+  return true;
 }
 
 void
@@ -172,5 +568,74 @@ BlockHeader::getBlock() const
   return m_block;
 }
 
+Ptr<ns3::Packet>
+BlockHeader::createPacket(const Block& packet)
+{
+  const uint8_t* begin = packet.wire();
+  const uint8_t* end = begin + packet.size();
+  const uint8_t* zeroBegin = begin;
+  const uint8_t* zeroEnd = end;
+  const uint8_t* dataBegin = nullptr;
+  const uint8_t* dataEnd = nullptr;
+  if (!findContent(zeroBegin, zeroEnd, dataBegin, dataEnd)
+      || !VirtualPayloadTable::get().find(dataBegin, zeroBegin, zeroEnd, dataEnd)) {
+    Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
+    ns3Packet->AddHeader(BlockHeader(packet));
+    return ns3Packet;
+  }
+
+  // virtual payload becomes the zero-filled area, only the bytes around it are written
+  Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>(zeroEnd - zeroBegin);
+  ns3Packet->AddHeader(BlockPrefix(begin, zeroBegin));
+  ns3Packet->AddTrailer(BlockSuffix(zeroEnd, end));
+  ns3Packet->AddPacketTag(VirtualPayloadTag());
+  return ns3Packet;
+}
+
+void
+BlockHeader::markVirtualPayload(const Block& data)
+{
+  markVirtualPayload(data.wire(), data.wire() + data.size());
+}
+
+void
+BlockHeader::markVirtualPayload(const uint8_t* begin, const uint8_t* end)
+{
+  const uint8_t* dataBegin = nullptr;
+  const uint8_t* dataEnd = nullptr;
+  if (findContent(begin, end, dataBegin, dataEnd)) {
+    VirtualPayloadTable::get().insert(dataBegin, begin, end, dataEnd);
+  }
+}
+
+Block
+BlockHeader::extractBlock(Ptr<const ns3::Packet> packet)
+{
+  // peek TLV-TYPE and TLV-LENGTH (at most 9 bytes each) to learn the size of the whole block
+  uint8_t typeAndLength[18];
+  const uint8_t* pos = typeAndLength;
+  const uint8_t* end = pos + packet->CopyData(typeAndLength, sizeof(typeAndLength));
+  uint32_t type = 0;
+  uint64_t length = 0;
+  if (!::ndn::tlv::readType(pos, end, type) || !::ndn::tlv::readVarNumber(pos, end, length)) {
+    throw ::ndn::tlv::Error("Insufficient data during TLV parsing");
+  }
+
+  uint32_t headerSize = pos - typeAndLength;
+  if (length > packet->GetSize() - headerSize) {
+    throw ::ndn::tlv::Error("Not enough data in the buffer to fully parse TLV");
+  }
+
+  // data areas are copied with memcpy, the zero-filled area with memset
+  auto buffer = make_shared<::ndn::Buffer>(headerSize + static_cast<size_t>(length));
+  packet->CopyData(buffer->data(), buffer->size());
+
+  VirtualPayloadTag tag;
+  if (packet->PeekPacketTag(tag)) {
+    markVirtualPayload(buffer->data(), buffer->data() + buffer->size());
+  }
+  return Block(std::move(buffer));
+}
+
 } // namespace ndn
 } // namespace ns3
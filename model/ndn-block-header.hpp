@@ -21,6 +21,7 @@
 #define NDNSIM_NDN_BLOCK_HEADER_HPP
 
 #include "ns3/header.h"
+#include "ns3/packet.h"
 
 #include "ndn-common.hpp"
 
@@ -59,6 +60,55 @@ public:
   const Block&
   getBlock() const;
 
+  /**
+   * @brief Create ns-3 packet that carries @p packet
+   *
+   * Content of Data marked as virtual payload (see markVirtualPayload), also when the Data is
+   * a fragment of an NDNLP packet, is represented by the zero-filled area of the ns-3 packet.
+   * It is neither allocated nor copied by ns-3 and is transferred compactly between MPI ranks,
+   * while the ns-3 packet still has the exact size of @p packet.  The content itself is not
+   * inspected: the mark promises that it consists of zeros only.
+   */
+  static Ptr<ns3::Packet>
+  createPacket(const Block& packet);
+
+  /**
+   * @brief Mark the content of Data @p data as virtual payload, which consists of zeros only
+   *
+   * The producer marks Data once (DataTemplate does so for Data with virtual payload), so that
+   * the content need not be compared with zeros whenever the Data is sent.  The wire of @p data
+   * is not changed: the mark is kept beside it for the most recently sent Data, and travels
+   * over links as an ns-3 packet tag, so that extractBlock marks the received Data again.
+   */
+  static void
+  markVirtualPayload(const Block& data);
+
+  /**
+   * @brief Extract the block at the beginning of @p packet
+   *
+   * Same as PeekHeader, but the data is copied in bulk instead of byte by byte, and the
+   * zero-filled area of the ns-3 packet is not read at all.
+   *
+   * @throw ::ndn::tlv::Error @p packet does not begin with a complete TLV element
+   */
+  static Block
+  extractBlock(Ptr<const ns3::Packet> packet);
+
+  /**
+   * @brief Find the name of the Interest, Data, or Nack carried by @p packet, without decoding
+   *        the packet
+   * @param packet network packet, or NDNLP packet that is not a fragment of a larger packet
+   * @param[out] type tlv::Interest, tlv::Data, or lp::tlv::Nack
+   * @param[out] begin, end value of the Name element
+   * @return false if @p packet does not carry a complete network packet with a name
+   */
+  static bool
+  findName(const Block& packet, uint32_t& type, const uint8_t*& begin, const uint8_t*& end);
+
+private:
+  static void
+  markVirtualPayload(const uint8_t* begin, const uint8_t* end);
+
 private:
   Block m_block;
 };
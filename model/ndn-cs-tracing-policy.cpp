@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-cs-tracing-policy.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/table/cs.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+CsTracingPolicy::CsTracingPolicy(std::unique_ptr<nfd::cs::Policy> policy, DataTrace& hits,
+                                 DataTrace& inserts, DataTrace& evictions)
+  : Policy(policy->getName())
+  , m_policy(std::move(policy))
+  , m_hits(hits)
+  , m_inserts(inserts)
+  , m_evictions(evictions)
+{
+  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (EntryRef i) {
+      m_evictions(i->getData());
+      this->emitSignal(beforeEvict, i);
+    });
+}
+
+void
+CsTracingPolicy::doAfterInsert(EntryRef i)
+{
+  m_inserts(i->getData());
+
+  // may evict entries, including the one just inserted
+  m_policy->afterInsert(i);
+}
+
+void
+CsTracingPolicy::doAfterRefresh(EntryRef i)
+{
+  m_policy->afterRefresh(i);
+}
+
+void
+CsTracingPolicy::doBeforeErase(EntryRef i)
+{
+  m_evictions(i->getData());
+  m_policy->beforeErase(i);
+}
+
+void
+CsTracingPolicy::doBeforeUse(EntryRef i)
+{
+  m_hits(i->getData());
+  m_policy->beforeUse(i);
+}
+
+void
+CsTracingPolicy::evictEntries()
+{
+  // called by setLimit and after the CS is attached: keep the wrapped policy in sync
+  m_policy->setCs(getCs());
+  m_policy->setLimit(getLimit());
+}
+
+} // namespace ndn
+} // namespace ns3
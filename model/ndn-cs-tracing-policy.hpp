@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CS_TRACING_POLICY_HPP
+#define NDN_CS_TRACING_POLICY_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs-policy.hpp"
+
+#include "ns3/traced-callback.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Content store policy that reports CS events to ns-3 trace sources
+ *
+ * The policy wraps the replacement policy configured with StackHelper::setPolicy and forwards
+ * all decisions to it.  Hits, insertions and removals (evictions and explicit erasures) of
+ * entries are reported to the provided TracedCallbacks, which are exposed by L3Protocol as
+ * ``CsHits``, ``CsInserts`` and ``CsEvictions``.  When nothing is connected to the trace
+ * sources, the only overhead is an extra virtual call per CS operation.
+ */
+class CsTracingPolicy : public nfd::cs::Policy {
+public:
+  typedef TracedCallback<const Data&> DataTrace;
+
+  CsTracingPolicy(std::unique_ptr<nfd::cs::Policy> policy, DataTrace& hits, DataTrace& inserts,
+                  DataTrace& evictions);
+
+private:
+  void
+  doAfterInsert(EntryRef i) override;
+
+  void
+  doAfterRefresh(EntryRef i) override;
+
+  void
+  doBeforeErase(EntryRef i) override;
+
+  void
+  doBeforeUse(EntryRef i) override;
+
+  void
+  evictEntries() override;
+
+private:
+  std::unique_ptr<nfd::cs::Policy> m_policy;
+  ::ndn::util::signal::ScopedConnection m_beforeEvictConnection;
+
+  DataTrace& m_hits;
+  DataTrace& m_inserts;
+  DataTrace& m_evictions;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CS_TRACING_POLICY_HPP
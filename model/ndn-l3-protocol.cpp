@@ -30,6 +30,7 @@
 #include "ns3/simulator.h"
 
 #include "ndn-net-device-transport.hpp"
+#include "ndn-cs-tracing-policy.hpp"
 
 #include "../helper/ndn-stack-helper.hpp"
 
@@ -105,6 +106,18 @@ L3Protocol::GetTypeId(void)
       .AddTraceSource("TimedOutInterests", "TimedOutInterests",
                       MakeTraceSourceAccessor(&L3Protocol::m_timedOutInterests),
                       "ns3::ndn::L3Protocol::TimedOutInterestsCallback")
+
+      ////////////////////////////////////////////////////////////////////
+
+      .AddTraceSource("CsHits", "Interests satisfied from the content store",
+                      MakeTraceSourceAccessor(&L3Protocol::m_csHits),
+                      "ns3::ndn::L3Protocol::CsTraceCallback")
+      .AddTraceSource("CsInserts", "Data packets admitted to the content store",
+                      MakeTraceSourceAccessor(&L3Protocol::m_csInserts),
+                      "ns3::ndn::L3Protocol::CsTraceCallback")
+      .AddTraceSource("CsEvictions", "Data packets evicted or erased from the content store",
+                      MakeTraceSourceAccessor(&L3Protocol::m_csEvictions),
+                      "ns3::ndn::L3Protocol::CsTraceCallback")
     ;
   return tid;
 }
@@ -112,6 +125,15 @@ L3Protocol::GetTypeId(void)
 class L3Protocol::Impl {
 private:
   Impl()
+    : m_isForwardingOnly(false)
+  {
+  }
+
+  /**
+   * \brief Parse initial NFD config, done on first access (never in forwarding-only mode)
+   */
+  void
+  loadConfig()
   {
     // Do not modify initial config file. Use helpers to set specific NFD parameters
     std::string initialConfig =
@@ -194,6 +216,8 @@ private:
   nfd::ConfigSection m_config;
 
   PolicyCreationCallback m_policy;
+
+  bool m_isForwardingOnly;
 };
 
 L3Protocol::L3Protocol()
@@ -212,10 +236,16 @@ L3Protocol::initialize()
 {
   m_impl->m_faceTable = make_unique<::nfd::FaceTable>();
   m_impl->m_forwarder = make_shared<::nfd::Forwarder>(*m_impl->m_faceTable);
-  m_impl->m_faceSystem = make_unique<::nfd::face::FaceSystem>(*m_impl->m_faceTable, nullptr);
 
-  initializeManagement();
-  initializeRibManager();
+  if (m_impl->m_isForwardingOnly) {
+    initializeForwarding();
+  }
+  else {
+    m_impl->m_faceSystem = make_unique<::nfd::face::FaceSystem>(*m_impl->m_faceTable, nullptr);
+
+    initializeManagement();
+    initializeRibManager();
+  }
 
   m_impl->m_forwarder->beforeSatisfyInterest.connect(std::ref(m_satisfiedInterests));
   m_impl->m_forwarder->beforeExpirePendingInterest.connect(std::ref(m_timedOutInterests));
@@ -245,6 +275,8 @@ private:
 void
 L3Protocol::injectInterest(const Interest& interest)
 {
+  NS_ASSERT_MSG(!m_impl->m_isForwardingOnly,
+                "Forwarding-only node has no management, tables must be accessed directly");
   m_impl->m_internalClientFaceForInjects->expressInterest(interest, nullptr, nullptr, nullptr);
 }
 
@@ -254,6 +286,30 @@ L3Protocol::setCsReplacementPolicy(const PolicyCreationCallback& policy)
   m_impl->m_policy = policy;
 }
 
+void
+L3Protocol::setForwardingOnly(bool isForwardingOnly)
+{
+  NS_ASSERT_MSG(m_node == nullptr, "Mode must be selected before L3Protocol is aggregated");
+  m_impl->m_isForwardingOnly = isForwardingOnly;
+}
+
+bool
+L3Protocol::isForwardingOnly() const
+{
+  return m_impl->m_isForwardingOnly;
+}
+
+void
+L3Protocol::initializeForwarding()
+{
+  // Only tables and faces needed to forward packets: no internal faces, dispatcher, managers,
+  // RIB, and NFD config.  The default strategy (best-route) is installed by the forwarder itself.
+  m_impl->m_forwarder->getStrategyChoice().insert("/ndn/multicast",
+                                                  "/localhost/nfd/strategy/multicast");
+  m_impl->m_forwarder->getCs().setPolicy(make_unique<CsTracingPolicy>(m_impl->m_policy(), m_csHits,
+                                                                      m_csInserts, m_csEvictions));
+}
+
 void
 L3Protocol::initializeManagement()
 {
@@ -288,7 +344,8 @@ L3Protocol::initializeManagement()
 
   ConfigFile config(&ConfigFile::ignoreUnknownSection);
 
-  forwarder->getCs().setPolicy(m_impl->m_policy());
+  forwarder->getCs().setPolicy(make_unique<CsTracingPolicy>(m_impl->m_policy(), m_csHits,
+                                                           m_csInserts, m_csEvictions));
 
   TablesConfigSection tablesConfig(*forwarder);
   tablesConfig.setConfigFile(config);
@@ -300,7 +357,7 @@ L3Protocol::initializeManagement()
   // }
 
   // apply config
-  config.parse(m_impl->m_config, false, "ndnSIM.conf");
+  config.parse(getConfig(), false, "ndnSIM.conf");
 
   tablesConfig.ensureConfigured();
 
@@ -319,7 +376,7 @@ L3Protocol::initializeRibManager()
   std::tie(m_impl->m_internalRibFace, m_impl->m_internalRibClientFace) = face::makeInternalFace(StackHelper::getKeyChain());
   m_impl->m_faceTable->add(m_impl->m_internalRibFace);
 
-  m_impl->m_ribService = make_unique<rib::Service>(m_impl->m_config,
+  m_impl->m_ribService = make_unique<rib::Service>(getConfig(),
                                                    std::ref(*m_impl->m_internalRibClientFace),
                                                    std::ref(StackHelper::getKeyChain()));
 }
@@ -357,6 +414,9 @@ L3Protocol::getRibService()
 nfd::ConfigSection&
 L3Protocol::getConfig()
 {
+  if (m_impl->m_config.empty()) {
+    m_impl->loadConfig();
+  }
   return m_impl->m_config;
 }
 
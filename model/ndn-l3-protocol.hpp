@@ -174,6 +174,21 @@ public:
   void
   setCsReplacementPolicy(const PolicyCreationCallback& policy);
 
+  /**
+   * \brief Enable or disable forwarding-only mode (must be called before aggregation on a node)
+   *
+   * In forwarding-only mode, only the forwarder with its tables and faces is created.  There are
+   * no internal faces, management dispatcher, FIB/CS/face/strategy-choice managers, RIB service,
+   * and NFD config, so getFibManager() returns nullptr and getConfig(), getStrategyChoiceManager(),
+   * getRibService(), and injectInterest() must not be used.  Helpers (FibHelper,
+   * StrategyChoiceHelper) modify the tables of such nodes directly.
+   */
+  void
+  setForwardingOnly(bool isForwardingOnly);
+
+  bool
+  isForwardingOnly() const;
+
 public: // Workaround for python bindings
   static Ptr<L3Protocol>
   getL3Protocol(Ptr<Object> node);
@@ -185,6 +200,8 @@ public:
   typedef void (*SatisfiedInterestsCallback)(const nfd::pit::Entry& pitEntry, const Face& inFace, const Data& data);
   typedef void (*TimedOutInterestsCallback)(const nfd::pit::Entry& pitEntry);
 
+  typedef void (*CsTraceCallback)(const Data& data);
+
 protected:
   virtual void
   DoDispose(void); ///< @brief Do cleanup
@@ -202,6 +219,9 @@ private:
   void
   initialize();
 
+  void
+  initializeForwarding();
+
   void
   initializeManagement();
 
@@ -228,6 +248,10 @@ private:
 
   TracedCallback<const nfd::pit::Entry&, const Face&/*in face*/, const Data&> m_satisfiedInterests;
   TracedCallback<const nfd::pit::Entry&> m_timedOutInterests;
+
+  TracedCallback<const Data&> m_csHits;      ///< @brief trace of content store hits
+  TracedCallback<const Data&> m_csInserts;   ///< @brief trace of content store insertions
+  TracedCallback<const Data&> m_csEvictions; ///< @brief trace of content store evictions
 };
 
 } // namespace ndn
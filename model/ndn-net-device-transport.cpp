@@ -28,6 +28,7 @@
 #include <ndn-cxx/data.hpp>
 
 #include "ns3/queue.h"
+#include "ns3/simulator.h"
 
 NS_LOG_COMPONENT_DEFINE("ndn.NetDeviceTransport");
 
@@ -43,6 +44,7 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
                                        ::ndn::nfd::LinkType linkType)
   : m_netDevice(netDevice)
   , m_node(node)
+  , m_requesterLifetime(0)
 {
   this->setLocalUri(FaceUri(localUri));
   this->setRemoteUri(FaceUri(remoteUri));
@@ -82,6 +84,87 @@ NetDeviceTransport::~NetDeviceTransport()
   NS_LOG_FUNCTION_NOARGS();
 }
 
+void
+NetDeviceTransport::enableUnicastReplies(Time lifetime)
+{
+  NS_ASSERT(lifetime.IsStrictlyPositive());
+  if (m_requesterLifetime.IsZero()) {
+    // unicast frames to other nodes need not be seen
+    auto handler = MakeCallback(&NetDeviceTransport::receiveFromNetDevice, this);
+    m_node->UnregisterProtocolHandler(handler);
+    m_node->RegisterProtocolHandler(handler, L3Protocol::ETHERNET_FRAME_TYPE, m_netDevice,
+                                    false /*promiscuous mode*/);
+  }
+  m_requesterLifetime = lifetime;
+  m_generationEnd = Simulator::Now() + lifetime;
+}
+
+void
+NetDeviceTransport::forgetOldRequesters()
+{
+  Time now = Simulator::Now();
+  if (now >= m_generationEnd) {
+    if (now >= m_generationEnd + m_requesterLifetime) {
+      m_requesters[0].clear();
+    }
+    std::swap(m_requesters[0], m_requesters[1]);
+    m_requesters[0].clear();
+    m_generationEnd = now + m_requesterLifetime;
+  }
+}
+
+void
+NetDeviceTransport::learnRequester(const Block& packet, const Address& from)
+{
+  uint32_t type = 0;
+  const uint8_t* begin = nullptr;
+  const uint8_t* end = nullptr;
+  if (!BlockHeader::findName(packet, type, begin, end) || type != ::ndn::tlv::Interest) {
+    return;
+  }
+
+  forgetOldRequesters();
+
+  std::string name(reinterpret_cast<const char*>(begin), end - begin);
+  auto previous = m_requesters[1].find(name);
+  if (previous != m_requesters[1].end()) {
+    // keep it in the current generation only
+    Address requester = previous->second;
+    m_requesters[1].erase(previous);
+    m_requesters[0].emplace(name, requester);
+  }
+
+  auto requester = m_requesters[0].emplace(name, from);
+  if (!requester.second && requester.first->second != from) {
+    requester.first->second = m_netDevice->GetBroadcast(); // requested by several nodes
+  }
+}
+
+Address
+NetDeviceTransport::getDestination(const Block& packet)
+{
+  uint32_t type = 0;
+  const uint8_t* begin = nullptr;
+  const uint8_t* end = nullptr;
+  if (m_requesterLifetime.IsZero() || !BlockHeader::findName(packet, type, begin, end)
+      || type == ::ndn::tlv::Interest) {
+    return m_netDevice->GetBroadcast();
+  }
+
+  forgetOldRequesters();
+
+  std::string name(reinterpret_cast<const char*>(begin), end - begin);
+  for (auto& requesters : m_requesters) {
+    auto requester = requesters.find(name);
+    if (requester != requesters.end()) {
+      Address destination = requester->second;
+      requesters.erase(requester); // later Interests are learned again
+      return destination;
+    }
+  }
+  return m_netDevice->GetBroadcast();
+}
+
 ssize_t
 NetDeviceTransport::getSendQueueLength()
 {
@@ -111,15 +194,11 @@ NetDeviceTransport::doSend(const Block& packet, const nfd::EndpointId& endpoint)
   NS_LOG_FUNCTION(this << "Sending packet from netDevice with URI"
                   << this->getLocalUri());
 
-  // convert NFD packet to NS3 packet
-  BlockHeader header(packet);
-
-  Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
-  ns3Packet->AddHeader(header);
+  // convert NFD packet to NS3 packet (virtual payload is not copied)
+  Ptr<ns3::Packet> ns3Packet = BlockHeader::createPacket(packet);
 
   // send the NS3 packet
-  m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
-                    L3Protocol::ETHERNET_FRAME_TYPE);
+  m_netDevice->Send(ns3Packet, getDestination(packet), L3Protocol::ETHERNET_FRAME_TYPE);
 }
 
 // callback
@@ -132,13 +211,12 @@ NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
 {
   NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
-  // Convert NS3 packet to NFD packet
-  Ptr<ns3::Packet> packet = p->Copy();
-
-  BlockHeader header;
-  packet->RemoveHeader(header);
-
-  this->receive(std::move(header.getBlock()));
+  // Convert NS3 packet to NFD packet (the packet is only read, no need to copy it)
+  Block packet = BlockHeader::extractBlock(p);
+  if (!m_requesterLifetime.IsZero()) {
+    learnRequester(packet, from);
+  }
+  this->receive(std::move(packet));
 }
 
 Ptr<NetDevice>
@@ -32,12 +32,18 @@
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/channel.h"
 
+#include <unordered_map>
+
 namespace ns3 {
 namespace ndn {
 
 /**
  * \ingroup ndn-face
  * \brief ndnSIM-specific transport
+ *
+ * Packets are sent to the broadcast address of the NetDevice.  On multi-access channels (CSMA,
+ * WiFi), the transport can send Data and Nacks unicast to the node that sent the Interest
+ * (see enableUnicastReplies).
  */
 class NetDeviceTransport : public nfd::face::Transport
 {
@@ -57,6 +63,20 @@ public:
   virtual ssize_t
   getSendQueueLength() final;
 
+  /**
+   * \brief Send Data and Nacks unicast to the requester, if it is known
+   *
+   * The transport remembers the link-layer address each Interest was received from, by Interest
+   * name, for \p lifetime to twice \p lifetime.  Data and Nacks with the same name are sent to
+   * this address only.  They are broadcast if the Interest was received from several nodes, if
+   * it is no longer remembered, or if it was fragmented; Interests are always broadcast.
+   *
+   * Packets still arrive on the face of this transport, so forwarding is not affected.  Frames
+   * unicast to other nodes are no longer passed to the transport.
+   */
+  void
+  enableUnicastReplies(Time lifetime);
+
 private:
   virtual void
   doClose() override;
@@ -64,6 +84,18 @@ private:
   virtual void
   doSend(const Block& packet, const nfd::EndpointId& endpoint) override;
 
+  /**
+   * \brief Get the address @p packet is sent to
+   */
+  Address
+  getDestination(const Block& packet);
+
+  void
+  forgetOldRequesters();
+
+  void
+  learnRequester(const Block& packet, const Address& from);
+
   void
   receiveFromNetDevice(Ptr<NetDevice> device,
                        Ptr<const ns3::Packet> p,
@@ -73,6 +105,12 @@ private:
 
   Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
   Ptr<Node> m_node;
+
+  Time m_requesterLifetime; ///< \brief zero if replies are broadcast
+  Time m_generationEnd;
+  /// \brief requesters by Interest name (the broadcast address if several); current and
+  ///        previous generation
+  std::unordered_map<std::string, Address> m_requesters[2];
 };
 
 } // namespace ndn
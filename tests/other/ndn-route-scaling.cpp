@@ -0,0 +1,296 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-route-scaling.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+#include "ns3/ndnSIM/utils/topology/rocketfuel-map-reader.hpp"
+#include "ns3/ndnSIM/helper/ndn-global-routing-graph.hpp"
+#include "ns3/ndnSIM/helper/boost-graph-ndn-global-routing-helper.hpp"
+
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Scaling benchmark of global route computation.
+ *
+ * Loads a Rocketfuel map (or an annotated topology, or builds a grid), installs NDN stack and
+ * GlobalRouter on all nodes, and reports real time of
+ *
+ * - taking the compact (CSR) snapshot of the topology,
+ * - all-pairs shortest paths on the snapshot,
+ * - all-pairs shortest paths using boost::dijkstra_shortest_paths over NdnGlobalRouterGraph
+ *   (the previous implementation, only with --boost=1),
+ * - complete GlobalRoutingHelper::CalculateRoutes, including FIB installation, on --threads
+ *   threads (0 for all hardware threads),
+ * - GlobalRoutingHelper::CalculateAllPossibleRoutes (only with --all-possible=1),
+ * - incremental route updates for --churn random point-to-point link failures, each followed
+ *   by recovery of the link (only with --churn=N),
+ * - GlobalRoutingHelper::CalculateLfidRoutes, including loop and dead end removal (only with
+ *   --lfid=1; requires a topology of point-to-point links only).
+ *
+ * Rocketfuel maps (*.cch files) of different sizes give the 100, 1k, and 10k node data points,
+ * e.g., AS 3967 (~100 routers with --clients=0), AS 1755 with clients (~1k), and AS 1239 with
+ * clients (~10k):
+ *
+ *     ./waf --run "ndn-route-scaling --maps=3967.r0.cch --clients=0 --boost=1"
+ *     ./waf --run "ndn-route-scaling --maps=1755.r0.cch --boost=1"
+ *     ./waf --run "ndn-route-scaling --maps=1239.r0.cch"
+ *     ./waf --run "ndn-route-scaling --maps=1239.r0.cch --threads=8"
+ *     ./waf --run "ndn-route-scaling --maps=1755.r0.cch --churn=100"
+ *     ./waf --run "ndn-route-scaling --topology=src/ndnSIM/examples/topologies/topo-abilene.txt --lfid=1"
+ *     ./waf --run "ndn-route-scaling --grid-size=32 --lfid=1 --threads=8"
+ */
+class RouteScalingTester {
+public:
+  RouteScalingTester()
+    : m_gridSize(10)
+    , m_clients(2)
+    , m_useBoost(false)
+    , m_threads(1)
+    , m_allPossible(false)
+    , m_lfid(false)
+    , m_churn(0)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  createTopology();
+
+  static double
+  now();
+
+private:
+  uint32_t m_gridSize;
+  std::string m_topology;
+  std::string m_maps;
+  int m_clients;
+  bool m_useBoost;
+  uint32_t m_threads;
+  bool m_allPossible;
+  bool m_lfid;
+  uint32_t m_churn;
+};
+
+double
+RouteScalingTester::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+void
+RouteScalingTester::createTopology()
+{
+  if (!m_maps.empty()) {
+    RocketfuelParams params;
+    params.averageRtt = 0.25;
+    params.clientNodeDegrees = m_clients;
+    params.minb2bBandwidth = "40Mbps";
+    params.minb2bDelay = "5ms";
+    params.maxb2bBandwidth = "100Mbps";
+    params.maxb2bDelay = "10ms";
+    params.minb2gBandwidth = "10Mbps";
+    params.minb2gDelay = "5ms";
+    params.maxb2gBandwidth = "20Mbps";
+    params.maxb2gDelay = "10ms";
+    params.ming2cBandwidth = "1Mbps";
+    params.ming2cDelay = "70ms";
+    params.maxg2cBandwidth = "3Mbps";
+    params.maxg2cDelay = "10ms";
+
+    RocketfuelMapReader topologyReader("", 1.0);
+    topologyReader.SetFileName(m_maps);
+    topologyReader.Read(params, true, true);
+  }
+  else if (!m_topology.empty()) {
+    AnnotatedTopologyReader topologyReader("", 25);
+    topologyReader.SetFileName(m_topology);
+    topologyReader.Read();
+  }
+  else {
+    PointToPointHelper p2p;
+    PointToPointGridHelper grid(m_gridSize, m_gridSize, p2p);
+    grid.BoundingBox(100, 100, 200, 200);
+  }
+}
+
+int
+RouteScalingTester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("maps", "Rocketfuel maps file (*.cch)", m_maps);
+  cmd.AddValue("clients", "Client node degree for Rocketfuel maps (0 to skip client nodes)",
+               m_clients);
+  cmd.AddValue("topology", "Annotated topology file (if maps is not set)", m_topology);
+  cmd.AddValue("grid-size", "Size of the grid topology (if neither maps nor topology are set)",
+               m_gridSize);
+  cmd.AddValue("boost", "Also run all-pairs Dijkstra using Boost Graph Library", m_useBoost);
+  cmd.AddValue("threads", "Number of threads to calculate routes (0 for all hardware threads)",
+               m_threads);
+  cmd.AddValue("all-possible", "Also run CalculateAllPossibleRoutes", m_allPossible);
+  cmd.AddValue("lfid", "Also run CalculateLfidRoutes", m_lfid);
+  cmd.AddValue("churn", "Number of link failures (and recoveries) to update routes for",
+               m_churn);
+  cmd.Parse(argc, argv);
+
+  createTopology();
+
+  NodeContainer nodes = NodeContainer::GetGlobal();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setForwardingOnly();
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  for (uint32_t i = 0; i < nodes.GetN(); i++) {
+    ndnGlobalRoutingHelper.AddOrigin("/node" + std::to_string(i), nodes.Get(i));
+  }
+
+  double begin = now();
+  ndn::GlobalRoutingGraph graph;
+  double snapshotTime = now() - begin;
+
+  begin = now();
+  ndn::GlobalRoutingGraph::ShortestPaths paths;
+  uint64_t reachable = 0;
+  for (ndn::GlobalRoutingGraph::Vertex v = 0; v < graph.getNVertices(); v++) {
+    graph.calculateShortestPaths(v, paths);
+    for (auto distance : paths.distance) {
+      reachable += distance != ndn::GlobalRoutingGraph::INFINITE_DISTANCE;
+    }
+  }
+  double csrTime = now() - begin;
+
+  double boostTime = 0;
+  if (m_useBoost) {
+    boost::NdnGlobalRouterGraph boostGraph;
+    begin = now();
+    for (const auto& source : boostGraph.GetVertices()) {
+      boost::DistancesMap distances;
+      dijkstra_shortest_paths(boostGraph, source,
+                              distance_map(boost::ref(distances))
+                                .distance_inf(boost::WeightInf)
+                                .distance_zero(boost::WeightZero)
+                                .distance_compare(boost::WeightCompare())
+                                .distance_combine(boost::WeightCombine()));
+    }
+    boostTime = now() - begin;
+  }
+
+  ndn::GlobalRoutingHelper::SetNumberOfThreads(m_threads);
+  ndn::GlobalRoutingHelper::SetIncrementalRouting(m_churn > 0);
+
+  begin = now();
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  double calculateRoutesTime = now() - begin;
+
+  double churnTime = 0;
+  uint64_t churnFibChanges = 0;
+  if (m_churn > 0) {
+    std::vector<Ptr<Channel>> links;
+    for (ChannelList::Iterator channel = ChannelList::Begin(); channel != ChannelList::End();
+         channel++) {
+      if ((*channel)->GetNDevices() == 2) {
+        links.push_back(*channel);
+      }
+    }
+
+    Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+    begin = now();
+    for (uint32_t i = 0; i < m_churn && !links.empty(); i++) {
+      Ptr<Channel> link = links[random->GetInteger(0, links.size() - 1)];
+      churnFibChanges += ndn::GlobalRoutingHelper::UpdateLinkState(link, false);
+      churnFibChanges += ndn::GlobalRoutingHelper::UpdateLinkState(link, true);
+    }
+    churnTime = now() - begin;
+  }
+
+  double allPossibleTime = 0;
+  if (m_allPossible) {
+    begin = now();
+    ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+    allPossibleTime = now() - begin;
+  }
+
+  double lfidTime = 0;
+  if (m_lfid) {
+    // LFID identifies nodes by name
+    for (uint32_t i = 0; i < nodes.GetN(); i++) {
+      if (Names::FindName(nodes.Get(i)).empty()) {
+        Names::Add("node" + std::to_string(i), nodes.Get(i));
+      }
+    }
+
+    begin = now();
+    ndn::GlobalRoutingHelper::CalculateLfidRoutes();
+    lfidTime = now() - begin;
+  }
+
+  std::cout << "Nodes\t" << nodes.GetN() << "\n"
+            << "Vertices\t" << graph.getNVertices() << "\n"
+            << "Edges\t" << graph.getNEdges() << "\n"
+            << "ReachablePairs\t" << reachable << "\n"
+            << "SnapshotTime\t" << snapshotTime << "s\n"
+            << "AllPairsCsrTime\t" << csrTime << "s\n";
+  if (m_useBoost) {
+    std::cout << "AllPairsBoostTime\t" << boostTime << "s\n";
+  }
+  std::cout << "Threads\t" << ndn::GlobalRoutingHelper::GetNumberOfThreads() << "\n"
+            << "CalculateRoutesTime\t" << calculateRoutesTime << "s\n";
+  if (m_churn > 0) {
+    std::cout << "LinkChurnEvents\t" << 2 * m_churn << "\n"
+              << "LinkChurnFibChanges\t" << churnFibChanges << "\n"
+              << "LinkChurnTimePerEvent\t" << churnTime / (2 * m_churn) << "s\n";
+  }
+  if (m_allPossible) {
+    std::cout << "CalculateAllPossibleRoutesTime\t" << allPossibleTime << "s\n";
+  }
+  if (m_lfid) {
+    std::cout << "CalculateLfidRoutesTime\t" << lfidTime << "s\n";
+  }
+  std::cout << "Memory\t" << MemUsage::Get() / 1024.0 / 1024.0 << "MiB\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::RouteScalingTester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-route-setup.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Startup benchmark for route installation.
+ *
+ * Builds either a grid topology or a topology read by AnnotatedTopologyReader, installs the
+ * NDN stack, calculates global routes to every node and measures the real time it takes
+ * until all FIB entries are in place.  Routes are installed either directly into the
+ * forwarder's FIB (default) or through signed NFD management command Interests.
+ *
+ *     ./waf --run "ndn-route-setup --grid-size=14"
+ *     ./waf --run "ndn-route-setup --grid-size=14 --commands=1"
+ *     ./waf --run "ndn-route-setup --topology=src/ndnSIM/examples/topologies/topo-grid-3x3.txt"
+ */
+class RouteSetupTester {
+public:
+  RouteSetupTester()
+    : m_gridSize(10)
+    , m_useCommands(false)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  static double
+  now();
+
+private:
+  uint32_t m_gridSize;
+  bool m_useCommands;
+  std::string m_topology;
+};
+
+double
+RouteSetupTester::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+RouteSetupTester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("grid-size", "Size of the grid topology (ignored if topology is set)", m_gridSize);
+  cmd.AddValue("topology", "Annotated topology file", m_topology);
+  cmd.AddValue("commands", "Install routes using NFD management command Interests",
+               m_useCommands);
+  cmd.Parse(argc, argv);
+
+  if (!m_topology.empty()) {
+    AnnotatedTopologyReader topologyReader("", 25);
+    topologyReader.SetFileName(m_topology);
+    topologyReader.Read();
+  }
+  else {
+    PointToPointHelper p2p;
+    PointToPointGridHelper grid(m_gridSize, m_gridSize, p2p);
+    grid.BoundingBox(100, 100, 200, 200);
+  }
+
+  NodeContainer nodes = NodeContainer::GetGlobal();
+  for (uint32_t i = 0; i < nodes.GetN(); i++) {
+    if (Names::FindName(nodes.Get(i)).empty()) {
+      Names::Add("node" + std::to_string(i), nodes.Get(i));
+    }
+  }
+
+  double beginRealTime = now();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  double stackRealTime = now();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOriginsForAll();
+
+  ndn::FibHelper::SetUseCommandInterests(m_useCommands);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  double calculateRealTime = now();
+
+  // let NFD process management commands (no-op in direct mode)
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  double endRealTime = now();
+
+  uint64_t fibCount = 0;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    fibCount += (*node)->GetObject<ndn::L3Protocol>()->getForwarder()->getFib().size();
+  }
+
+  std::cout << "Mode\t" << (m_useCommands ? "command-interests" : "direct") << "\n"
+            << "Nodes\t" << nodes.GetN() << "\n"
+            << "FibEntries\t" << fibCount << "\n"
+            << "StackInstallTime\t" << stackRealTime - beginRealTime << "s\n"
+            << "CalculateRoutesTime\t" << calculateRealTime - stackRealTime << "s\n"
+            << "RouteSetupTime\t" << endRealTime - stackRealTime << "s\n"
+            << "Memory\t" << MemUsage::Get() / 1024.0 / 1024.0 << "MiB\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::RouteSetupTester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-stack-install.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Benchmark of NDN stack installation in full and forwarding-only modes.
+ *
+ * Builds either a grid topology or a topology read by AnnotatedTopologyReader, installs the
+ * NDN stack on all nodes, and reports the real time it took together with the increase of
+ * process memory (total and per node).  In forwarding-only mode (StackHelper::setForwardingOnly)
+ * the nodes have no NFD management, RIB, and NFD config.
+ *
+ *     ./waf --run "ndn-stack-install --grid-size=100"
+ *     ./waf --run "ndn-stack-install --grid-size=100 --forwarding-only=1"
+ *     ./waf --run "ndn-stack-install --topology=src/ndnSIM/examples/topologies/topo-grid-3x3.txt"
+ */
+class StackInstallTester {
+public:
+  StackInstallTester()
+    : m_gridSize(10)
+    , m_isForwardingOnly(false)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  static double
+  now();
+
+private:
+  uint32_t m_gridSize;
+  bool m_isForwardingOnly;
+  std::string m_topology;
+};
+
+double
+StackInstallTester::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+StackInstallTester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("grid-size", "Size of the grid topology (ignored if topology is set)", m_gridSize);
+  cmd.AddValue("topology", "Annotated topology file", m_topology);
+  cmd.AddValue("forwarding-only", "Install forwarding-only NDN stacks", m_isForwardingOnly);
+  cmd.Parse(argc, argv);
+
+  if (!m_topology.empty()) {
+    AnnotatedTopologyReader topologyReader("", 25);
+    topologyReader.SetFileName(m_topology);
+    topologyReader.Read();
+  }
+  else {
+    PointToPointHelper p2p;
+    PointToPointGridHelper grid(m_gridSize, m_gridSize, p2p);
+    grid.BoundingBox(100, 100, 200, 200);
+  }
+
+  NodeContainer nodes = NodeContainer::GetGlobal();
+
+  int64_t beginMemory = MemUsage::Get();
+  double beginRealTime = now();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setForwardingOnly(m_isForwardingOnly);
+  ndnHelper.InstallAll();
+
+  double endRealTime = now();
+  int64_t endMemory = MemUsage::Get();
+
+  double stackMemory = (endMemory - beginMemory) / 1024.0;
+
+  std::cout << "Mode\t" << (m_isForwardingOnly ? "forwarding-only" : "full") << "\n"
+            << "Nodes\t" << nodes.GetN() << "\n"
+            << "InstallTime\t" << endRealTime - beginRealTime << "s\n"
+            << "InstallTimePerNode\t" << (endRealTime - beginRealTime) * 1000000 / nodes.GetN()
+            << "us\n"
+            << "StackMemory\t" << stackMemory / 1024.0 << "MiB\n"
+            << "StackMemoryPerNode\t" << stackMemory / nodes.GetN() << "KiB\n"
+            << "Memory\t" << endMemory / 1024.0 / 1024.0 << "MiB\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::StackInstallTester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright ( C ) 2020 New Mexico State University- Board of Regents
+ *
+ * See AUTHORS.md for complete list of authors and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * ( at your option ) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "apps/ndn-PEC-name-dispatcher.hpp"
+
+#include "../tests-common.hpp"
+
+#include <functional>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnPecNameDispatcher, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Components)
+{
+  Name name("/prefix/compute/server1/7/obtain/%00%01");
+  BOOST_CHECK(isComponent(name, 1, PECNames::COMPUTE));
+  BOOST_CHECK(isComponent(name, -2, PECNames::OBTAIN));
+  BOOST_CHECK(!isComponent(name, -1, PECNames::OBTAIN));
+  BOOST_CHECK(!isComponent(name, 6, PECNames::COMPUTE));
+  BOOST_CHECK(!isComponent(name, -7, PECNames::COMPUTE));
+  BOOST_CHECK(!isComponent(Name(), 0, PECNames::SERVICE));
+
+  BOOST_CHECK_EQUAL(Name("/prefix").append(PECNames::BASE_QUERY), Name("/prefix/baseQuery"));
+  BOOST_CHECK_EQUAL(PECNames::UPDATE, name::Component("update"));
+}
+
+BOOST_AUTO_TEST_CASE(Patterns)
+{
+  NamePattern compute = NamePattern().at(1, PECNames::COMPUTE);
+  BOOST_CHECK(compute.match("/prefix/compute"));
+  BOOST_CHECK(!compute.match("/compute"));
+  BOOST_CHECK(!compute.match("/prefix/service/compute"));
+
+  NamePattern update = NamePattern().at(1, PECNames::UPDATE).atLeast(4);
+  BOOST_CHECK(!update.match("/prefix/update/server"));
+  BOOST_CHECK(update.match("/prefix/update/server/1"));
+
+  NamePattern obtain = NamePattern().at(1, PECNames::COMPUTE).at(-2, PECNames::OBTAIN);
+  BOOST_CHECK(obtain.match("/prefix/compute/s/1/obtain/5"));
+  BOOST_CHECK(!obtain.match("/prefix/compute/s/1/5"));
+  BOOST_CHECK(!obtain.match("/prefix/obtain/s/1/obtain/5"));
+  // both constraints refer to the same component
+  BOOST_CHECK(!obtain.match("/prefix/compute/5"));
+  BOOST_CHECK(!NamePattern().at(-3, PECNames::OBTAIN).match("/obtain/5"));
+}
+
+BOOST_AUTO_TEST_CASE(Dispatch)
+{
+  std::vector<std::string> calls;
+  NameDispatcher<std::function<void(const std::string&)>> dispatcher;
+  dispatcher.add(NamePattern().at(1, PECNames::COMPUTE).at(-2, PECNames::OBTAIN),
+                 [&calls] (const std::string& arg) { calls.push_back("obtain " + arg); });
+  dispatcher.add(NamePattern().at(1, PECNames::COMPUTE),
+                 [&calls] (const std::string& arg) { calls.push_back("compute " + arg); });
+  dispatcher.add(NamePattern().at(1, PECNames::SERVICE),
+                 [&calls] (const std::string& arg) { calls.push_back("service " + arg); });
+
+  BOOST_CHECK(dispatcher.dispatch("/prefix/compute/s/1/obtain/5", "a"));
+  BOOST_CHECK(dispatcher.dispatch("/prefix/compute/s/1/5", "b"));
+  BOOST_CHECK(dispatcher.dispatch("/prefix/service/1/5", "c"));
+  BOOST_CHECK(!dispatcher.dispatch("/prefix/input/1/5", "d"));
+  BOOST_CHECK(!dispatcher.dispatch("/", "e"));
+
+  BOOST_REQUIRE_EQUAL(calls.size(), 3);
+  BOOST_CHECK_EQUAL(calls[0], "obtain a");
+  BOOST_CHECK_EQUAL(calls[1], "compute b");
+  BOOST_CHECK_EQUAL(calls[2], "service c");
+
+  BOOST_CHECK(dispatcher.find("/prefix/update/1") == nullptr);
+  BOOST_CHECK(dispatcher.find("/prefix/compute") != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ServerClassification)
+{
+  // Interest routes of PECServer
+  NameDispatcher<std::function<std::string()>> dispatcher;
+  dispatcher.add(NamePattern().at(1, PECNames::COMPUTE).at(-1, PECNames::OBTAIN),
+                 [] { return std::string("empty"); });
+  dispatcher.add(NamePattern().at(1, PECNames::COMPUTE),
+                 [] { return std::string("compute"); });
+  dispatcher.add(NamePattern().at(1, PECNames::BASE_QUERY),
+                 [] { return std::string("baseQuery"); });
+
+  // classification of PECServer::OnInterest before the dispatcher
+  auto original = [] (const Name& name) -> std::string {
+    if (name.getSubName(1, 1) == "/compute" && name.getSubName(-1, 1) != "obtain") {
+      return "compute";
+    }
+    if (name.getSubName(1, 1) == "/baseQuery") {
+      return "baseQuery";
+    }
+    if (name.getSubName(1, 1) == "/compute") {
+      return "empty";
+    }
+    return "service";
+  };
+
+  for (const Name& name : {Name("/prefix/compute/server1/7/%00%01"),
+                           Name("/prefix/compute/server1/7/obtain/%00%01"),
+                           Name("/prefix/compute/server1/obtain"),
+                           Name("/prefix/compute"),
+                           Name("/prefix/baseQuery/station/%00%02"),
+                           Name("/prefix/service/7/%00%03"),
+                           Name("/prefix/update/server/1/%00%04"),
+                           Name("/compute"),
+                           Name()}) {
+    const auto* handler = dispatcher.find(name);
+    BOOST_CHECK_EQUAL(handler == nullptr ? "service" : (*handler)(), original(name));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-PEC-server-state.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(AppsNdnPecServerState)
+
+BOOST_AUTO_TEST_CASE(ParseServices)
+{
+  uint64_t services = ServerState::parseServices("1 2 3");
+  BOOST_CHECK_EQUAL(services, 0x0E);
+
+  ServerState state("/server0", 40, services);
+  BOOST_CHECK(state.hasService(1));
+  BOOST_CHECK(state.hasService(3));
+  BOOST_CHECK(!state.hasService(0));
+  BOOST_CHECK(!state.hasService(4));
+  BOOST_CHECK(!state.hasService(1000));
+
+  BOOST_CHECK_EQUAL(ServerState::parseServices(""), 0);
+}
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  ServerState state("/server12", 73, ServerState::parseServices("2 5"));
+  Block wire = state.wireEncode();
+  BOOST_CHECK_EQUAL(wire.type(), ServerState::TLV_SERVER_STATE);
+
+  ServerState decoded(wire);
+  BOOST_CHECK_EQUAL(decoded.getServerId(), "/server12");
+  BOOST_CHECK_EQUAL(decoded.getUtilization(), 73);
+  BOOST_CHECK_EQUAL(decoded.getServices(), state.getServices());
+
+  BOOST_CHECK_THROW(ServerState(::ndn::makeEmptyBlock(::ndn::tlv::Content)), ::ndn::tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(List)
+{
+  std::vector<Block> records;
+  records.push_back(ServerState("/server0", 0, 0x02).wireEncode());
+  records.push_back(ServerState("/server1", 150, 0x0C).wireEncode());
+
+  auto buffer = ServerState::concatenate(records);
+  std::vector<ServerState> states = ServerState::decodeList(buffer->data(), buffer->size());
+  BOOST_REQUIRE_EQUAL(states.size(), 2);
+  BOOST_CHECK_EQUAL(states[0].getServerId(), "/server0");
+  BOOST_CHECK_EQUAL(states[1].getServerId(), "/server1");
+  BOOST_CHECK_EQUAL(states[1].getUtilization(), 150);
+
+  BOOST_CHECK(ServerState::decodeList(buffer->data(), 0).empty());
+  BOOST_CHECK_THROW(ServerState::decodeList(buffer->data(), buffer->size() - 1), ::ndn::tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Encoder)
+{
+  for (const std::string& serverId : {std::string("/server3"), std::string(300, 's')}) {
+    ServerStateEncoder encoder;
+    encoder.setServer(serverId, 0x0E);
+    for (uint32_t utilization : {0u, 100u, 255u, 256u, 65535u, 65536u, 0xFFFFFFFFu}) {
+      Block expected = ServerState(serverId, utilization, 0x0E).wireEncode();
+      auto actual = encoder.encode(utilization);
+      BOOST_CHECK_EQUAL_COLLECTIONS(actual.first, actual.first + actual.second,
+                                    expected.begin(), expected.end());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ToUtilization)
+{
+  BOOST_CHECK_EQUAL(ServerState::toUtilization(42.7), 42);
+  BOOST_CHECK_EQUAL(ServerState::toUtilization(-12.5), 0);
+  BOOST_CHECK_EQUAL(ServerState::toUtilization(1e12), 0xFFFFFFFF);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
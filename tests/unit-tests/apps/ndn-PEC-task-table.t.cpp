@@ -0,0 +1,184 @@
+/*
+ * Copyright ( C ) 2020 New Mexico State University- Board of Regents
+ *
+ * See AUTHORS.md for complete list of authors and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * ( at your option ) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "apps/ndn-PEC-task-table.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class PECTaskTableFixture : public CleanupFixture
+{
+public:
+  void
+  recordSize()
+  {
+    sizes.push_back(tasks.size());
+  }
+
+  void
+  compute(const Name& dataName)
+  {
+    PECTaskTable::Task* task = tasks.findByData(dataName);
+    BOOST_REQUIRE(task != nullptr);
+    tasks.setState(*task, PECTaskTable::COMPUTING);
+  }
+
+  void
+  queue(const Name& dataName)
+  {
+    PECTaskTable::Task* task = tasks.findByData(dataName);
+    BOOST_REQUIRE(task != nullptr);
+    tasks.setState(*task, PECTaskTable::QUEUED);
+  }
+
+  void
+  computed(const Name& dataName)
+  {
+    PECTaskTable::Task* task = tasks.findByData(dataName);
+    BOOST_REQUIRE(task != nullptr);
+    tasks.setState(*task, PECTaskTable::COMPUTED);
+  }
+
+public:
+  PECTaskTable tasks;
+  std::vector<size_t> sizes;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnPecTaskTable, PECTaskTableFixture)
+
+BOOST_AUTO_TEST_CASE(Lookup)
+{
+  PECTaskTable::Task& task = tasks.insert("/prefix/input/1", "/prefix/compute/s/1/obtain/5", 25);
+  PECTaskTable::TaskId id = task.id;
+  BOOST_CHECK_EQUAL(task.state, PECTaskTable::WAITING_INPUT);
+  BOOST_CHECK_EQUAL(tasks.find(id), &task);
+  BOOST_CHECK_EQUAL(tasks.findByInput("/prefix/input/1"), &task);
+  BOOST_CHECK_EQUAL(tasks.findByData("/prefix/compute/s/1/obtain/5"), &task);
+  BOOST_CHECK(tasks.findByInput("/prefix/input/2") == nullptr);
+  BOOST_CHECK_EQUAL(tasks.getPromisedUtil(), 25);
+
+  // a new request of the same client replaces the task that still waits for input
+  PECTaskTable::Task& other = tasks.insert("/prefix/input/1", "/prefix/compute/s/1/obtain/6", 20);
+  BOOST_CHECK(tasks.find(id) == nullptr);
+  BOOST_CHECK(tasks.findByData("/prefix/compute/s/1/obtain/5") == nullptr);
+  BOOST_CHECK_EQUAL(tasks.size(), 1);
+  BOOST_CHECK_EQUAL(tasks.getPromisedUtil(), 20);
+  tasks.insert("/prefix/input/2", "/prefix/compute/s/2/obtain/1", 30);
+  BOOST_CHECK_EQUAL(tasks.getPromisedUtil(), 50);
+
+  // once input is complete, the task can only be found by data name and no longer holds its
+  // promised utilization
+  tasks.setState(other, PECTaskTable::COMPUTING);
+  BOOST_CHECK(tasks.findByInput("/prefix/input/1") == nullptr);
+  BOOST_CHECK_EQUAL(tasks.findByData("/prefix/compute/s/1/obtain/6"), &other);
+  BOOST_CHECK_EQUAL(tasks.getPromisedUtil(), 30);
+
+  tasks.insert("/prefix/input/1", "/prefix/compute/s/1/obtain/7", 15);
+  BOOST_CHECK_EQUAL(tasks.size(), 3);
+  BOOST_CHECK_EQUAL(tasks.getPromisedUtil(), 45);
+
+  tasks.erase(other);
+  BOOST_CHECK(tasks.findByData("/prefix/compute/s/1/obtain/6") == nullptr);
+  BOOST_CHECK_EQUAL(tasks.size(), 2);
+
+  tasks.erase(*tasks.findByInput("/prefix/input/2"));
+  tasks.erase(*tasks.findByInput("/prefix/input/1"));
+  BOOST_CHECK_EQUAL(tasks.getPromisedUtil(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Queue)
+{
+  std::vector<PECTaskTable::TaskId> ids;
+  for (int i = 0; i < 100; ++i) {
+    PECTaskTable::Task& task = tasks.insert(Name("/prefix/input").appendNumber(i),
+                                            Name("/prefix/obtain").appendNumber(i), 0);
+    tasks.setState(task, PECTaskTable::QUEUED);
+    ids.push_back(task.id);
+  }
+  BOOST_CHECK_EQUAL(tasks.getNQueued(), 100);
+
+  // erased tasks are skipped
+  for (int i = 0; i < 100; i += 2) {
+    tasks.erase(*tasks.find(ids[i]));
+  }
+  BOOST_CHECK_EQUAL(tasks.getNQueued(), 50);
+
+  PECTaskTable::Task* task = tasks.popQueued();
+  BOOST_REQUIRE(task != nullptr);
+  BOOST_CHECK_EQUAL(task->id, ids[1]);
+  BOOST_CHECK_EQUAL(task->state, PECTaskTable::QUEUED);
+  BOOST_CHECK_EQUAL(tasks.getNQueued(), 49);
+
+  // a task that is queued again goes to the back
+  tasks.setState(*task, PECTaskTable::QUEUED);
+  for (int i = 3; i < 100; i += 2) {
+    task = tasks.popQueued();
+    BOOST_REQUIRE(task != nullptr);
+    BOOST_CHECK_EQUAL(task->id, ids[i]);
+    tasks.setState(*task, PECTaskTable::COMPUTING);
+  }
+  task = tasks.popQueued();
+  BOOST_REQUIRE(task != nullptr);
+  BOOST_CHECK_EQUAL(task->id, ids[1]);
+
+  BOOST_CHECK(tasks.popQueued() == nullptr);
+  BOOST_CHECK_EQUAL(tasks.getNQueued(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Expiry)
+{
+  tasks.setLifetime(Seconds(2));
+
+  tasks.insert("/prefix/input/1", "/obtain/1", 10); // input is lost
+  tasks.insert("/prefix/input/2", "/obtain/2", 10); // result is never obtained
+  tasks.insert("/prefix/input/3", "/obtain/3", 10); // still computing
+  tasks.insert("/prefix/input/4", "/obtain/4", 10); // waits for utilization
+  Simulator::Schedule(Seconds(1), &PECTaskTableFixture::compute, this, "/obtain/2");
+  Simulator::Schedule(Seconds(1), &PECTaskTableFixture::compute, this, "/obtain/3");
+  Simulator::Schedule(Seconds(1), &PECTaskTableFixture::queue, this, "/obtain/4");
+  Simulator::Schedule(Seconds(2), &PECTaskTableFixture::computed, this, "/obtain/2");
+
+  Simulator::Schedule(MilliSeconds(1500), &PECTaskTableFixture::recordSize, this);
+  Simulator::Schedule(MilliSeconds(2500), &PECTaskTableFixture::recordSize, this);
+  Simulator::Schedule(MilliSeconds(3500), &PECTaskTableFixture::recordSize, this);
+  Simulator::Schedule(MilliSeconds(4500), &PECTaskTableFixture::recordSize, this);
+  Simulator::Schedule(Seconds(100), &PECTaskTableFixture::recordSize, this);
+
+  Simulator::Stop(Seconds(200));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(sizes.size(), 5);
+  BOOST_CHECK_EQUAL(sizes[0], 4);
+  BOOST_CHECK_EQUAL(sizes[1], 3);
+  BOOST_CHECK_EQUAL(sizes[2], 3);
+  BOOST_CHECK_EQUAL(sizes[3], 2);
+  BOOST_CHECK_EQUAL(sizes[4], 2);
+
+  BOOST_CHECK(tasks.findByData("/obtain/3") != nullptr);
+  BOOST_CHECK(tasks.findByData("/obtain/4") != nullptr);
+  BOOST_CHECK_EQUAL(tasks.getNQueued(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -44,7 +44,8 @@ namespace ndn {
 
 BOOST_FIXTURE_TEST_SUITE(HelperLfidRoutingHelper, CleanupFixture)
 
-BOOST_AUTO_TEST_CASE(CalculateRouteAbilene)
+static int
+calculateAbileneRoutes()
 {
   AnnotatedTopologyReader topologyReader;
   topologyReader.SetFileName("src/ndnSIM/examples/topologies/topo-abilene.txt");
@@ -118,7 +119,19 @@ BOOST_AUTO_TEST_CASE(CalculateRouteAbilene)
     }
   }
 
-  BOOST_CHECK_EQUAL(numNexthops, 226);
+  return numNexthops;
+}
+
+BOOST_AUTO_TEST_CASE(CalculateRouteAbilene)
+{
+  BOOST_CHECK_EQUAL(calculateAbileneRoutes(), 226);
+}
+
+BOOST_AUTO_TEST_CASE(CalculateRouteAbileneParallel)
+{
+  ndn::GlobalRoutingHelper::SetNumberOfThreads(4);
+  BOOST_CHECK_EQUAL(calculateAbileneRoutes(), 226);
+  ndn::GlobalRoutingHelper::SetNumberOfThreads(1);
 }
 
 
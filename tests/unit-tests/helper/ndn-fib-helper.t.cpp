@@ -18,6 +18,10 @@
  **/
 
 #include "helper/ndn-fib-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "daemon/fw/forwarder.hpp"
+#include "daemon/table/fib.hpp"
 
 #include "../tests-common.hpp"
 
@@ -47,6 +51,9 @@ public:
 
   ~AddRouteFixture()
   {
+    // restored here, so that a failing test case does not leave it set for the following ones
+    FibHelper::SetUseCommandInterests(false);
+
     Simulator::Stop(Seconds(20.101));
     Simulator::Run();
 
@@ -97,8 +104,51 @@ BOOST_AUTO_TEST_CASE(Helper4)
   FibHelper::AddRoute(getNode("1"), Name("/prefix"), getNode("2"), 10);
 }
 
+// static void
+// AddRoutes(Ptr<Node> node, const std::vector<RouteSpec>& routes);
+BOOST_AUTO_TEST_CASE(Bulk)
+{
+  FibHelper::AddRoutes(getNode("1"), {{Name("/prefix"), getFace("1", "2"), 1},
+                                      {Name("/other"), getFace("1", "2"), 2}});
+
+  const auto& fib = getNode("1")->GetObject<L3Protocol>()->getForwarder()->getFib();
+  BOOST_REQUIRE(fib.findExactMatch("/prefix") != nullptr);
+  BOOST_CHECK_EQUAL(fib.findExactMatch("/prefix")->getNextHops().size(), 1);
+  BOOST_REQUIRE(fib.findExactMatch("/other") != nullptr);
+  BOOST_CHECK_EQUAL(fib.findExactMatch("/other")->getNextHops().front().getCost(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(CommandInterests)
+{
+  FibHelper::SetUseCommandInterests(true);
+  FibHelper::AddRoutes(getNode("1"), {{Name("/prefix"), getFace("1", "2"), 1}});
+
+  // the command is processed only when the simulation runs
+  const auto& fib = getNode("1")->GetObject<L3Protocol>()->getForwarder()->getFib();
+  BOOST_CHECK(fib.findExactMatch("/prefix") == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // AddRoute
 
+BOOST_FIXTURE_TEST_SUITE(RemoveRoute, ScenarioHelperWithCleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Direct)
+{
+  createTopology({
+      {"1", "2"}
+    });
+
+  FibHelper::AddRoute(getNode("1"), Name("/prefix"), getFace("1", "2"), 1);
+
+  const auto& fib = getNode("1")->GetObject<L3Protocol>()->getForwarder()->getFib();
+  BOOST_CHECK(fib.findExactMatch("/prefix") != nullptr);
+
+  FibHelper::RemoveRoute(getNode("1"), Name("/prefix"), getFace("1", "2"));
+  BOOST_CHECK(fib.findExactMatch("/prefix") == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // RemoveRoute
+
 BOOST_AUTO_TEST_SUITE_END() // HelperNdnFibHelper
 
 } // namespace ndn
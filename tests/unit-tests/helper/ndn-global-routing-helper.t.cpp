@@ -18,6 +18,9 @@
  **/
 
 #include "helper/ndn-global-routing-helper.hpp"
+#include "helper/ndn-global-routing-graph.hpp"
+#include "helper/ndn-dynamic-shortest-paths.hpp"
+#include "helper/ndn-link-control-helper.hpp"
 #include "helper/ndn-stack-helper.hpp"
 
 #include "model/ndn-global-router.hpp"
@@ -37,6 +40,10 @@
 
 #include <boost/filesystem.hpp>
 
+#include <map>
+#include <set>
+#include <sstream>
+
 namespace ns3 {
 namespace ndn {
 
@@ -190,6 +197,379 @@ BOOST_AUTO_TEST_CASE(CalculateRoutesBasedOnLinkDelay)
   }
 }
 
+BOOST_AUTO_TEST_CASE(GraphShortestPaths)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A4  NA  1 1 1\n"
+        << "B4  NA  80  -40 1\n"
+        << "C4  NA  80  40  1\n"
+        << "D4  NA  80  80  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A4      B4  10Mbps    100 1ms 100\n"
+        << "A4      C4  10Mbps    500  1ms 100\n"
+        << "B4      C4  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  GlobalRoutingGraph graph;
+  BOOST_CHECK_EQUAL(graph.getNVertices(), 4);
+  BOOST_CHECK_EQUAL(graph.getNEdges(), 6);
+
+  auto vertex = [&graph] (const std::string& name) {
+    return graph.getVertex(Names::Find<Node>(name)->GetObject<GlobalRouter>());
+  };
+
+  GlobalRoutingGraph::ShortestPaths paths;
+  graph.calculateShortestPaths(vertex("A4"), paths);
+
+  BOOST_CHECK_EQUAL(paths.distance[vertex("A4")], 0);
+  BOOST_CHECK_EQUAL(paths.distance[vertex("B4")], 100);
+  BOOST_CHECK_EQUAL(paths.distance[vertex("C4")], 101);
+  BOOST_CHECK_EQUAL(paths.distance[vertex("D4")], GlobalRoutingGraph::INFINITE_DISTANCE);
+
+  BOOST_CHECK_EQUAL(paths.firstHop[vertex("A4")], GlobalRoutingGraph::INVALID_EDGE);
+  BOOST_CHECK_EQUAL(paths.firstHop[vertex("D4")], GlobalRoutingGraph::INVALID_EDGE);
+  BOOST_REQUIRE_NE(paths.firstHop[vertex("C4")], GlobalRoutingGraph::INVALID_EDGE);
+  BOOST_CHECK_EQUAL(paths.firstHop[vertex("C4")], paths.firstHop[vertex("B4")]);
+
+  auto transport = dynamic_cast<NetDeviceTransport*>(graph.getFace(paths.firstHop[vertex("C4")])->getTransport());
+  BOOST_REQUIRE(transport != nullptr);
+  BOOST_CHECK_EQUAL(Names::FindName(transport->GetNetDevice()->GetChannel()->GetDevice(1)->GetNode()), "B4");
+}
+
+BOOST_AUTO_TEST_CASE(GraphWeightOverlay)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A5  NA  1 1 1\n"
+        << "B5  NA  80  -40 1\n"
+        << "C5  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A5      B5  10Mbps    100 1ms 100\n"
+        << "A5      C5  10Mbps    500  1ms 100\n"
+        << "B5      C5  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  GlobalRoutingGraph graph;
+  auto vertex = [&graph] (const std::string& name) {
+    return graph.getVertex(Names::Find<Node>(name)->GetObject<GlobalRouter>());
+  };
+
+  // disable A5-B5 for paths from A5
+  GlobalRoutingGraph::WeightOverlay overlay;
+  overlay.vertex = vertex("A5");
+  GlobalRoutingGraph::Edge first, last;
+  std::tie(first, last) = graph.getOutEdges(overlay.vertex);
+  for (GlobalRoutingGraph::Edge e = first; e < last; e++) {
+    overlay.weights.push_back(graph.getTarget(e) == vertex("B5") ? 65534 : graph.getWeight(e));
+  }
+
+  GlobalRoutingGraph::ShortestPaths paths;
+  graph.calculateShortestPaths(vertex("A5"), paths, overlay);
+  BOOST_CHECK_EQUAL(paths.distance[vertex("C5")], 500);
+  BOOST_CHECK_EQUAL(paths.distance[vertex("B5")], 501);
+  BOOST_CHECK_EQUAL(paths.firstHop[vertex("B5")], paths.firstHop[vertex("C5")]);
+
+  // overlay of A5 does not apply to other sources
+  graph.calculateShortestPaths(vertex("B5"), paths, overlay);
+  BOOST_CHECK_EQUAL(paths.distance[vertex("A5")], 100);
+
+  // snapshot weights are unchanged
+  graph.calculateShortestPaths(vertex("A5"), paths);
+  BOOST_CHECK_EQUAL(paths.distance[vertex("C5")], 101);
+}
+
+static std::set<std::string>
+dumpFibs()
+{
+  std::set<std::string> entries;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    for (const auto& entry : (*node)->GetObject<L3Protocol>()->getForwarder()->getFib()) {
+      for (const auto& nextHop : entry.getNextHops()) {
+        std::ostringstream os;
+        os << (*node)->GetId() << " " << entry.getPrefix() << " " << nextHop.getFace().getId()
+           << " " << nextHop.getCost();
+        entries.insert(os.str());
+      }
+    }
+  }
+  return entries;
+}
+
+BOOST_AUTO_TEST_CASE(CalculateRoutesInParallel)
+{
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(6, 6, p2p);
+  grid.BoundingBox(100, 100, 200, 200);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  NodeContainer nodes = NodeContainer::GetGlobal();
+  for (uint32_t i = 0; i < nodes.GetN(); i++) {
+    Names::Add("node" + std::to_string(i), nodes.Get(i));
+  }
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOriginsForAll();
+
+  GlobalRoutingHelper::CalculateAllPossibleRoutes();
+  std::set<std::string> serial = dumpFibs();
+  BOOST_CHECK_GT(serial.size(), nodes.GetN() * (nodes.GetN() - 1));
+
+  // the same routes again on worker threads must not add or change any next hop
+  GlobalRoutingHelper::SetNumberOfThreads(4);
+  GlobalRoutingHelper::CalculateAllPossibleRoutes();
+  GlobalRoutingHelper::CalculateRoutes();
+  GlobalRoutingHelper::SetNumberOfThreads(1);
+
+  BOOST_CHECK(dumpFibs() == serial);
+}
+
+static std::map<std::string, uint64_t>
+getNextHops(const std::string& nodeName, const Name& prefix)
+{
+  std::map<std::string, uint64_t> nextHops;
+  auto& fib = Names::Find<Node>(nodeName)->GetObject<L3Protocol>()->getForwarder()->getFib();
+  const nfd::fib::Entry* entry = fib.findExactMatch(prefix);
+  if (entry == nullptr) {
+    return nextHops;
+  }
+  for (const auto& nextHop : entry->getNextHops()) {
+    auto transport = dynamic_cast<NetDeviceTransport*>(nextHop.getFace().getTransport());
+    BOOST_REQUIRE(transport != nullptr);
+    Ptr<Channel> channel = transport->GetNetDevice()->GetChannel();
+    Ptr<Node> other = channel->GetDevice(0)->GetNode();
+    if (other == Names::Find<Node>(nodeName)) {
+      other = channel->GetDevice(1)->GetNode();
+    }
+    nextHops[Names::FindName(other)] = nextHop.getCost();
+  }
+  return nextHops;
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalRoutes)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A6  NA  1 1 1\n"
+        << "B6  NA  80  -40 1\n"
+        << "C6  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A6      B6  10Mbps    1 1ms 100\n"
+        << "A6      C6  10Mbps    10  1ms 100\n"
+        << "B6      C6  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C6"));
+
+  GlobalRoutingHelper::SetIncrementalRouting(true);
+  GlobalRoutingHelper::CalculateRoutes();
+
+  using NextHops = std::map<std::string, uint64_t>;
+  BOOST_CHECK(getNextHops("A6", "/prefix") == (NextHops{{"B6", 2}}));
+  BOOST_CHECK(getNextHops("B6", "/prefix") == (NextHops{{"C6", 1}}));
+
+  // no route to /prefix uses A6 -- C6
+  Ptr<Channel> unusedChannel;
+  Ptr<Node> a6 = Names::Find<Node>("A6");
+  for (uint32_t i = 0; i < a6->GetNDevices(); i++) {
+    Ptr<Channel> channel = a6->GetDevice(i)->GetChannel();
+    if (channel != nullptr && (channel->GetDevice(0)->GetNode() == Names::Find<Node>("C6") ||
+                               channel->GetDevice(1)->GetNode() == Names::Find<Node>("C6"))) {
+      unusedChannel = channel;
+    }
+  }
+  BOOST_REQUIRE(unusedChannel != nullptr);
+  BOOST_CHECK_EQUAL(GlobalRoutingHelper::UpdateLinkState(unusedChannel, false), 0);
+  BOOST_CHECK_EQUAL(GlobalRoutingHelper::UpdateLinkState(unusedChannel, true), 0);
+
+  // A6 switches to the direct link, B6 switches to A6 -> C6
+  LinkControlHelper::FailLinkByName("B6", "C6");
+  BOOST_CHECK(getNextHops("A6", "/prefix") == (NextHops{{"C6", 10}}));
+  BOOST_CHECK(getNextHops("B6", "/prefix") == (NextHops{{"A6", 11}}));
+
+  LinkControlHelper::UpLinkByName("B6", "C6");
+  BOOST_CHECK(getNextHops("A6", "/prefix") == (NextHops{{"B6", 2}}));
+  BOOST_CHECK(getNextHops("B6", "/prefix") == (NextHops{{"C6", 1}}));
+
+  GlobalRoutingHelper::SetIncrementalRouting(false);
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalRoutesAnycast)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A7  NA  1 1 1\n"
+        << "B7  NA  80  -40 1\n"
+        << "C7  NA  80  40  1\n"
+        << "D7  NA  160  -40 1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A7      B7  10Mbps    1 1ms 100\n"
+        << "A7      C7  10Mbps    10  1ms 100\n"
+        << "B7      C7  10Mbps    1 1ms 100\n"
+        << "B7      D7  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C7"));
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("D7"));
+
+  GlobalRoutingHelper::SetIncrementalRouting(true);
+  GlobalRoutingHelper::CalculateRoutes();
+
+  using NextHops = std::map<std::string, uint64_t>;
+  BOOST_CHECK(getNextHops("A7", "/prefix") == (NextHops{{"B7", 2}}));
+  BOOST_CHECK(getNextHops("B7", "/prefix") == (NextHops{{"C7", 1}, {"D7", 1}}));
+
+  // A7 reaches C7 over the direct link, but still reaches D7 through B7
+  LinkControlHelper::FailLinkByName("B7", "C7");
+  BOOST_CHECK(getNextHops("A7", "/prefix") == (NextHops{{"B7", 2}, {"C7", 10}}));
+  BOOST_CHECK(getNextHops("B7", "/prefix") == (NextHops{{"A7", 11}, {"D7", 1}}));
+
+  LinkControlHelper::UpLinkByName("B7", "C7");
+  BOOST_CHECK(getNextHops("A7", "/prefix") == (NextHops{{"B7", 2}}));
+  BOOST_CHECK(getNextHops("B7", "/prefix") == (NextHops{{"C7", 1}, {"D7", 1}}));
+
+  GlobalRoutingHelper::SetIncrementalRouting(false);
+}
+
+BOOST_AUTO_TEST_CASE(CalculateRoutesWithLargeCosts)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A8  NA  1 1 1\n"
+        << "B8  NA  80  -40 1\n"
+        << "C8  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A8      B8  10Mbps    40000 1ms 100\n"
+        << "B8      C8  10Mbps    40000 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C8"));
+
+  GlobalRoutingHelper::CalculateRoutes();
+
+  // paths of cost 65535 or more are not unreachable
+  using NextHops = std::map<std::string, uint64_t>;
+  BOOST_CHECK(getNextHops("A8", "/prefix") == (NextHops{{"B8", 80000}}));
+  BOOST_CHECK(getNextHops("B8", "/prefix") == (NextHops{{"C8", 40000}}));
+}
+
+BOOST_AUTO_TEST_CASE(DynamicShortestPathsMatchFullCalculation)
+{
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(5, 5, p2p);
+  grid.BoundingBox(100, 100, 200, 200);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  GlobalRoutingGraph graph;
+  std::vector<GlobalRoutingGraph::Vertex> sources;
+  for (GlobalRoutingGraph::Vertex v = 0; v < graph.getNVertices(); v++) {
+    sources.push_back(v);
+  }
+
+  DynamicShortestPaths paths(graph, sources);
+  GlobalRoutingGraph::ShortestPaths workspace;
+  for (size_t i = 0; i < sources.size(); i++) {
+    paths.calculate(i, workspace);
+  }
+
+  // fail every third edge, change weights of some others, then restore everything
+  std::vector<std::pair<GlobalRoutingGraph::Edge, GlobalRoutingGraph::Distance>> steps;
+  for (GlobalRoutingGraph::Edge e = 0; e < graph.getNEdges(); e += 3) {
+    steps.emplace_back(e, GlobalRoutingGraph::INFINITE_DISTANCE);
+  }
+  for (GlobalRoutingGraph::Edge e = 1; e < graph.getNEdges(); e += 4) {
+    steps.emplace_back(e, 1 + e % 5);
+  }
+  for (GlobalRoutingGraph::Edge e = 0; e < graph.getNEdges(); e++) {
+    steps.emplace_back(e, graph.getWeight(e));
+  }
+
+  for (const auto& step : steps) {
+    paths.setWeights({step});
+    graph.setWeight(step.first, step.second);
+
+    for (size_t i = 0; i < sources.size(); i++) {
+      graph.calculateShortestPaths(sources[i], workspace);
+      BOOST_REQUIRE(paths.getDistances(i) == workspace.distance);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
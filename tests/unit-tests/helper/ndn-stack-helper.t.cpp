@@ -18,9 +18,13 @@
  **/
 
 #include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-app-helper.hpp"
+#include "helper/ndn-strategy-choice-helper.hpp"
+#include "apps/ndn-app.hpp"
 #include "../tests-common.hpp"
 
 #include "ns3/point-to-point-module.h"
+#include "ns3/csma-module.h"
 
 namespace ns3 {
 namespace ndn {
@@ -62,6 +66,201 @@ BOOST_AUTO_TEST_CASE(TestNfdContentStorePolicy)
   BOOST_CHECK_EQUAL(protoNode1->getForwarder()->getCs().getPolicy()->getName(), "priority_fifo");
 }
 
+BOOST_AUTO_TEST_CASE(ForwardingOnly)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setForwardingOnly();
+  ndnHelper.setCsSize(42);
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.InstallAll();
+
+  Ptr<L3Protocol> protoNode0 = L3Protocol::getL3Protocol(nodes.Get(0));
+  BOOST_CHECK(protoNode0->isForwardingOnly());
+  BOOST_CHECK(protoNode0->getFibManager() == nullptr);
+  BOOST_CHECK_EQUAL(protoNode0->getForwarder()->getCs().getLimit(), 42);
+  BOOST_CHECK_EQUAL(protoNode0->getForwarder()->getCs().getPolicy()->getName(), "lru");
+
+  StrategyChoiceHelper::InstallAll("/prefix", "/localhost/nfd/strategy/multicast");
+  BOOST_CHECK_EQUAL(protoNode0->getForwarder()->getStrategyChoice().findEffectiveStrategy("/prefix")
+                      .getInstanceName().getPrefix(4),
+                    "/localhost/nfd/strategy/multicast");
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", StringValue("10"));
+  consumerHelper.Install(nodes.Get(0)).Stop(Seconds(0.95));
+
+  AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.Install(nodes.Get(1));
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  auto face = protoNode0->getFaceByNetDevice(nodes.Get(0)->GetDevice(0));
+  BOOST_REQUIRE(face != nullptr);
+  BOOST_CHECK_GT(face->getCounters().nOutInterests, 0);
+  BOOST_CHECK_EQUAL(face->getCounters().nInData, face->getCounters().nOutInterests);
+}
+
+static shared_ptr<Face>
+getFace(const NetDeviceContainer& devices, uint32_t i)
+{
+  Ptr<NetDevice> device = devices.Get(i);
+  return L3Protocol::getL3Protocol(device->GetNode())->getFaceByNetDevice(device);
+}
+
+BOOST_AUTO_TEST_CASE(UnicastReplies)
+{
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  CsmaHelper csma;
+  NetDeviceContainer devices = csma.Install(nodes);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setUnicastReplies();
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.InstallAll();
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", StringValue("10"));
+  consumerHelper.Install(nodes.Get(0)).Stop(Seconds(0.95));
+
+  AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.Install(nodes.Get(2));
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  auto consumerFace = getFace(devices, 0);
+  auto otherFace = getFace(devices, 1);
+  auto producerFace = getFace(devices, 2);
+  BOOST_REQUIRE(consumerFace != nullptr && otherFace != nullptr && producerFace != nullptr);
+
+  // Interests are broadcast, and received on the same face they are not forwarded to again
+  BOOST_CHECK_GT(consumerFace->getCounters().nOutInterests, 0);
+  BOOST_CHECK_EQUAL(otherFace->getCounters().nInInterests, consumerFace->getCounters().nOutInterests);
+  BOOST_CHECK_EQUAL(otherFace->getCounters().nOutInterests, 0);
+  BOOST_CHECK_EQUAL(producerFace->getCounters().nInInterests,
+                    consumerFace->getCounters().nOutInterests);
+
+  // Data is sent to the consumer only
+  BOOST_CHECK_EQUAL(producerFace->getCounters().nOutData, producerFace->getCounters().nInInterests);
+  BOOST_CHECK_EQUAL(consumerFace->getCounters().nInData, producerFace->getCounters().nOutData);
+  BOOST_CHECK_EQUAL(otherFace->getCounters().nInData, 0);
+
+  // so are the Nacks of the node without a route
+  BOOST_CHECK_EQUAL(producerFace->getCounters().nInNacks, 0);
+}
+
+BOOST_AUTO_TEST_CASE(UnicastRepliesBroadcastInterests)
+{
+  // all nodes but the producer send Interests on the same segment
+  const uint32_t nNodes = 5;
+  const uint32_t producerId = nNodes - 1;
+
+  NodeContainer nodes;
+  nodes.Create(nNodes);
+
+  CsmaHelper csma;
+  NetDeviceContainer devices = csma.Install(nodes);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setUnicastReplies();
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.InstallAll();
+
+  for (uint32_t i = 0; i < producerId; ++i) {
+    AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix("/prefix/" + std::to_string(i));
+    consumerHelper.SetAttribute("Frequency", StringValue("10"));
+    consumerHelper.Install(nodes.Get(i)).Stop(Seconds(0.95));
+  }
+
+  AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.Install(nodes.Get(producerId));
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  uint64_t nSent = 0;
+  for (uint32_t i = 0; i < nNodes; ++i) {
+    BOOST_REQUIRE(getFace(devices, i) != nullptr);
+    nSent += getFace(devices, i)->getCounters().nOutInterests;
+  }
+  BOOST_CHECK_GT(nSent, 0);
+
+  // Interests are not unicast: every node receives the Interests of all other nodes, so the
+  // Interests each node decodes grow with the number of nodes on the segment
+  for (uint32_t i = 0; i < nNodes; ++i) {
+    auto face = getFace(devices, i);
+    BOOST_CHECK_EQUAL(face->getCounters().nInInterests, nSent - face->getCounters().nOutInterests);
+  }
+}
+
+static size_t g_nReceivedNacks = 0;
+
+static void
+countNack(shared_ptr<const lp::Nack>, Ptr<App>, shared_ptr<Face>)
+{
+  ++g_nReceivedNacks;
+}
+
+BOOST_AUTO_TEST_CASE(UnicastNacks)
+{
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  CsmaHelper csma;
+  NetDeviceContainer devices = csma.Install(nodes);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setUnicastReplies();
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.InstallAll();
+
+  // the other nodes have no route but the one back to the segment
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", StringValue("10"));
+  ApplicationContainer consumer = consumerHelper.Install(nodes.Get(0));
+  consumer.Stop(Seconds(0.95));
+  g_nReceivedNacks = 0;
+  consumer.Get(0)->TraceConnectWithoutContext("ReceivedNacks", MakeCallback(&countNack));
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  auto consumerFace = getFace(devices, 0);
+  BOOST_REQUIRE(consumerFace != nullptr);
+  BOOST_CHECK_GT(consumerFace->getCounters().nOutInterests, 0);
+  BOOST_CHECK_EQUAL(getFace(devices, 1)->getCounters().nOutNacks,
+                    consumerFace->getCounters().nOutInterests);
+
+  // the Nacks reach the consumer through the face its Interests were sent to
+  BOOST_CHECK_EQUAL(consumerFace->getCounters().nInNacks,
+                    2 * consumerFace->getCounters().nOutInterests);
+  BOOST_CHECK_EQUAL(g_nReceivedNacks, consumerFace->getCounters().nOutInterests);
+
+  // and not the other node
+  BOOST_CHECK_EQUAL(getFace(devices, 1)->getCounters().nInNacks, 0);
+  BOOST_CHECK_EQUAL(getFace(devices, 2)->getCounters().nInNacks, 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -160,6 +160,154 @@ BOOST_AUTO_TEST_CASE(PrintLpPacket)
   }
 }
 
+BOOST_AUTO_TEST_CASE(Deserialize)
+{
+  Data data("/other/prefix");
+  data.setContent(std::make_shared< ::ndn::Buffer>(8192));
+  ndn::StackHelper::getKeyChain().sign(data);
+  lp::Packet lpPacket(data.wireEncode());
+  Block wire = lpPacket.wireEncode();
+
+  Ptr<Packet> packet = Create<Packet>();
+  packet->AddHeader(BlockHeader(wire));
+
+  BlockHeader header;
+  BOOST_CHECK_EQUAL(packet->PeekHeader(header), wire.size());
+  BOOST_CHECK(header.getBlock() == wire);
+
+  BOOST_CHECK_EQUAL(packet->RemoveHeader(header), wire.size());
+  BOOST_CHECK(header.getBlock() == wire);
+  BOOST_CHECK_EQUAL(packet->GetSize(), 0);
+
+  // truncated packet
+  Ptr<Packet> truncated = Create<Packet>(wire.wire(), wire.size() - 1);
+  BOOST_CHECK_THROW(truncated->RemoveHeader(header), ::ndn::tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(FindName)
+{
+  Interest interest("/prefix/interest");
+  interest.setNonce(10);
+  Data data("/prefix/data");
+  ndn::StackHelper::getKeyChain().sign(data);
+
+  auto check = [] (const Block& packet, uint32_t expectedType, const Name& expectedName) {
+    uint32_t type = 0;
+    const uint8_t* begin = nullptr;
+    const uint8_t* end = nullptr;
+    BOOST_REQUIRE(BlockHeader::findName(packet, type, begin, end));
+    BOOST_CHECK_EQUAL(type, expectedType);
+    BOOST_CHECK_EQUAL_COLLECTIONS(begin, end, expectedName.wireEncode().value_begin(),
+                                  expectedName.wireEncode().value_end());
+  };
+
+  check(interest.wireEncode(), ::ndn::tlv::Interest, interest.getName());
+  check(data.wireEncode(), ::ndn::tlv::Data, data.getName());
+  check(lp::Packet(data.wireEncode()).wireEncode(), ::ndn::tlv::Data, data.getName());
+
+  lp::Packet lpPacket(interest.wireEncode());
+  lpPacket.add<::ndn::lp::SequenceField>(0);
+  check(lpPacket.wireEncode(), ::ndn::tlv::Interest, interest.getName());
+  lpPacket.add<::ndn::lp::NackField>(::ndn::lp::NackHeader().setReason(::ndn::lp::NackReason::NO_ROUTE));
+  check(lpPacket.wireEncode(), ::ndn::lp::tlv::Nack, interest.getName());
+
+  uint32_t type = 0;
+  const uint8_t* begin = nullptr;
+  const uint8_t* end = nullptr;
+  lpPacket.add<::ndn::lp::FragIndexField>(0);
+  lpPacket.add<::ndn::lp::FragCountField>(1);
+  BOOST_CHECK(BlockHeader::findName(lpPacket.wireEncode(), type, begin, end));
+  lpPacket.set<::ndn::lp::FragCountField>(2);
+  BOOST_CHECK(!BlockHeader::findName(lpPacket.wireEncode(), type, begin, end));
+  BOOST_CHECK(!BlockHeader::findName(lp::Packet().wireEncode(), type, begin, end)); // IDLE
+  BOOST_CHECK(!BlockHeader::findName(Name("/prefix").wireEncode(), type, begin, end));
+}
+
+BOOST_AUTO_TEST_CASE(VirtualPayload)
+{
+  Data data("/other/prefix");
+  data.setContent(std::make_shared< ::ndn::Buffer>(8192));
+  ndn::StackHelper::getKeyChain().sign(data);
+
+  // content that is not marked is copied, even if it consists of zeros
+  {
+    Ptr<Packet> packet = BlockHeader::createPacket(data.wireEncode());
+    BOOST_CHECK_EQUAL(packet->GetSize(), data.wireEncode().size());
+    BOOST_CHECK_GE(packet->GetSerializedSize(), data.wireEncode().size());
+  }
+
+  BlockHeader::markVirtualPayload(data.wireEncode());
+
+  // bare Data and Data in NDNLP packet
+  for (const Block& wire : {data.wireEncode(), lp::Packet(data.wireEncode()).wireEncode()}) {
+    Ptr<Packet> packet = BlockHeader::createPacket(wire);
+    BOOST_CHECK_EQUAL(packet->GetSize(), wire.size());
+    // content is kept in the zero-filled area
+    BOOST_CHECK_LT(packet->GetSerializedSize(), wire.size() - 4096);
+
+    BOOST_CHECK(BlockHeader::extractBlock(packet) == wire);
+
+    BlockHeader header;
+    BOOST_CHECK_EQUAL(packet->PeekHeader(header), wire.size());
+    BOOST_CHECK(header.getBlock() == wire);
+
+    std::vector<uint8_t> bytes(packet->GetSize());
+    packet->CopyData(bytes.data(), bytes.size());
+    BOOST_CHECK_EQUAL_COLLECTIONS(bytes.begin(), bytes.end(), wire.begin(), wire.end());
+  }
+
+  // other Data with the same name is copied
+  auto content = std::make_shared< ::ndn::Buffer>(8192);
+  (*content)[4096] = 1;
+  data.setContent(content);
+  ndn::StackHelper::getKeyChain().sign(data);
+  Block wire = data.wireEncode();
+  Ptr<Packet> packet = BlockHeader::createPacket(wire);
+  BOOST_CHECK_EQUAL(packet->GetSize(), wire.size());
+  BOOST_CHECK_GE(packet->GetSerializedSize(), wire.size());
+  BOOST_CHECK(BlockHeader::extractBlock(packet) == wire);
+
+  // padding after the block is ignored
+  packet->AddPaddingAtEnd(20);
+  BOOST_CHECK(BlockHeader::extractBlock(packet) == wire);
+
+  // truncated packet
+  Ptr<Packet> truncated = Create<Packet>(wire.wire(), wire.size() - 1);
+  BOOST_CHECK_THROW(BlockHeader::extractBlock(truncated), ::ndn::tlv::Error);
+  BOOST_CHECK_THROW(BlockHeader::extractBlock(Create<Packet>()), ::ndn::tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(ForwardVirtualPayload)
+{
+  Data data("/forwarded/prefix");
+  data.setContent(std::make_shared< ::ndn::Buffer>(16384));
+  ndn::StackHelper::getKeyChain().sign(data);
+  Block wire = lp::Packet(data.wireEncode()).wireEncode();
+
+  // a received marked packet is marked again, so the copy sent by the next hop is compact too
+  BlockHeader::markVirtualPayload(data.wireEncode());
+  Block received = BlockHeader::extractBlock(BlockHeader::createPacket(wire));
+
+  ::ndn::Buffer::const_iterator first, last;
+  std::tie(first, last) = lp::Packet(received).get<lp::FragmentField>();
+  lp::Packet forwarded(Block(&*first, std::distance(first, last)));
+  forwarded.add<::ndn::lp::SequenceField>(7);
+  Block forwardedWire = forwarded.wireEncode();
+
+  Ptr<Packet> packet = BlockHeader::createPacket(forwardedWire);
+  BOOST_CHECK_EQUAL(packet->GetSize(), forwardedWire.size());
+  BOOST_CHECK_LT(packet->GetSerializedSize(), forwardedWire.size() - 16000);
+  BOOST_CHECK(BlockHeader::extractBlock(packet) == forwardedWire);
+
+  // Data received without the tag, e.g., over a device that drops packet tags, is not marked
+  Data other("/other/forwarded/prefix");
+  other.setContent(std::make_shared< ::ndn::Buffer>(16384));
+  ndn::StackHelper::getKeyChain().sign(other);
+  Block otherWire = other.wireEncode();
+  Block otherReceived = BlockHeader::extractBlock(Create<Packet>(otherWire.wire(), otherWire.size()));
+  BOOST_CHECK_GE(BlockHeader::createPacket(otherReceived)->GetSerializedSize(), otherWire.size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-cs-tracing-policy.hpp"
+#include "utils/ndn-data-template.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/table/cs.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs-policy-lru.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class CsTracingPolicyFixture : public CleanupFixture
+{
+public:
+  CsTracingPolicyFixture()
+  {
+    hits.ConnectWithoutContext(MakeCallback(&CsTracingPolicyFixture::hit, this));
+    inserts.ConnectWithoutContext(MakeCallback(&CsTracingPolicyFixture::insert, this));
+    evictions.ConnectWithoutContext(MakeCallback(&CsTracingPolicyFixture::evict, this));
+
+    cs.setPolicy(make_unique<CsTracingPolicy>(make_unique<nfd::cs::LruPolicy>(), hits, inserts,
+                                              evictions));
+  }
+
+  void
+  hit(const Data& data)
+  {
+    events.push_back("hit " + data.getName().toUri());
+  }
+
+  void
+  insert(const Data& data)
+  {
+    events.push_back("insert " + data.getName().toUri());
+  }
+
+  void
+  evict(const Data& data)
+  {
+    events.push_back("evict " + data.getName().toUri());
+  }
+
+  void
+  insertData(const Name& name)
+  {
+    cs.insert(*DataTemplate().Create(name, 10));
+  }
+
+  void
+  find(const Name& name)
+  {
+    cs.find(Interest(name), [] (const Interest&, const Data&) {}, [] (const Interest&) {});
+  }
+
+public:
+  CsTracingPolicy::DataTrace hits;
+  CsTracingPolicy::DataTrace inserts;
+  CsTracingPolicy::DataTrace evictions;
+  nfd::cs::Cs cs;
+  std::vector<std::string> events;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnCsTracingPolicy, CsTracingPolicyFixture)
+
+BOOST_AUTO_TEST_CASE(WrappedPolicy)
+{
+  BOOST_CHECK_EQUAL(cs.getPolicy()->getName(), nfd::cs::LruPolicy::POLICY_NAME);
+
+  cs.setLimit(2);
+  insertData("/a/1");
+  insertData("/a/2");
+  find("/a/1");
+  find("/a/3");
+
+  // the wrapped LRU policy evicts the least recently used entry
+  insertData("/b/1");
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+
+  std::vector<std::string> expected = {
+    "insert /a/1", "insert /a/2", "hit /a/1", "insert /b/1", "evict /a/2"
+  };
+  BOOST_CHECK_EQUAL_COLLECTIONS(events.begin(), events.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(SetLimit)
+{
+  insertData("/a/1");
+  insertData("/a/2");
+  insertData("/a/3");
+  events.clear();
+
+  cs.setLimit(1);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+
+  std::vector<std::string> expected = {"evict /a/1", "evict /a/2"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(events.begin(), events.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  insertData("/a/1");
+  insertData("/b/1");
+  events.clear();
+
+  size_t nErased = 0;
+  cs.erase("/a", 10, [&nErased] (size_t n) { nErased = n; });
+  BOOST_CHECK_EQUAL(nErased, 1);
+
+  std::vector<std::string> expected = {"evict /a/1"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(events.begin(), events.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-data-template.hpp"
+#include "model/ndn-block-header.hpp"
+
+#include "ns3/packet.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class DataTemplateFixture : public CleanupFixture
+{
+public:
+  /**
+   * @brief Data built field by field and encoded, as the applications did before DataTemplate
+   */
+  static shared_ptr<Data>
+  encode(const Name& name, const std::vector<uint8_t>& content, Time freshness,
+         uint32_t signatureValue, const Name& keyLocator)
+  {
+    auto data = make_shared<Data>();
+    data->setName(name);
+    data->setFreshnessPeriod(::ndn::time::milliseconds(freshness.GetMilliSeconds()));
+    data->setContent(make_shared< ::ndn::Buffer>(content.begin(), content.end()));
+
+    Signature signature;
+    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+    if (keyLocator.size() > 0) {
+      signatureInfo.setKeyLocator(keyLocator);
+    }
+    signature.setInfo(signatureInfo);
+    signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue,
+                                                          signatureValue));
+    data->setSignature(signature);
+
+    data->wireEncode();
+    return data;
+  }
+
+  static void
+  checkSameWire(const Data& expected, const Data& actual)
+  {
+    BOOST_REQUIRE(actual.hasWire());
+    const Block& expectedWire = expected.wireEncode();
+    const Block& actualWire = actual.wireEncode();
+    BOOST_CHECK_EQUAL_COLLECTIONS(expectedWire.begin(), expectedWire.end(),
+                                  actualWire.begin(), actualWire.end());
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnDataTemplate, DataTemplateFixture)
+
+BOOST_AUTO_TEST_CASE(SameWireAsEncoder)
+{
+  const Name name("/prefix/data/%FE%01");
+  const std::vector<Time> freshnesses = {Seconds(0), MilliSeconds(2500)};
+  const std::vector<Name> keyLocators = {Name(), Name("/unique/key/locator")};
+  const std::vector<size_t> contentSizes = {0, 252, 253, 65536};
+
+  DataTemplate dataTemplate;
+  for (const Time& freshness : freshnesses) {
+    for (const Name& keyLocator : keyLocators) {
+      dataTemplate.SetFields(freshness, 100, keyLocator);
+
+      for (size_t contentSize : contentSizes) {
+        BOOST_TEST_MESSAGE("freshness " << freshness << ", key locator " << keyLocator
+                           << ", content size " << contentSize);
+
+        std::vector<uint8_t> zeros(contentSize);
+        checkSameWire(*encode(name, zeros, freshness, 100, keyLocator),
+                      *dataTemplate.Create(name, contentSize));
+
+        std::vector<uint8_t> content(contentSize);
+        for (size_t i = 0; i < contentSize; i++) {
+          content[i] = static_cast<uint8_t>(i * 7 + 1);
+        }
+        checkSameWire(*encode(name, content, freshness, 100, keyLocator),
+                      *dataTemplate.Create(name, content.data(), content.size()));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ContentElements)
+{
+  std::vector<Block> elements = {
+    ::ndn::makeNonNegativeIntegerBlock(200, 1),
+    ::ndn::makeStringBlock(201, "server"),
+    ::ndn::makeBinaryBlock(202, std::vector<uint8_t>(300, 5).data(), 300)
+  };
+  std::vector<uint8_t> content;
+  for (const auto& element : elements) {
+    content.insert(content.end(), element.begin(), element.end());
+  }
+
+  DataTemplate dataTemplate;
+  dataTemplate.SetFields(MilliSeconds(10), 0, Name());
+  checkSameWire(*encode("/prefix/baseQuery/1", content, MilliSeconds(10), 0, Name()),
+                *dataTemplate.Create("/prefix/baseQuery/1", elements));
+}
+
+BOOST_AUTO_TEST_CASE(VirtualPayloadSize)
+{
+  DataTemplate dataTemplate;
+  dataTemplate.SetFields(Seconds(1), 0, Name());
+  auto expected = encode("/prefix/virtual", std::vector<uint8_t>(8192), Seconds(1), 0, Name());
+  auto data = dataTemplate.Create("/prefix/virtual", 8192);
+
+  // the mark does not change the wire, but the content is carried in the zero-filled area
+  checkSameWire(*expected, *data);
+  Ptr<Packet> packet = BlockHeader::createPacket(data->wireEncode());
+  BOOST_CHECK_EQUAL(packet->GetSize(), expected->wireEncode().size());
+  BOOST_CHECK_LT(packet->GetSerializedSize(), 4096);
+
+  // content given by the application is not marked
+  auto copied = dataTemplate.Create("/prefix/copied", std::vector<uint8_t>(8192).data(), 8192);
+  BOOST_CHECK_GE(BlockHeader::createPacket(copied->wireEncode())->GetSerializedSize(), 8192);
+}
+
+BOOST_AUTO_TEST_CASE(ChangedFields)
+{
+  DataTemplate dataTemplate;
+  dataTemplate.SetFields(Seconds(1), 1, Name("/key"));
+  dataTemplate.SetFields(Seconds(2), 2, Name());
+
+  checkSameWire(*encode("/data", std::vector<uint8_t>(10), Seconds(2), 2, Name()),
+                *dataTemplate.Create("/data", 10));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-retx-tracker.hpp"
+#include "utils/ndn-rtt-mean-deviation.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class RetxTrackerFixture : public CleanupFixture
+{
+public:
+  RetxTrackerFixture()
+    : rtt(CreateObject<RttMeanDeviation>()) // initial retransmit timeout is 1s
+  {
+    tracker.SetRttEstimator(rtt);
+  }
+
+  void
+  timeout(uint32_t seq)
+  {
+    timeouts.push_back(std::make_tuple(seq, Simulator::Now()));
+  }
+
+  void
+  retransmit(uint32_t seq)
+  {
+    timeout(seq);
+    tracker.Sent(seq);
+  }
+
+  void
+  ack(uint32_t seq)
+  {
+    RetxTracker::Delays delays;
+    if (tracker.Acked(seq, delays)) {
+      acks.push_back(std::make_tuple(seq, delays.lastDelay, delays.fullDelay, delays.retxCount));
+    }
+  }
+
+  void
+  recordSize()
+  {
+    sizes.push_back(tracker.GetSize());
+  }
+
+public:
+  Ptr<RttEstimator> rtt;
+  RetxTracker tracker;
+
+  std::vector<std::tuple<uint32_t, Time>> timeouts;
+  std::vector<std::tuple<uint32_t, Time, Time, uint32_t>> acks;
+  std::vector<size_t> sizes;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnRetxTracker, RetxTrackerFixture)
+
+BOOST_AUTO_TEST_CASE(Timeouts)
+{
+  tracker.SetGranularity(MilliSeconds(50));
+  tracker.SetTimeoutCallback(std::bind(&RetxTrackerFixture::timeout, this, std::placeholders::_1));
+
+  Simulator::Schedule(MilliSeconds(10), &RetxTracker::Sent, &tracker, 1);
+  Simulator::Schedule(MilliSeconds(20), &RetxTracker::Sent, &tracker, 2);
+  Simulator::Schedule(MilliSeconds(25), &RetxTracker::Sent, &tracker, 3);
+  Simulator::Schedule(MilliSeconds(1200), &RetxTracker::Sent, &tracker, 4);
+  Simulator::Schedule(MilliSeconds(1550), &RetxTrackerFixture::recordSize, this);
+
+  // Data for 1 and 3 is lost.  Data for 2 gives an RTT sample that increases the retransmit
+  // timeout from 1s to 1.47s, so the event armed for 1.05s must not time out 1 and 3.
+  Simulator::Schedule(MilliSeconds(500), &RetxTrackerFixture::ack, this, 2);
+
+  Simulator::Stop(MilliSeconds(1600));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(acks.size(), 1);
+  BOOST_CHECK_EQUAL(std::get<0>(acks[0]), 2);
+  BOOST_CHECK_EQUAL(std::get<1>(acks[0]), MilliSeconds(480));
+  BOOST_CHECK_EQUAL(std::get<3>(acks[0]), 1);
+
+  // timeouts happen at multiples of the granularity, in order of transmission
+  BOOST_REQUIRE_EQUAL(timeouts.size(), 2);
+  BOOST_CHECK_EQUAL(std::get<0>(timeouts[0]), 1);
+  BOOST_CHECK_EQUAL(std::get<0>(timeouts[1]), 3);
+  BOOST_CHECK_EQUAL(std::get<1>(timeouts[0]), std::get<1>(timeouts[1]));
+  BOOST_CHECK_EQUAL(std::get<1>(timeouts[0]).GetTimeStep() % MilliSeconds(50).GetTimeStep(), 0);
+  BOOST_CHECK_GE(std::get<1>(timeouts[0]), MilliSeconds(25) + rtt->RetransmitTimeout());
+  BOOST_CHECK_LT(std::get<1>(timeouts[0]), MilliSeconds(1550));
+
+  // timed out sequence numbers are kept until they are sent again or satisfied
+  BOOST_REQUIRE_EQUAL(sizes.size(), 1);
+  BOOST_CHECK_EQUAL(sizes[0], 3);
+}
+
+BOOST_AUTO_TEST_CASE(Retransmission)
+{
+  tracker.SetTimeoutCallback(std::bind(&RetxTrackerFixture::retransmit, this,
+                                       std::placeholders::_1));
+
+  Simulator::Schedule(Seconds(0), &RetxTracker::Sent, &tracker, 1);
+  Simulator::Schedule(MilliSeconds(1500), &RetxTrackerFixture::ack, this, 1);
+  Simulator::Schedule(MilliSeconds(1500), &RetxTrackerFixture::recordSize, this);
+
+  Simulator::Stop(Seconds(10));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(timeouts.size(), 1);
+  BOOST_CHECK_EQUAL(std::get<1>(timeouts[0]), Seconds(1));
+
+  BOOST_REQUIRE_EQUAL(acks.size(), 1);
+  BOOST_CHECK_EQUAL(std::get<1>(acks[0]), MilliSeconds(500));
+  BOOST_CHECK_EQUAL(std::get<2>(acks[0]), MilliSeconds(1500));
+  BOOST_CHECK_EQUAL(std::get<3>(acks[0]), 2);
+
+  BOOST_CHECK_EQUAL(sizes[0], 0);
+}
+
+BOOST_AUTO_TEST_CASE(Lifetime)
+{
+  tracker.SetLifetime(Seconds(2));
+
+  Simulator::Schedule(Seconds(0), &RetxTracker::Sent, &tracker, 1);
+  Simulator::Schedule(Seconds(1), &RetxTracker::Sent, &tracker, 2);
+  Simulator::Schedule(MilliSeconds(1500), &RetxTrackerFixture::recordSize, this);
+  Simulator::Schedule(MilliSeconds(2500), &RetxTrackerFixture::recordSize, this);
+  Simulator::Schedule(MilliSeconds(2500), &RetxTrackerFixture::ack, this, 1); // too late
+  Simulator::Schedule(MilliSeconds(2600), &RetxTrackerFixture::ack, this, 2);
+  Simulator::Schedule(MilliSeconds(2600), &RetxTrackerFixture::recordSize, this);
+
+  Simulator::Stop(Seconds(10));
+  Simulator::Run();
+
+  // sequence numbers are forgotten without timeout callback
+  BOOST_CHECK(timeouts.empty());
+  BOOST_REQUIRE_EQUAL(sizes.size(), 3);
+  BOOST_CHECK_EQUAL(sizes[0], 2);
+  BOOST_CHECK_EQUAL(sizes[1], 1);
+  BOOST_CHECK_EQUAL(sizes[2], 0);
+
+  BOOST_REQUIRE_EQUAL(acks.size(), 1);
+  BOOST_CHECK_EQUAL(std::get<0>(acks[0]), 2);
+  BOOST_CHECK_EQUAL(std::get<1>(acks[0]), MilliSeconds(1600));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-zipf-mandelbrot-table.hpp"
+
+#include "../tests-common.hpp"
+
+#include <cmath>
+#include <random>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnZipfMandelbrotTable, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Sharing)
+{
+  auto table1 = ZipfMandelbrotTable::Get(1000, 0.7, 0.7);
+  auto table2 = ZipfMandelbrotTable::Get(1000, 0.7, 0.7);
+  auto table3 = ZipfMandelbrotTable::Get(1000, 0.7, 0.8);
+  auto table4 = ZipfMandelbrotTable::Get(999, 0.7, 0.7);
+
+  BOOST_CHECK_EQUAL(table1, table2);
+  BOOST_CHECK_NE(table1, table3);
+  BOOST_CHECK_NE(table1, table4);
+  BOOST_CHECK_EQUAL(table4->GetN(), 999);
+  BOOST_CHECK_EQUAL(table3->GetS(), 0.8);
+}
+
+BOOST_AUTO_TEST_CASE(Range)
+{
+  ZipfMandelbrotTable single(1, 0.7, 0.7);
+  BOOST_CHECK_EQUAL(single.Sample(0.0, 0.0), 1);
+  BOOST_CHECK_EQUAL(single.Sample(0.999999, 0.999999), 1);
+
+  ZipfMandelbrotTable table(10, 0.7, 0.7);
+  for (double column = 0.0; column < 1.0; column += 0.01) {
+    for (double coin : {0.0, 0.5, 0.99999999}) {
+      uint32_t rank = table.Sample(column, coin);
+      BOOST_CHECK_GE(rank, 1);
+      BOOST_CHECK_LE(rank, 10);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Distribution)
+{
+  const uint32_t n = 100;
+  const double q = 0.7;
+  const double s = 0.7;
+  const uint32_t nSamples = 1000000;
+
+  std::vector<double> expected(n + 1);
+  double sum = 0.0;
+  for (uint32_t k = 1; k <= n; k++) {
+    expected[k] = 1.0 / std::pow(k + q, s);
+    sum += expected[k];
+  }
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  auto table = ZipfMandelbrotTable::Get(n, q, s);
+  std::vector<uint32_t> counts(n + 1);
+  for (uint32_t i = 0; i < nSamples; i++) {
+    double column = uniform(rng);
+    counts[table->Sample(column, uniform(rng))]++;
+  }
+
+  BOOST_CHECK_EQUAL(counts[0], 0);
+  for (uint32_t k = 1; k <= n; k++) {
+    double mean = nSamples * expected[k] / sum;
+    // within 5 standard deviations
+    BOOST_CHECK_SMALL(counts[k] - mean, 5 * std::sqrt(mean));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/topology-partitioner.hpp"
+
+#include "ns3/names.h"
+
+#include <boost/filesystem.hpp>
+
+#include "../../tests-common.hpp"
+
+#include <fstream>
+#include <sstream>
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TOPOLOGY =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "partitioner-topo.txt";
+const boost::filesystem::path TEST_SAVED_TOPOLOGY =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "partitioner-topo-saved.txt";
+
+class TopologyPartitionerFixture : public CleanupFixture
+{
+public:
+  TopologyPartitionerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~TopologyPartitionerFixture()
+  {
+    boost::filesystem::remove(TEST_TOPOLOGY);
+    boost::filesystem::remove(TEST_SAVED_TOPOLOGY);
+  }
+
+  void
+  writeTopology(const std::string& routers, const std::string& links)
+  {
+    std::ofstream os(TEST_TOPOLOGY.string());
+    os << "router\n" << routers << "link\n" << links;
+  }
+
+  uint32_t
+  systemId(const std::string& name)
+  {
+    return partitioner.GetSystemId(Names::Find<Node>(name));
+  }
+
+public:
+  AnnotatedTopologyReader reader;
+  TopologyPartitioner partitioner;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTopologyPartitioner, TopologyPartitionerFixture)
+
+BOOST_AUTO_TEST_CASE(Dumbbell)
+{
+  // two fully connected clusters of four nodes, connected by a 10ms and a 5ms link
+  std::ostringstream routers;
+  std::ostringstream links;
+  for (char cluster : {'a', 'b'}) {
+    for (int i = 1; i <= 4; ++i) {
+      routers << cluster << i << " NA 0 0\n";
+      for (int j = i + 1; j <= 4; ++j) {
+        links << cluster << i << " " << cluster << j << " 10Mbps 1 1ms 100\n";
+      }
+    }
+  }
+  links << "a1 b1 10Mbps 1 10ms 100\n"
+        << "a2 b2 10Mbps 1 5ms 100\n";
+  writeTopology(routers.str(), links.str());
+
+  reader.SetFileName(TEST_TOPOLOGY.string());
+  reader.Read();
+  partitioner.Partition(reader, 2);
+
+  BOOST_CHECK_EQUAL(partitioner.GetNCutLinks(), 2);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), MilliSeconds(5));
+  BOOST_CHECK_EQUAL(partitioner.GetLoad(0), partitioner.GetLoad(1));
+  for (const std::string i : {"2", "3", "4"}) {
+    BOOST_CHECK_EQUAL(systemId("a" + i), systemId("a1"));
+    BOOST_CHECK_EQUAL(systemId("b" + i), systemId("b1"));
+  }
+  BOOST_CHECK_NE(systemId("a1"), systemId("b1"));
+
+  // system ids are written as the last column of the router section
+  reader.SaveTopology(TEST_SAVED_TOPOLOGY.string());
+  std::ifstream is(TEST_SAVED_TOPOLOGY.string());
+  std::string line;
+  int nRouters = 0;
+  while (std::getline(is, line) && line != "link") {
+    std::istringstream fields(line);
+    std::string name, city;
+    double y, x;
+    uint32_t id;
+    if (fields >> name >> city >> y >> x >> id) {
+      BOOST_CHECK_EQUAL(id, systemId(name));
+      ++nRouters;
+    }
+  }
+  BOOST_CHECK_EQUAL(nRouters, 8);
+}
+
+BOOST_AUTO_TEST_CASE(Chain)
+{
+  std::ostringstream routers;
+  std::ostringstream links;
+  for (int i = 0; i < 8; ++i) {
+    routers << "n" << i << " NA 0 " << i << "\n";
+    if (i > 0) {
+      links << "n" << i - 1 << " n" << i << " 10Mbps 1 2ms 100\n";
+    }
+  }
+  writeTopology(routers.str(), links.str());
+
+  reader.SetFileName(TEST_TOPOLOGY.string());
+  reader.Read();
+
+  partitioner.SetDegreeWeight(0);
+  partitioner.Partition(reader, 2);
+  BOOST_CHECK_EQUAL(partitioner.GetNCutLinks(), 1);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), MilliSeconds(2));
+  BOOST_CHECK_EQUAL(partitioner.GetLoad(0), 4);
+  BOOST_CHECK_EQUAL(partitioner.GetLoad(1), 4);
+
+  partitioner.Partition(reader, 4);
+  BOOST_CHECK_EQUAL(partitioner.GetNCutLinks(), 3);
+  for (uint32_t systemId = 0; systemId < 4; ++systemId) {
+    BOOST_CHECK_EQUAL(partitioner.GetLoad(systemId), 2);
+  }
+
+  partitioner.Partition(reader, 1);
+  BOOST_CHECK_EQUAL(partitioner.GetNCutLinks(), 0);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), Time::Max());
+  BOOST_CHECK_EQUAL(reader.GetSystemId(Names::Find<Node>("n7")), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -69,6 +69,7 @@ public:
   {
     boost::filesystem::remove(TEST_TRACE);
     AppDelayTracer::Destroy(); // additional cleanup
+    AppDelayTracer::SetHistogramPeriod(Seconds(0));
   }
 };
 
@@ -161,6 +162,28 @@ BOOST_AUTO_TEST_CASE(InstallNodeDumpStream)
 )STR"));
 }
 
+BOOST_AUTO_TEST_CASE(HistogramPeriod)
+{
+  AppDelayTracer::SetHistogramPeriod(Seconds(1));
+  AppDelayTracer::Install(getNode("1"), TEST_TRACE.string());
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  // 41766us falls into the bucket [41728, 41983]; percentiles are limited to the maximum
+  BOOST_CHECK_EQUAL(buffer.str(),
+    R"STR(Time	Node	AppId	Type	Count	MinUS	P50US	P90US	P99US	P999US	MaxUS	MeanUS	Buckets
+2	1	0	FullDelay	1	41766	41766	41766	41766	41766	41766	41766	7;41766;41766;41766;1187
+2	1	0	LastDelay	1	41766	41766	41766	41766	41766	41766	41766	7;41766;41766;41766;1187
+)STR");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
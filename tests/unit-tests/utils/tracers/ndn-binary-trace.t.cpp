@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-binary-trace.hpp"
+
+#include "../../tests-common.hpp"
+
+#include <sstream>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnBinaryTrace, CleanupFixture)
+
+static const std::vector<BinaryTraceColumn> COLUMNS = {
+  {BinaryTraceColumn::DOUBLE, "Time"},
+  {BinaryTraceColumn::SYMBOL, "Node"},
+  {BinaryTraceColumn::INTEGER, "FaceId"},
+  {BinaryTraceColumn::DOUBLE, "Packets"},
+};
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+  auto os = make_shared<std::stringstream>();
+  {
+    BinaryTraceWriter writer(os, COLUMNS, 2); // blocks of two rows
+
+    for (int i = 0; i < 5; i++) {
+      writer.AddDouble(0.5 * i);
+      writer.AddSymbol(i % 2 == 0 ? "leaf-1" : "root");
+      writer.AddInteger(i == 4 ? -1 : 256 + i);
+      writer.AddDouble(1.0 / 3 * i);
+      writer.EndRow();
+    }
+  }
+
+  BinaryTraceReader reader(*os);
+  BOOST_REQUIRE_EQUAL(reader.GetColumns().size(), 4);
+  BOOST_CHECK_EQUAL(reader.GetColumns()[1].name, "Node");
+  BOOST_CHECK_EQUAL(reader.GetColumns()[2].type, BinaryTraceColumn::INTEGER);
+
+  std::vector<size_t> blockSizes;
+  int i = 0;
+  while (reader.ReadBlock()) {
+    blockSizes.push_back(reader.GetNRows());
+    for (size_t row = 0; row < reader.GetNRows(); row++, i++) {
+      BOOST_CHECK_EQUAL(reader.GetDouble(0, row), 0.5 * i);
+      BOOST_CHECK_EQUAL(reader.GetSymbol(1, row), i % 2 == 0 ? "leaf-1" : "root");
+      BOOST_CHECK_EQUAL(reader.GetInteger(2, row), i == 4 ? -1 : 256 + i);
+      BOOST_CHECK_EQUAL(reader.GetDouble(3, row), 1.0 / 3 * i); // exact
+    }
+  }
+  BOOST_CHECK_EQUAL(i, 5);
+  std::vector<size_t> expectedBlockSizes = {2, 2, 1};
+  BOOST_CHECK_EQUAL_COLLECTIONS(blockSizes.begin(), blockSizes.end(),
+                                expectedBlockSizes.begin(), expectedBlockSizes.end());
+}
+
+BOOST_AUTO_TEST_CASE(ConvertToTsv)
+{
+  auto os = make_shared<std::stringstream>();
+  {
+    BinaryTraceWriter writer(os, COLUMNS);
+    writer.AddDouble(1);
+    writer.AddSymbol("leaf-1");
+    writer.AddInteger(256);
+    writer.AddDouble(0.8);
+    writer.EndRow();
+
+    writer.AddDouble(1.5);
+    writer.AddSymbol("leaf-1");
+    writer.AddInteger(-1);
+    writer.AddDouble(1.0 / 3);
+    writer.EndRow();
+  }
+
+  std::ostringstream tsv;
+  BinaryTraceReader::ConvertToTsv(*os, tsv);
+  BOOST_CHECK_EQUAL(tsv.str(), "Time\tNode\tFaceId\tPackets\n"
+                               "1\tleaf-1\t256\t0.8\n"
+                               "1.5\tleaf-1\t-1\t0.333333\n");
+}
+
+BOOST_AUTO_TEST_CASE(Errors)
+{
+  std::istringstream text("Time\tNode\n");
+  BOOST_CHECK_THROW(BinaryTraceReader reader(text), BinaryTraceReader::Error);
+
+  auto os = make_shared<std::stringstream>();
+  {
+    BinaryTraceWriter writer(os, COLUMNS);
+    writer.AddDouble(1);
+    writer.AddSymbol("leaf-1");
+    writer.AddInteger(256);
+    writer.AddDouble(0.8);
+    writer.EndRow();
+  }
+
+  std::string trace = os->str();
+  std::istringstream truncated(trace.substr(0, trace.size() - 1));
+  BinaryTraceReader reader(truncated);
+  BOOST_CHECK_THROW(reader.ReadBlock(), BinaryTraceReader::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,190 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-cs-tracer.hpp"
+#include "utils/ndn-data-template.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include "../../tests-common.hpp"
+
+#include <sstream>
+
+namespace ns3 {
+namespace ndn {
+
+class CsTracerFixture : public CleanupFixture
+{
+public:
+  CsTracerFixture()
+    : os(make_shared<std::ostringstream>())
+  {
+    nodes.Create(1);
+    StackHelper ndnHelper;
+    ndnHelper.Install(nodes);
+  }
+
+  ~CsTracerFixture()
+  {
+    CsTracer::Destroy();
+    CsTracer::SetPrefixDepth(1);
+  }
+
+  nfd::cs::Cs&
+  getCs()
+  {
+    return nodes.Get(0)->GetObject<L3Protocol>()->getForwarder()->getCs();
+  }
+
+  size_t
+  insertData(const Name& name)
+  {
+    auto data = DataTemplate().Create(name, 10);
+    getCs().insert(*data);
+    return data->wireEncode().size();
+  }
+
+  void
+  find(const Name& name)
+  {
+    getCs().find(Interest(name), [] (const Interest&, const Data&) {}, [] (const Interest&) {});
+  }
+
+  std::string
+  line(const std::string& prefix, const std::string& type, size_t value)
+  {
+    std::ostringstream line;
+    line << "1\t" << nodes.Get(0)->GetId() << "\t" << prefix << "\t" << type << "\t" << value
+         << "\n";
+    return line.str();
+  }
+
+  std::string
+  run()
+  {
+    Simulator::Stop(Seconds(1.5));
+    Simulator::Run();
+    return os->str();
+  }
+
+public:
+  shared_ptr<std::ostringstream> os;
+  NodeContainer nodes;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnCsTracer, CsTracerFixture)
+
+BOOST_AUTO_TEST_CASE(PrefixStats)
+{
+  CsTracer::Install(nodes.Get(0), os, Seconds(1));
+
+  getCs().setLimit(2);
+  size_t size = insertData("/a/1");
+  insertData("/a/2");
+  find("/a/2");
+  insertData("/b/1"); // evicts /a/1
+
+  BOOST_CHECK_EQUAL(run(),
+                    line("all", "CacheHits", 0) + // counted by the forwarder only
+                    line("all", "CacheMisses", 0) +
+                    line("all", "CacheInserts", 3) +
+                    line("all", "CacheEvictions", 1) +
+                    line("all", "CacheBytes", 2 * size) +
+                    line("/a", "CacheHits", 1) +
+                    line("/a", "CacheInserts", 2) +
+                    line("/a", "CacheEvictions", 1) +
+                    line("/a", "CacheBytes", size) +
+                    line("/b", "CacheHits", 0) +
+                    line("/b", "CacheInserts", 1) +
+                    line("/b", "CacheEvictions", 0) +
+                    line("/b", "CacheBytes", size));
+}
+
+BOOST_AUTO_TEST_CASE(DataCachedBeforeInstall)
+{
+  getCs().setLimit(2);
+  size_t size = insertData("/a/1");
+  insertData("/b/1");
+
+  CsTracer::Install(nodes.Get(0), os, Seconds(1));
+  insertData("/b/2"); // evicts /a/1
+
+  BOOST_CHECK_EQUAL(run(),
+                    line("all", "CacheHits", 0) +
+                    line("all", "CacheMisses", 0) +
+                    line("all", "CacheInserts", 1) +
+                    line("all", "CacheEvictions", 1) +
+                    line("all", "CacheBytes", 2 * size) +
+                    line("/a", "CacheHits", 0) +
+                    line("/a", "CacheInserts", 0) +
+                    line("/a", "CacheEvictions", 1) +
+                    line("/a", "CacheBytes", 0) +
+                    line("/b", "CacheHits", 0) +
+                    line("/b", "CacheInserts", 1) +
+                    line("/b", "CacheEvictions", 0) +
+                    line("/b", "CacheBytes", 2 * size));
+}
+
+BOOST_AUTO_TEST_CASE(PrefixDepth)
+{
+  CsTracer::SetPrefixDepth(2);
+  CsTracer::Install(nodes.Get(0), os, Seconds(1));
+
+  // names not longer than the depth are counted as a whole
+  size_t shortSize = insertData("/a");
+  size_t size = insertData("/a/1/x");
+  insertData("/a/1/y");
+
+  BOOST_CHECK_EQUAL(run(),
+                    line("all", "CacheHits", 0) +
+                    line("all", "CacheMisses", 0) +
+                    line("all", "CacheInserts", 3) +
+                    line("all", "CacheEvictions", 0) +
+                    line("all", "CacheBytes", shortSize + 2 * size) +
+                    line("/a", "CacheHits", 0) +
+                    line("/a", "CacheInserts", 1) +
+                    line("/a", "CacheEvictions", 0) +
+                    line("/a", "CacheBytes", shortSize) +
+                    line("/a/1", "CacheHits", 0) +
+                    line("/a/1", "CacheInserts", 2) +
+                    line("/a/1", "CacheEvictions", 0) +
+                    line("/a/1", "CacheBytes", 2 * size));
+}
+
+BOOST_AUTO_TEST_CASE(NoPrefixStats)
+{
+  CsTracer::SetPrefixDepth(0);
+  CsTracer::Install(nodes.Get(0), os, Seconds(1));
+
+  size_t size = insertData("/a/1");
+
+  BOOST_CHECK_EQUAL(run(),
+                    line("all", "CacheHits", 0) +
+                    line("all", "CacheMisses", 0) +
+                    line("all", "CacheInserts", 1) +
+                    line("all", "CacheEvictions", 0) +
+                    line("all", "CacheBytes", size));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
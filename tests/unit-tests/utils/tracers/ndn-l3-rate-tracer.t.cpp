@@ -18,12 +18,17 @@
  **/
 
 #include "utils/tracers/ndn-l3-rate-tracer.hpp"
+#include "utils/tracers/ndn-binary-trace.hpp"
 
 #include <boost/filesystem.hpp>
 #include <boost/test/output_test_stream.hpp>
 
 #include "../../tests-common.hpp"
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
 namespace ns3 {
 namespace ndn {
 
@@ -56,6 +61,7 @@ public:
   {
     boost::filesystem::remove(TEST_TRACE);
     L3RateTracer::Destroy(); // additional cleanup
+    L3RateTracer::SetBinaryOutput(false);
   }
 };
 
@@ -119,6 +125,38 @@ BOOST_AUTO_TEST_CASE(NackTracing)
   BOOST_CHECK(os.match_pattern());
 }
 
+BOOST_AUTO_TEST_CASE(BinaryOutput)
+{
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+
+  L3RateTracer::SetBinaryOutput(true);
+  L3RateTracer::Install(nodes, TEST_TRACE.string(), Seconds(1));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  L3RateTracer::Destroy(); // to force log to be written
+
+  std::ifstream is(TEST_TRACE.string());
+  std::ostringstream os;
+  BinaryTraceReader::ConvertToTsv(is, os);
+  std::string tsv = os.str();
+
+  // same content as in text mode
+  BOOST_CHECK_EQUAL(tsv.find("Time	Node	FaceId	FaceDescr	Type	Packets	Kilobytes	PacketRaw	"
+                             "KilobytesRaw\n"
+                             "1	1	1	internal://	InInterests	0	0	0	0\n"),
+                    0);
+  BOOST_CHECK_NE(tsv.find("1	1	256	internal://	InSatisfiedInterests	4	0	5	0\n"),
+                 std::string::npos);
+  BOOST_CHECK_NE(tsv.find("1	1	257	appFace://	OutNacks	0.8	0	1	0\n"), std::string::npos);
+  BOOST_CHECK_NE(tsv.find("1	1	-1	all	SatisfiedInterests	4	0	5	0\n"
+                          "1	1	-1	all	TimedOutInterests	0.8	0	1	0\n"),
+                 std::string::npos);
+  BOOST_CHECK_EQUAL(std::count(tsv.begin(), tsv.end(), '\n'), 33);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-latency-histogram.hpp"
+
+#include "../../tests-common.hpp"
+
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnLatencyHistogram, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Buckets)
+{
+  LatencyHistogram histogram(2); // exact up to 7, then 4 buckets per power of two
+
+  std::vector<int64_t> upperBounds;
+  for (size_t i = 0; i < 16; i++) {
+    BOOST_CHECK_EQUAL(histogram.GetIndex(histogram.GetLowerBound(i)), i);
+    BOOST_CHECK_EQUAL(histogram.GetIndex(histogram.GetUpperBound(i)), i);
+    if (i > 0) {
+      BOOST_CHECK_EQUAL(histogram.GetLowerBound(i), histogram.GetUpperBound(i - 1) + 1);
+    }
+    upperBounds.push_back(histogram.GetUpperBound(i));
+  }
+  std::vector<int64_t> expected = {0, 1, 2, 3, 4, 5, 6, 7, 9, 11, 13, 15, 19, 23, 27, 31};
+  BOOST_CHECK_EQUAL_COLLECTIONS(upperBounds.begin(), upperBounds.end(),
+                                expected.begin(), expected.end());
+
+  LatencyHistogram fine;
+  int64_t largest = std::numeric_limits<int64_t>::max();
+  BOOST_CHECK_EQUAL(fine.GetUpperBound(fine.GetIndex(largest)), largest);
+  for (int64_t value : {int64_t(1000), int64_t(123456789), int64_t(1) << 40}) {
+    size_t index = fine.GetIndex(value);
+    BOOST_CHECK_LE(fine.GetLowerBound(index), value);
+    BOOST_CHECK_GE(fine.GetUpperBound(index), value);
+    // relative error below 2^-7
+    BOOST_CHECK_LT(fine.GetUpperBound(index) - fine.GetLowerBound(index), value / 128);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Percentiles)
+{
+  LatencyHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.GetValueAtPercentile(50), 0);
+
+  for (int64_t value = 1; value <= 1000; value++) {
+    histogram.Record(value * 100);
+  }
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 1000);
+  BOOST_CHECK_EQUAL(histogram.GetMin(), 100);
+  BOOST_CHECK_EQUAL(histogram.GetMax(), 100000);
+  BOOST_CHECK_EQUAL(histogram.GetMean(), 50050);
+
+  BOOST_CHECK_EQUAL(histogram.GetValueAtPercentile(0), 100);
+  BOOST_CHECK_EQUAL(histogram.GetValueAtPercentile(100), 100000);
+  for (double percentile : {50.0, 90.0, 99.0, 99.9}) {
+    int64_t exact = static_cast<int64_t>(percentile * 10 + 0.5) * 100;
+    int64_t value = histogram.GetValueAtPercentile(percentile);
+    BOOST_CHECK_GE(value, exact);
+    BOOST_CHECK_LE(value, exact + exact / 128);
+  }
+
+  histogram.Record(-5, 10); // recorded as 0
+  BOOST_CHECK_EQUAL(histogram.GetMin(), 0);
+  BOOST_CHECK_EQUAL(histogram.GetValueAtPercentile(0.5), 0);
+
+  histogram.Reset();
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.GetMax(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Merge)
+{
+  LatencyHistogram a, b, all;
+  for (int64_t value = 0; value < 5000; value += 7) {
+    (value % 2 == 0 ? a : b).Record(value);
+    all.Record(value);
+  }
+  b.Record(1000000, 3);
+  all.Record(1000000, 3);
+
+  a.Merge(b);
+  BOOST_CHECK_EQUAL(a.Encode(), all.Encode());
+  BOOST_CHECK_EQUAL(a.GetCount(), all.GetCount());
+  BOOST_CHECK_EQUAL(a.GetValueAtPercentile(99.9), all.GetValueAtPercentile(99.9));
+
+  LatencyHistogram empty;
+  a.Merge(empty);
+  BOOST_CHECK_EQUAL(a.Encode(), all.Encode());
+}
+
+BOOST_AUTO_TEST_CASE(Encoding)
+{
+  LatencyHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.Encode(), "7;0;0;0;");
+  BOOST_CHECK_EQUAL(LatencyHistogram::Decode("7;0;0;0;").GetCount(), 0);
+
+  histogram.Record(3);
+  histogram.Record(3);
+  histogram.Record(10);
+  histogram.Record(300); // index 1*128 + (300 >> 1) = 278
+  BOOST_CHECK_EQUAL(histogram.Encode(), "7;3;300;316;3:2,7,268");
+
+  LatencyHistogram decoded = LatencyHistogram::Decode(histogram.Encode());
+  BOOST_CHECK_EQUAL(decoded.GetCount(), 4);
+  BOOST_CHECK_EQUAL(decoded.GetMin(), 3);
+  BOOST_CHECK_EQUAL(decoded.GetMax(), 300);
+  BOOST_CHECK_EQUAL(decoded.GetMean(), 79);
+  BOOST_CHECK_EQUAL(decoded.Encode(), histogram.Encode());
+
+  BOOST_CHECK_THROW(LatencyHistogram::Decode(""), LatencyHistogram::Error);
+  BOOST_CHECK_THROW(LatencyHistogram::Decode("7;3;300;316"), LatencyHistogram::Error);
+  BOOST_CHECK_THROW(LatencyHistogram::Decode("40;0;0;0;"), LatencyHistogram::Error);
+  BOOST_CHECK_THROW(LatencyHistogram::Decode("7;3;300;316;3:2,7,269"), LatencyHistogram::Error);
+  BOOST_CHECK_THROW(LatencyHistogram::Decode("7;3;300;316;3:2,0,268"), LatencyHistogram::Error);
+  BOOST_CHECK_THROW(LatencyHistogram::Decode("7;3;300;316;3:2;7"), LatencyHistogram::Error);
+  BOOST_CHECK_THROW(LatencyHistogram::Decode("7;3;300;316;3:x"), LatencyHistogram::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-trace-sink.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include "../../tests-common.hpp"
+
+#include <fstream>
+#include <sstream>
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_SINK_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "sink-trace.csv";
+
+class TraceSinkFixture : public CleanupFixture
+{
+public:
+  TraceSinkFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~TraceSinkFixture()
+  {
+    boost::filesystem::remove(TEST_SINK_TRACE);
+  }
+
+  std::string
+  readTrace()
+  {
+    std::ifstream is(TEST_SINK_TRACE.string());
+    std::ostringstream os;
+    os << is.rdbuf();
+    return os.str();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTraceSink, TraceSinkFixture)
+
+BOOST_AUTO_TEST_CASE(Formatting)
+{
+  Ptr<TraceSink> sink = Create<TraceSink>(TEST_SINK_TRACE.string());
+  BOOST_REQUIRE(sink->IsOpen());
+
+  sink->Write("nodeid", "event", "name", "time");
+  sink->Write(uint32_t(3), "sent", Name("/prefix/service3"), NanoSeconds(1500000001));
+  sink->Write(-7, std::string("util"), 0.25, true, false, MilliSeconds(20));
+
+  // remaining records are written at Simulator::Destroy
+  Simulator::Destroy();
+  BOOST_CHECK(!sink->IsOpen());
+  sink->Write("ignored after close");
+
+  BOOST_CHECK_EQUAL(readTrace(), "nodeid,event,name,time\n"
+                                 "3,sent,/prefix/service3,1.500000001\n"
+                                 "-7,util,0.250000000,1,0,0.020000000\n");
+}
+
+BOOST_AUTO_TEST_CASE(SmallBuffer)
+{
+  std::ostringstream expected;
+  {
+    // records wrap around the ring buffer and some of them are larger than the buffer
+    Ptr<TraceSink> sink = Create<TraceSink>(TEST_SINK_TRACE.string(), 64, 16);
+    for (int i = 0; i < 10000; i++) {
+      std::string field(i % 100, 'a' + i % 26);
+      sink->Write(i, field);
+      expected << i << "," << field << "\n";
+    }
+  } // closed by the destructor
+
+  BOOST_CHECK(readTrace() == expected.str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
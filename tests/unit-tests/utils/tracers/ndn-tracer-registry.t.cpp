@@ -0,0 +1,182 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-tracer-registry.hpp"
+
+#include "../../tests-common.hpp"
+
+#include <sstream>
+
+namespace ns3 {
+namespace ndn {
+
+template<int Kind>
+class TestTracer : public SimpleRefCount<TestTracer<Kind>>
+{
+public:
+  TestTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+    : m_os(os)
+    , m_nodeId(node->GetId())
+  {
+  }
+
+  static void
+  AttachOutput(const std::list<Ptr<TestTracer>>& tracers, shared_ptr<std::ostream> os)
+  {
+    *os << "header\n";
+  }
+
+  void
+  SetAveragingPeriod(const Time& period)
+  {
+    m_period = period;
+  }
+
+  void
+  PeriodicPrinter()
+  {
+    *m_os << Simulator::Now().ToDouble(Time::S) << " " << Kind << " " << m_nodeId << "\n";
+  }
+
+public:
+  shared_ptr<std::ostream> m_os;
+  uint32_t m_nodeId;
+  Time m_period;
+};
+
+class TracerRegistryFixture : public CleanupFixture
+{
+public:
+  TracerRegistryFixture()
+    : os(make_shared<std::ostringstream>())
+  {
+    nodes.Create(3);
+  }
+
+  ~TracerRegistryFixture()
+  {
+    TracerRegistry::Remove<TestTracer<0>>();
+    TracerRegistry::Remove<TestTracer<1>>();
+  }
+
+  template<int Kind>
+  Ptr<TestTracer<Kind>>
+  add(uint32_t node, Time period)
+  {
+    auto tracer = Create<TestTracer<Kind>>(os, nodes.Get(node));
+    TracerRegistry::Add(tracer, nodes.Get(node)->GetId(), os, period);
+    return tracer;
+  }
+
+  std::string
+  line(double time, int kind, uint32_t node)
+  {
+    std::ostringstream line;
+    line << time << " " << kind << " " << nodes.Get(node)->GetId() << "\n";
+    return line.str();
+  }
+
+public:
+  shared_ptr<std::ostringstream> os;
+  NodeContainer nodes;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTracerRegistry, TracerRegistryFixture)
+
+BOOST_AUTO_TEST_CASE(NodeOrder)
+{
+  auto tracer = add<0>(2, Seconds(1));
+  add<1>(1, Seconds(1));
+  add<0>(0, Seconds(1));
+  add<1>(2, Seconds(1));
+  BOOST_CHECK_EQUAL(tracer->m_period, Seconds(1));
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  // all tracers of the stream are printed by one event, in node order
+  BOOST_CHECK_EQUAL(os->str(),
+                    line(1, 0, 0) + line(1, 1, 1) + line(1, 0, 2) + line(1, 1, 2) +
+                    line(2, 0, 0) + line(2, 1, 1) + line(2, 0, 2) + line(2, 1, 2));
+}
+
+BOOST_AUTO_TEST_CASE(PeriodsAndRemove)
+{
+  add<0>(0, Seconds(1));
+  add<1>(1, Seconds(2));
+
+  Simulator::Schedule(Seconds(2.5), &TracerRegistry::Remove<TestTracer<0>>);
+  Simulator::Stop(Seconds(4.5));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(os->str(),
+                    line(1, 0, 0) + line(2, 1, 1) + line(2, 0, 0) + line(4, 1, 1));
+}
+
+BOOST_AUTO_TEST_CASE(SetPeriod)
+{
+  auto tracer = add<0>(0, Seconds(1));
+  add<0>(1, Seconds(1));
+  add<0>(2, Seconds(2));
+
+  Simulator::Schedule(Seconds(1.5), &TracerRegistry::SetPeriod, PeekPointer(tracer), Seconds(2));
+  Simulator::Stop(Seconds(4.5));
+  Simulator::Run();
+
+  // the tracer of node 0 joins the clock of node 2
+  BOOST_CHECK_EQUAL(os->str(),
+                    line(1, 0, 0) + line(1, 0, 1) +
+                    line(2, 0, 0) + line(2, 0, 2) + line(2, 0, 1) +
+                    line(3, 0, 1) +
+                    line(4, 0, 0) + line(4, 0, 2) + line(4, 0, 1));
+}
+
+BOOST_AUTO_TEST_CASE(NextSimulation)
+{
+  add<0>(0, Seconds(1));
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+  Simulator::Destroy();
+
+  // the tracer of the destroyed simulation is gone, the new one gets a running clock
+  add<0>(1, Seconds(1));
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(os->str(), line(1, 0, 0) + line(1, 0, 1));
+}
+
+BOOST_AUTO_TEST_CASE(Install)
+{
+  std::list<Ptr<TestTracer<0>>> tracers =
+    TracerRegistry::Install<TestTracer<0>>(nodes.Begin(), nodes.End(), "-", Seconds(1));
+  BOOST_CHECK_EQUAL(tracers.size(), 3);
+  BOOST_CHECK_EQUAL(tracers.front()->m_period, Seconds(1));
+  BOOST_CHECK_EQUAL(tracers.back()->m_nodeId, nodes.Get(2)->GetId());
+
+  BOOST_CHECK(TracerRegistry::OpenStream("/nonexistent/directory/trace.txt") == nullptr);
+  BOOST_CHECK(TracerRegistry::Install<TestTracer<1>>(nodes.Begin(), nodes.End(),
+                                                     "/nonexistent/directory/trace.txt",
+                                                     Seconds(1)).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""Merge latency histograms written by AppDelayTracer and write their CDF.
+
+AppDelayTracer::SetHistogramPeriod (or ndn-edge --LatencyHistogram=<period>) makes the tracer
+write one encoded histogram per application, type of delay, and period instead of one row per
+Data packet.  This script merges the histograms of all applications and periods of one type
+(rows with AppId "all" are node aggregates and are skipped) from any number of trace files,
+e.g., of several runs, and writes the CDF in the same format as
+sortedLatenciesToCdfDistFraction.py: one line per histogram bucket with the largest latency of
+the bucket in seconds and the fraction of latencies up to it, separated by a tab.  Like the
+percentiles in the trace, the printed percentiles are bucket bounds limited to the minimum and
+maximum, not exact latencies.
+
+Example:
+
+  python3 latencyHistogramsToCdf.py --type ServiceDelay --output latency_normal.csv \\
+      results/*/run*/latency-*.txt
+"""
+
+import argparse
+import csv
+import glob
+import math
+import sys
+
+
+class Histogram:
+    """Python counterpart of ns3::ndn::LatencyHistogram (see ndn-latency-histogram.hpp)."""
+
+    def __init__(self, bits):
+        self.bits = bits
+        self.counts = {}
+        self.count = 0
+        self.min = None
+        self.max = 0
+        self.sum = 0
+
+    @staticmethod
+    def decode(encoded):
+        bits, low, high, total, buckets = encoded.split(";")
+        histogram = Histogram(int(bits))
+        index = 0
+        for bucket in filter(None, buckets.split(",")):
+            gap, _, count = bucket.partition(":")
+            index += int(gap)
+            count = int(count) if count else 1
+            histogram.counts[index] = count
+            histogram.count += count
+        if histogram.count:
+            histogram.min, histogram.max, histogram.sum = int(low), int(high), int(total)
+        return histogram
+
+    def merge(self, other):
+        if other.bits != self.bits:
+            raise ValueError("histograms have different numbers of sub-bucket bits")
+        for index, count in other.counts.items():
+            self.counts[index] = self.counts.get(index, 0) + count
+        if other.count:
+            self.min = other.min if self.min is None else min(self.min, other.min)
+            self.max = max(self.max, other.max)
+        self.count += other.count
+        self.sum += other.sum
+
+    def upperBound(self, index):
+        shift = max((index >> self.bits) - 1, 0)
+        return ((index - (shift << self.bits)) << shift) + (1 << shift) - 1
+
+    def buckets(self):
+        """Yield (largest value of the bucket, count) in increasing order."""
+        for index in sorted(self.counts):
+            yield min(self.upperBound(index), self.max), self.counts[index]
+
+    def percentile(self, percentile):
+        if not self.count:
+            return 0
+        if percentile <= 0:
+            return self.min
+        rank = max(1, min(self.count, math.ceil(percentile / 100 * self.count)))
+        cumulative = 0
+        for value, count in self.buckets():
+            cumulative += count
+            if cumulative >= rank:
+                return max(value, self.min)
+        return self.max
+
+
+def readHistograms(files, delayType):
+    merged = None
+    for filename in files:
+        with open(filename) as f:
+            for row in csv.DictReader(f, delimiter="\t"):
+                if row["Type"] != delayType or row["AppId"] == "all":
+                    continue
+                histogram = Histogram.decode(row["Buckets"])
+                if merged is None:
+                    merged = histogram
+                else:
+                    merged.merge(histogram)
+    return merged
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("traces", nargs="+", help="histogram traces (glob patterns are expanded)")
+    parser.add_argument("--type", default="ServiceDelay",
+                        help="type of delay (default: ServiceDelay)")
+    parser.add_argument("--output", default=None,
+                        help="file for the CDF (default: <first trace>_normal.csv)")
+    args = parser.parse_args()
+
+    files = [name for pattern in args.traces for name in sorted(glob.glob(pattern))]
+    histogram = readHistograms(files, args.type)
+    if histogram is None or not histogram.count:
+        sys.stderr.write("No %s histograms in %s\n" % (args.type, " ".join(args.traces)))
+        return 1
+
+    output = args.output or files[0].rsplit(".", 1)[0] + "_normal.csv"
+    with open(output, "w") as f:
+        cumulative = 0
+        for value, count in histogram.buckets():
+            cumulative += count
+            f.write("%s\t%s\n" % (value / 1e6, cumulative / histogram.count))
+
+    print("%d latencies, mean %gs" % (histogram.count, histogram.sum / histogram.count / 1e6))
+    for percentile in [50, 90, 99, 99.9]:
+        print("p%g: %gs" % (percentile, histogram.percentile(percentile) / 1e6))
+    print("CDF written to %s" % output)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+"""Run the ndn-edge scenario for many seeds and parameter combinations and summarize the results.
+
+Every run is a separate process that writes its traces into its own directory
+(<results>/<combination>/run<N>/, passed to the scenario as --OutputDir), so runs can
+proceed in parallel on all local cores.  Runs whose directory already contains a
+completed run are skipped, so an interrupted batch can be resumed.
+
+Metrics of each run are computed from its traces:
+
+  completed          number of satisfied requests (ndn-*.csv)
+  meanLatency        mean delay between first Interest and Data of a request, in seconds
+  medianLatency      median of the same delays
+  bestChoice         fraction of server choices that picked a least-utilized server
+                     according to the latest updates (choice-*.csv)
+  meanExecuteTime    mean computation time reported by the servers (execute-*.csv)
+
+The summary has one row per combination and metric with the mean over seeds, the
+standard deviation, and a 95% confidence interval based on Student's t distribution.
+
+Example (from the ns-3 root directory, after ./waf build):
+
+  python3 src/ndnSIM/trace/runExperiments.py --runs 1-10 --proactive 0,1 \\
+      --pec-change 1.5,3 --results results --summary summary.csv
+"""
+
+import argparse
+import csv
+import glob
+import itertools
+import math
+import os
+import shlex
+import statistics
+import subprocess
+import sys
+from concurrent.futures import ThreadPoolExecutor
+
+# two-sided 95% quantiles of Student's t distribution for 1..30 degrees of freedom
+T95 = [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+       2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+       2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042]
+
+PARAMETERS = [("proactive", "Proactive"), ("pec_change", "PECChange"),
+              ("user_request", "UserRequest"), ("discovery", "Discovery")]
+
+METRICS = ["completed", "meanLatency", "medianLatency", "bestChoice", "meanExecuteTime"]
+
+DONE_MARKER = "done"
+
+
+def parseRuns(value):
+    runs = []
+    for part in value.split(","):
+        if "-" in part:
+            first, last = part.split("-")
+            runs.extend(range(int(first), int(last) + 1))
+        else:
+            runs.append(int(part))
+    return runs
+
+
+def parseList(value):
+    return [item for item in value.split(",") if item]
+
+
+def combinationName(combination):
+    return "-".join("%s%s" % (option, value) for (_, option), value in zip(PARAMETERS, combination))
+
+
+def simulate(args, combination, run):
+    directory = os.path.join(args.results, combinationName(combination), "run%d" % run)
+    if os.path.exists(os.path.join(directory, DONE_MARKER)):
+        return directory, 0
+    os.makedirs(directory, exist_ok=True)
+
+    options = ["--Run=%d" % run, "--OutputDir=%s" % os.path.abspath(directory)]
+    options += ["--%s=%s" % (option, value) for (_, option), value in zip(PARAMETERS, combination)]
+    command = args.command.format(program=args.program, args=" ".join(options))
+
+    with open(os.path.join(directory, "log.txt"), "w") as log:
+        result = subprocess.call(shlex.split(command), cwd=args.ns3_dir,
+                                 stdout=log, stderr=subprocess.STDOUT)
+    if result == 0:
+        open(os.path.join(directory, DONE_MARKER), "w").close()
+    return directory, result
+
+
+def readRows(directory, kind):
+    files = glob.glob(os.path.join(directory, kind + "-*.csv"))
+    if not files:
+        return
+    with open(files[0]) as f:
+        reader = csv.reader(f)
+        next(reader, None)  # header (does not describe all row types)
+        for row in reader:
+            yield row
+
+
+def runMetrics(directory):
+    # ndn: nodeid,event,name,time
+    sent = {}
+    latencies = []
+    for row in readRows(directory, "ndn"):
+        event, name, time = row[1], row[2], float(row[3])
+        if event == "sent":
+            sent.setdefault(name, time)
+        elif event == "received" and name in sent:
+            latencies.append(time - sent.pop(name))
+
+    # choice: nodeid,event,server,util,time[,list,connected]
+    utilization = {}
+    choices = 0
+    bestChoices = 0
+    for row in readRows(directory, "choice"):
+        event, server = row[1], row[2]
+        if event == "update":
+            utilization[server] = int(row[3])
+        elif event == "choice":
+            choices += 1
+            chosen = utilization.get(server)
+            if chosen is not None and chosen <= min(utilization.values()):
+                bestChoices += 1
+
+    # execute: nodeid,exec,server,computeTime,time
+    executeTimes = [float(row[3]) for row in readRows(directory, "execute") if row[1] == "exec"]
+
+    return {
+        "completed": len(latencies),
+        "meanLatency": statistics.mean(latencies) if latencies else None,
+        "medianLatency": statistics.median(latencies) if latencies else None,
+        "bestChoice": bestChoices / choices if choices else None,
+        "meanExecuteTime": statistics.mean(executeTimes) if executeTimes else None,
+    }
+
+
+def confidenceInterval(values):
+    mean = statistics.mean(values)
+    if len(values) < 2:
+        return mean, 0.0, mean, mean
+    stdev = statistics.stdev(values)
+    df = len(values) - 1
+    t = T95[df - 1] if df <= len(T95) else 1.96
+    half = t * stdev / math.sqrt(len(values))
+    return mean, stdev, mean - half, mean + half
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--runs", type=parseRuns, default=parseRuns("1-10"),
+                        help="seeds, e.g. 1-10 or 1,3,5 (default: 1-10)")
+    parser.add_argument("--proactive", type=parseList, default=["1"])
+    parser.add_argument("--pec-change", type=parseList, default=["1.5"])
+    parser.add_argument("--user-request", type=parseList, default=["1"])
+    parser.add_argument("--discovery", type=parseList, default=["1"])
+    parser.add_argument("--jobs", type=int, default=os.cpu_count(),
+                        help="number of simulations run at the same time (default: number of cores)")
+    parser.add_argument("--program", default="ndn-edge")
+    parser.add_argument("--command", default='./waf --run-no-build "{program} {args}"',
+                        help="command that runs one simulation; {program} and {args} are replaced")
+    parser.add_argument("--ns3-dir", default=os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                                          "..", "..", ".."),
+                        help="directory the command is run from (default: ns-3 root)")
+    parser.add_argument("--results", default="results",
+                        help="directory for the traces of all runs (default: results)")
+    parser.add_argument("--summary", default=None,
+                        help="file for the summary (default: <results>/summary.csv)")
+    args = parser.parse_args()
+    args.results = os.path.abspath(args.results)
+    summary = args.summary or os.path.join(args.results, "summary.csv")
+
+    combinations = list(itertools.product(*(getattr(args, attr) for attr, _ in PARAMETERS)))
+    jobs = [(combination, run) for combination in combinations for run in args.runs]
+    print("Running %d simulations on %d cores" % (len(jobs), args.jobs))
+
+    failed = 0
+    with ThreadPoolExecutor(max_workers=args.jobs) as executor:
+        results = executor.map(lambda job: simulate(args, *job), jobs)
+        for (combination, run), (directory, result) in zip(jobs, results):
+            if result != 0:
+                failed += 1
+                print("FAILED %s run %d (see %s)" % (combinationName(combination), run,
+                                                    os.path.join(directory, "log.txt")))
+
+    with open(summary, "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow([option for _, option in PARAMETERS] +
+                        ["metric", "runs", "mean", "stdev", "ci95Low", "ci95High"])
+        for combination in combinations:
+            metrics = []
+            for run in args.runs:
+                directory = os.path.join(args.results, combinationName(combination), "run%d" % run)
+                if os.path.exists(os.path.join(directory, DONE_MARKER)):
+                    metrics.append(runMetrics(directory))
+            for metric in METRICS:
+                values = [m[metric] for m in metrics if m[metric] is not None]
+                if not values:
+                    continue
+                mean, stdev, low, high = confidenceInterval(values)
+                writer.writerow(list(combination) +
+                                [metric, len(values), "%.9g" % mean, "%.9g" % stdev,
+                                 "%.9g" % low, "%.9g" % high])
+
+    print("Summary written to %s" % summary)
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-data-template.hpp"
+
+#include "ns3/ndnSIM/model/ndn-block-header.hpp"
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+/**
+ * @brief Write TLV-TYPE or TLV-LENGTH @p number at @p pos
+ * @return position after the written number
+ */
+uint8_t*
+writeVarNumber(uint8_t* pos, uint64_t number)
+{
+  size_t nBytes;
+  if (number < 253) {
+    *pos++ = static_cast<uint8_t>(number);
+    return pos;
+  }
+  else if (number <= 0xFFFF) {
+    *pos++ = 253;
+    nBytes = 2;
+  }
+  else if (number <= 0xFFFFFFFF) {
+    *pos++ = 254;
+    nBytes = 4;
+  }
+  else {
+    *pos++ = 255;
+    nBytes = 8;
+  }
+  for (size_t i = nBytes; i > 0; --i) {
+    *pos++ = static_cast<uint8_t>(number >> (8 * (i - 1)));
+  }
+  return pos;
+}
+
+} // namespace
+
+DataTemplate::DataTemplate()
+  : m_signature(0)
+{
+  Encode();
+}
+
+void
+DataTemplate::SetFields(Time freshness, uint32_t signature, const Name& keyLocator)
+{
+  if (freshness == m_freshness && signature == m_signature && keyLocator == m_keyLocator) {
+    return;
+  }
+
+  m_freshness = freshness;
+  m_signature = signature;
+  m_keyLocator = keyLocator;
+  Encode();
+}
+
+void
+DataTemplate::Encode()
+{
+  // encode a prototype with empty name and content the usual way and keep the other fields
+  Data data;
+  data.setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
+
+  Signature signature;
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+  if (m_keyLocator.size() > 0) {
+    signatureInfo.setKeyLocator(m_keyLocator);
+  }
+  signature.setInfo(signatureInfo);
+  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
+  data.setSignature(signature);
+
+  Block wire = data.wireEncode();
+  wire.parse();
+
+  m_beforeContent.clear();
+  m_afterContent.clear();
+  bool isAfterContent = false;
+  for (const Block& element : wire.elements()) {
+    if (element.type() == ::ndn::tlv::Name) {
+      continue;
+    }
+    if (element.type() == ::ndn::tlv::Content) {
+      isAfterContent = true;
+      continue;
+    }
+    std::vector<uint8_t>& fields = isAfterContent ? m_afterContent : m_beforeContent;
+    fields.insert(fields.end(), element.begin(), element.end());
+  }
+  NS_ASSERT_MSG(isAfterContent, "Encoded Data does not contain content");
+}
+
+shared_ptr<Data>
+DataTemplate::Create(const Name& name, size_t payloadSize) const
+{
+  return Create(name, nullptr, payloadSize);
+}
+
+shared_ptr<Data>
+DataTemplate::Create(const Name& name, const uint8_t* content, size_t contentSize) const
+{
+  auto wire = Allocate(name, contentSize);
+  if (content != nullptr) {
+    std::memcpy(wire.second, content, contentSize);
+  }
+  auto data = make_shared<Data>(Block(wire.first));
+  if (content == nullptr) {
+    BlockHeader::markVirtualPayload(data->wireEncode());
+  }
+  return data;
+}
+
+shared_ptr<Data>
+DataTemplate::Create(const Name& name, const std::vector<Block>& elements) const
+{
+  size_t contentSize = 0;
+  for (const auto& element : elements) {
+    contentSize += element.size();
+  }
+
+  auto wire = Allocate(name, contentSize);
+  uint8_t* pos = wire.second;
+  for (const auto& element : elements) {
+    pos = std::copy(element.begin(), element.end(), pos);
+  }
+  return make_shared<Data>(Block(wire.first));
+}
+
+std::pair<shared_ptr< ::ndn::Buffer>, uint8_t*>
+DataTemplate::Allocate(const Name& name, size_t contentSize) const
+{
+  const Block& nameWire = name.wireEncode();
+  size_t contentLength = ::ndn::tlv::sizeOfVarNumber(::ndn::tlv::Content)
+                         + ::ndn::tlv::sizeOfVarNumber(contentSize) + contentSize;
+  size_t length = nameWire.size() + m_beforeContent.size() + contentLength
+                  + m_afterContent.size();
+
+  // zero-initialized, so virtual payload does not need to be written
+  auto buffer = make_shared< ::ndn::Buffer>(::ndn::tlv::sizeOfVarNumber(::ndn::tlv::Data)
+                                            + ::ndn::tlv::sizeOfVarNumber(length) + length);
+  uint8_t* pos = buffer->data();
+  pos = writeVarNumber(pos, ::ndn::tlv::Data);
+  pos = writeVarNumber(pos, length);
+  pos = std::copy(nameWire.begin(), nameWire.end(), pos);
+  pos = std::copy(m_beforeContent.begin(), m_beforeContent.end(), pos);
+  pos = writeVarNumber(pos, ::ndn::tlv::Content);
+  pos = writeVarNumber(pos, contentSize);
+  uint8_t* content = pos;
+  std::copy(m_afterContent.begin(), m_afterContent.end(), pos + contentSize);
+
+  return {buffer, content};
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_DATA_TEMPLATE_HPP
+#define NDNSIM_UTILS_DATA_TEMPLATE_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Factory of Data packets that share everything but name and content
+ *
+ * Applications sign Data with a fake signature, so MetaInfo (freshness), SignatureInfo (key
+ * locator), and SignatureValue are the same for all Data of an application.  The template
+ * encodes these fields once; every Data is then written directly into a single buffer from
+ * the encoded name, the content, and the pre-encoded fields, without building and encoding the
+ * individual fields.  The created Data carries its wire encoding, as if wireEncode() had been
+ * called.
+ */
+class DataTemplate {
+public:
+  DataTemplate();
+
+  /**
+   * @brief Set fields shared by all Data created from the template
+   * @param freshness freshness period, zero to omit
+   * @param signature value of the fake signature
+   * @param keyLocator name of the key locator, empty to omit
+   *
+   * The fields are encoded again only if they differ from the current ones, so applications can
+   * call this for every packet to follow changes of their attributes.
+   */
+  void
+  SetFields(Time freshness, uint32_t signature, const Name& keyLocator);
+
+  /**
+   * @brief Create Data named @p name with @p payloadSize zero bytes of content, marked as
+   *        virtual payload (BlockHeader::markVirtualPayload)
+   */
+  shared_ptr<Data>
+  Create(const Name& name, size_t payloadSize) const;
+
+  /**
+   * @brief Create Data named @p name with a copy of @p contentSize bytes of @p content, or with
+   *        @p contentSize zero bytes of virtual payload if @p content is nullptr
+   */
+  shared_ptr<Data>
+  Create(const Name& name, const uint8_t* content, size_t contentSize) const;
+
+  /**
+   * @brief Create Data named @p name whose content is the concatenation of @p elements
+   */
+  shared_ptr<Data>
+  Create(const Name& name, const std::vector<Block>& elements) const;
+
+private:
+  void
+  Encode();
+
+  /**
+   * @brief Allocate the wire of Data named @p name with @p contentSize bytes of content
+   * @return the wire and the first byte of the content, which is left zero
+   */
+  std::pair<shared_ptr< ::ndn::Buffer>, uint8_t*>
+  Allocate(const Name& name, size_t contentSize) const;
+
+private:
+  Time m_freshness;
+  uint32_t m_signature;
+  Name m_keyLocator;
+
+  std::vector<uint8_t> m_beforeContent; ///< @brief encoded fields between name and content
+  std::vector<uint8_t> m_afterContent;  ///< @brief encoded fields after content
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_DATA_TEMPLATE_HPP
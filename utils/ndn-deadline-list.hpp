@@ -0,0 +1,238 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#ifndef NDNSIM_UTILS_DEADLINE_LIST_HPP
+#define NDNSIM_UTILS_DEADLINE_LIST_HPP
+
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/simulator.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+#include <functional>
+
+namespace ns3 {
+namespace ndn {
+
+template<class Entry>
+class DeadlineList;
+
+/**
+ * @brief Base of entries kept in a DeadlineList
+ */
+class DeadlineListHook {
+public:
+  DeadlineListHook()
+    : m_isLinked(false)
+    , m_prev(nullptr)
+    , m_next(nullptr)
+  {
+  }
+
+  bool
+  isLinked() const
+  {
+    return m_isLinked;
+  }
+
+private:
+  Time m_lastTouch;
+  bool m_isLinked;
+  DeadlineListHook* m_prev;
+  DeadlineListHook* m_next;
+
+  template<class Entry>
+  friend class DeadlineList;
+};
+
+/**
+ * @brief Entries that expire once a common timeout has passed since they were last touched
+ *
+ * As all entries share the same timeout, the earliest deadline is always the one of the least
+ * recently touched entry.  Entries are therefore kept in an intrusive list ordered by the time
+ * they were touched, making touch, remove, and expiry O(1).  A single simulator event is armed
+ * for the earliest deadline, rounded up to a multiple of the granularity, and is only
+ * rescheduled when that deadline moves earlier.
+ *
+ * Entries derive from DeadlineListHook and must stay at the same address while they are in the
+ * list (e.g., as values of a std::unordered_map); an entry must be removed before it is
+ * destroyed.
+ */
+template<class Entry>
+class DeadlineList : boost::noncopyable {
+public:
+  typedef std::function<Time()> TimeoutGetter;
+
+  /**
+   * @brief Callback for an expired entry, which is already removed from the list
+   *
+   * The callback may touch the entry again or destroy it.
+   */
+  typedef std::function<void(Entry& entry)> ExpireCallback;
+
+  /**
+   * @param getTimeout called for the current timeout whenever deadlines are checked
+   * @param onExpire   called for every expired entry
+   */
+  DeadlineList(const TimeoutGetter& getTimeout, const ExpireCallback& onExpire)
+    : m_head(nullptr)
+    , m_tail(nullptr)
+    , m_getTimeout(getTimeout)
+    , m_onExpire(onExpire)
+    , m_granularity(0)
+  {
+  }
+
+  ~DeadlineList()
+  {
+    m_event.Cancel();
+  }
+
+  /**
+   * @brief Set granularity of deadlines (default 0, i.e., exact deadlines)
+   */
+  void
+  setGranularity(Time granularity)
+  {
+    m_granularity = granularity;
+    arm();
+  }
+
+  Time
+  getGranularity() const
+  {
+    return m_granularity;
+  }
+
+  /**
+   * @brief Move @p entry to the end of the list, with its deadline counted from now
+   */
+  void
+  touch(Entry& entry)
+  {
+    if (entry.m_isLinked) {
+      unlink(entry);
+    }
+
+    entry.m_lastTouch = Simulator::Now();
+    entry.m_prev = m_tail;
+    entry.m_next = nullptr;
+    if (m_tail != nullptr) {
+      m_tail->m_next = &entry;
+    }
+    else {
+      m_head = &entry;
+    }
+    m_tail = &entry;
+    entry.m_isLinked = true;
+
+    if (m_head == &entry) {
+      arm();
+    }
+  }
+
+  /**
+   * @brief Remove @p entry from the list, if it is there
+   */
+  void
+  remove(Entry& entry)
+  {
+    if (entry.m_isLinked) {
+      unlink(entry);
+    }
+  }
+
+  /**
+   * @brief Schedule expiry for the earliest deadline
+   *
+   * Must be called when the timeout becomes shorter.
+   */
+  void
+  arm()
+  {
+    if (m_head == nullptr) {
+      return; // a pending event will find nothing to do
+    }
+
+    Time now = Simulator::Now();
+    Time deadline = std::max(m_head->m_lastTouch + m_getTimeout(), now);
+    if (m_granularity.IsStrictlyPositive()) {
+      int64_t step = m_granularity.GetTimeStep();
+      deadline = TimeStep((deadline.GetTimeStep() + step - 1) / step * step);
+    }
+
+    if (m_event.IsRunning()) {
+      if (TimeStep(m_event.GetTs()) <= deadline) {
+        return; // the event will re-arm itself if it fires too early
+      }
+      m_event.Cancel();
+    }
+
+    m_event = Simulator::Schedule(deadline - now, &DeadlineList::expire, this);
+  }
+
+private:
+  void
+  unlink(DeadlineListHook& entry)
+  {
+    if (entry.m_prev != nullptr) {
+      entry.m_prev->m_next = entry.m_next;
+    }
+    else {
+      m_head = entry.m_next;
+    }
+    if (entry.m_next != nullptr) {
+      entry.m_next->m_prev = entry.m_prev;
+    }
+    else {
+      m_tail = entry.m_prev;
+    }
+    entry.m_isLinked = false;
+  }
+
+  void
+  expire()
+  {
+    Time now = Simulator::Now();
+    Time timeout = m_getTimeout();
+
+    while (m_head != nullptr && m_head->m_lastTouch + timeout <= now) {
+      Entry& entry = static_cast<Entry&>(*m_head);
+      unlink(entry);
+      m_onExpire(entry);
+    }
+
+    arm();
+  }
+
+private:
+  DeadlineListHook* m_head; ///< @brief least recently touched entry
+  DeadlineListHook* m_tail;
+
+  TimeoutGetter m_getTimeout;
+  ExpireCallback m_onExpire;
+  Time m_granularity;
+  EventId m_event;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_DEADLINE_LIST_HPP
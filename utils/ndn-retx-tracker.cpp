@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-retx-tracker.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/sequence-number.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <functional>
+
+NS_LOG_COMPONENT_DEFINE("ndn.RetxTracker");
+
+namespace ns3 {
+namespace ndn {
+
+RetxTracker::RetxTracker()
+  : m_deadlines(std::bind(&RetxTracker::GetTimeout, this),
+                std::bind(&RetxTracker::Expire, this, std::placeholders::_1))
+  , m_lifetime(Seconds(2))
+{
+}
+
+void
+RetxTracker::SetRttEstimator(Ptr<RttEstimator> rtt)
+{
+  m_rtt = rtt;
+}
+
+void
+RetxTracker::SetTimeoutCallback(const TimeoutCallback& onTimeout)
+{
+  m_onTimeout = onTimeout;
+  m_deadlines.arm();
+}
+
+void
+RetxTracker::SetGranularity(Time granularity)
+{
+  m_deadlines.setGranularity(granularity);
+}
+
+Time
+RetxTracker::GetGranularity() const
+{
+  return m_deadlines.getGranularity();
+}
+
+void
+RetxTracker::SetLifetime(Time lifetime)
+{
+  m_lifetime = lifetime;
+  m_deadlines.arm();
+}
+
+void
+RetxTracker::Sent(uint32_t seq)
+{
+  Time now = Simulator::Now();
+
+  auto result = m_entries.emplace(seq, Entry());
+  Entry& entry = result.first->second;
+  if (result.second) {
+    entry.seq = seq;
+    entry.firstSent = now;
+    entry.retxCount = 0;
+  }
+
+  entry.lastSent = now;
+  entry.retxCount++;
+  m_deadlines.touch(entry);
+
+  if (m_rtt != nullptr) {
+    m_rtt->SentSeq(SequenceNumber32(seq), 1);
+  }
+}
+
+bool
+RetxTracker::Acked(uint32_t seq, Delays& delays)
+{
+  Time now = Simulator::Now();
+
+  bool isFound = false;
+  auto entry = m_entries.find(seq);
+  if (entry != m_entries.end()) {
+    delays.lastDelay = now - entry->second.lastSent;
+    delays.fullDelay = now - entry->second.firstSent;
+    delays.retxCount = entry->second.retxCount;
+
+    m_deadlines.remove(entry->second);
+    m_entries.erase(entry);
+    isFound = true;
+  }
+
+  if (m_rtt != nullptr) {
+    m_rtt->AckSeq(SequenceNumber32(seq));
+  }
+
+  // the retransmit timeout may have changed
+  m_deadlines.arm();
+  return isFound;
+}
+
+Time
+RetxTracker::GetTimeout() const
+{
+  if (!m_onTimeout) {
+    return m_lifetime;
+  }
+
+  NS_ASSERT_MSG(m_rtt != nullptr, "Timeouts require an RTT estimator");
+  return m_rtt->RetransmitTimeout();
+}
+
+void
+RetxTracker::Expire(Entry& entry)
+{
+  if (m_onTimeout) {
+    // kept until it is sent again or satisfied; the callback may call Sent()
+    m_onTimeout(entry.seq);
+  }
+  else {
+    NS_LOG_DEBUG("Forget " << entry.seq);
+    m_entries.erase(entry.seq);
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_RETX_TRACKER_HPP
+#define NDNSIM_UTILS_RETX_TRACKER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
+#include "ns3/ndnSIM/utils/ndn-deadline-list.hpp"
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <functional>
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Tracker of outstanding Interests of consumer-style applications
+ *
+ * For every sequence number that has been sent and not yet satisfied, the tracker keeps the
+ * time of the first and of the last transmission and the number of transmissions, so that the
+ * application can report delays when Data arrives.  It also feeds the RTT estimator.
+ *
+ * When a timeout callback is set, a sequence number times out once the current retransmit
+ * timeout of the RTT estimator has passed since its last transmission; it is then kept until
+ * it is sent again or satisfied.  Without a timeout callback, a sequence number is forgotten
+ * once Lifetime has passed since its last transmission (Data cannot be received after the
+ * Interest expired), so memory stays bounded even if Data never arrives.
+ *
+ * Deadlines are kept in a DeadlineList, so send, satisfy, and timeout are O(1) and a single
+ * simulator event is armed for the earliest deadline.
+ */
+class RetxTracker : boost::noncopyable {
+public:
+  typedef std::function<void(uint32_t seq)> TimeoutCallback;
+
+  /**
+   * @brief Delays of a satisfied sequence number
+   */
+  struct Delays {
+    Time lastDelay;     ///< @brief delay since the last transmission
+    Time fullDelay;     ///< @brief delay since the first transmission
+    uint32_t retxCount; ///< @brief number of transmissions
+  };
+
+  RetxTracker();
+
+  /**
+   * @brief Set RTT estimator that is notified of transmissions and Data and that defines the
+   *        retransmit timeout
+   */
+  void
+  SetRttEstimator(Ptr<RttEstimator> rtt);
+
+  /**
+   * @brief Set callback to be called when a sequence number times out
+   *
+   * An empty callback disables timeouts.
+   */
+  void
+  SetTimeoutCallback(const TimeoutCallback& onTimeout);
+
+  /**
+   * @brief Set granularity of timeout checks (e.g., RetxTimer attribute of applications)
+   */
+  void
+  SetGranularity(Time granularity);
+
+  Time
+  GetGranularity() const;
+
+  /**
+   * @brief Set time after the last transmission when a sequence number is forgotten if no
+   *        timeout callback is set (default 2s)
+   */
+  void
+  SetLifetime(Time lifetime);
+
+  /**
+   * @brief Record transmission of @p seq
+   */
+  void
+  Sent(uint32_t seq);
+
+  /**
+   * @brief Record Data for @p seq and stop tracking it
+   * @param[out] delays delays of @p seq, only set when true is returned
+   * @return whether @p seq was tracked
+   */
+  bool
+  Acked(uint32_t seq, Delays& delays);
+
+  /**
+   * @brief Get number of tracked sequence numbers
+   */
+  size_t
+  GetSize() const
+  {
+    return m_entries.size();
+  }
+
+private:
+  struct Entry : DeadlineListHook {
+    uint32_t seq;
+    Time firstSent;
+    Time lastSent;
+    uint32_t retxCount;
+  };
+
+  Time
+  GetTimeout() const;
+
+  void
+  Expire(Entry& entry);
+
+private:
+  std::unordered_map<uint32_t, Entry> m_entries;
+  DeadlineList<Entry> m_deadlines; ///< @brief entries that have not timed out
+
+  Ptr<RttEstimator> m_rtt;
+  TimeoutCallback m_onTimeout;
+  Time m_lifetime;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_RETX_TRACKER_HPP
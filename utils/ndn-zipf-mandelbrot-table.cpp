@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-zipf-mandelbrot-table.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ZipfMandelbrotTable");
+
+namespace ns3 {
+namespace ndn {
+
+std::shared_ptr<const ZipfMandelbrotTable>
+ZipfMandelbrotTable::Get(uint32_t n, double q, double s)
+{
+  typedef std::tuple<uint32_t, double, double> Key;
+  static std::mutex mutex;
+  static std::map<Key, std::weak_ptr<const ZipfMandelbrotTable>> tables;
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  for (auto it = tables.begin(); it != tables.end();) {
+    if (it->second.expired()) {
+      it = tables.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+
+  std::weak_ptr<const ZipfMandelbrotTable>& cached = tables[Key(n, q, s)];
+  std::shared_ptr<const ZipfMandelbrotTable> table = cached.lock();
+  if (table == nullptr) {
+    table = std::make_shared<ZipfMandelbrotTable>(n, q, s);
+    cached = table;
+  }
+  return table;
+}
+
+ZipfMandelbrotTable::ZipfMandelbrotTable(uint32_t n, double q, double s)
+  : m_q(q)
+  , m_s(s)
+  , m_threshold(n)
+  , m_alias(n)
+{
+  NS_ASSERT_MSG(n > 0, "Zipf-Mandelbrot distribution needs at least one rank");
+  NS_LOG_DEBUG(q << " and " << s << " and " << n);
+
+  // probabilities scaled so that they average to 1 over the columns
+  std::vector<double> scaled(n);
+  double sum = 0.0;
+  for (uint32_t i = 0; i < n; i++) {
+    scaled[i] = 1.0 / std::pow(i + 1 + q, s);
+    sum += scaled[i];
+  }
+  for (uint32_t i = 0; i < n; i++) {
+    scaled[i] = scaled[i] * n / sum;
+  }
+
+  // Vose's alias method: fill each column below 1 with the excess of a column above 1
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  for (uint32_t i = n; i > 0; i--) {
+    (scaled[i - 1] < 1.0 ? small : large).push_back(i - 1);
+  }
+
+  const double scale = 4294967296.0; // 2^32
+  while (!small.empty() && !large.empty()) {
+    uint32_t less = small.back();
+    uint32_t more = large.back();
+    small.pop_back();
+
+    m_threshold[less] = static_cast<uint32_t>(scaled[less] * scale);
+    m_alias[less] = more;
+
+    scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+    if (scaled[more] < 1.0) {
+      large.pop_back();
+      small.push_back(more);
+    }
+  }
+
+  // remaining columns are full, up to rounding errors
+  for (uint32_t i : large) {
+    m_threshold[i] = std::numeric_limits<uint32_t>::max();
+    m_alias[i] = i;
+  }
+  for (uint32_t i : small) {
+    m_threshold[i] = std::numeric_limits<uint32_t>::max();
+    m_alias[i] = i;
+  }
+}
+
+uint32_t
+ZipfMandelbrotTable::Sample(double column, double coin) const
+{
+  uint32_t n = GetN();
+  uint32_t i = std::min(static_cast<uint32_t>(column * n), n - 1);
+  if (coin * 4294967296.0 < m_threshold[i]) {
+    return i + 1;
+  }
+  return m_alias[i] + 1;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_ZIPF_MANDELBROT_TABLE_HPP
+#define NDNSIM_UTILS_ZIPF_MANDELBROT_TABLE_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Alias table to draw ranks 1..N following the Zipf-Mandelbrot distribution
+ *
+ * Rank k is drawn with probability proportional to 1 / (k + q)^s.  The table is built once in
+ * O(N) using Vose's alias method, takes 8 bytes per rank, and draws a rank in O(1) from two
+ * uniform random numbers: the first one selects a column, the second one selects either the
+ * rank of the column or its alias.
+ *
+ * Tables are immutable and shared: Get returns the same table to all callers asking for the
+ * same (N, q, s) for as long as one of them keeps it.
+ */
+class ZipfMandelbrotTable : boost::noncopyable {
+public:
+  /**
+   * @brief Get the table for @p n ranks and parameters @p q and @p s, building it if needed
+   *
+   * This method is thread-safe.
+   */
+  static std::shared_ptr<const ZipfMandelbrotTable>
+  Get(uint32_t n, double q, double s);
+
+  /**
+   * @brief Build a table for @p n ranks (at least 1) and parameters @p q and @p s
+   *
+   * Use Get to share tables between applications.
+   */
+  ZipfMandelbrotTable(uint32_t n, double q, double s);
+
+  /**
+   * @brief Draw a rank in [1, N]
+   * @param column uniform random number in [0, 1)
+   * @param coin   uniform random number in [0, 1), independent from @p column
+   */
+  uint32_t
+  Sample(double column, double coin) const;
+
+  uint32_t
+  GetN() const
+  {
+    return static_cast<uint32_t>(m_alias.size());
+  }
+
+  double
+  GetQ() const
+  {
+    return m_q;
+  }
+
+  double
+  GetS() const
+  {
+    return m_s;
+  }
+
+private:
+  double m_q;
+  double m_s;
+  std::vector<uint32_t> m_threshold; ///< @brief coin below threshold / 2^32 selects the column
+  std::vector<uint32_t> m_alias;     ///< @brief zero-based rank selected otherwise
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_ZIPF_MANDELBROT_TABLE_HPP
@@ -150,6 +150,19 @@ AnnotatedTopologyReader::GetLinks() const
   return m_linksList;
 }
 
+void
+AnnotatedTopologyReader::SetSystemId(Ptr<Node> node, uint32_t systemId)
+{
+  m_systemIds[node->GetId()] = systemId;
+}
+
+uint32_t
+AnnotatedTopologyReader::GetSystemId(Ptr<Node> node) const
+{
+  auto systemId = m_systemIds.find(node->GetId());
+  return systemId != m_systemIds.end() ? systemId->second : node->GetSystemId();
+}
+
 NodeContainer
 AnnotatedTopologyReader::Read(void)
 {
@@ -445,7 +458,7 @@ AnnotatedTopologyReader::SaveTopology(const std::string& file)
      << "router\n"
      << "\n"
      << "# each line in this section represents one router and should have the following data\n"
-     << "# node  comment     yPos    xPos\n";
+     << "# node  comment     yPos    xPos    systemId\n";
 
   for (NodeContainer::Iterator node = m_nodes.Begin(); node != m_nodes.End(); node++) {
     std::string name = Names::FindName(*node);
@@ -454,7 +467,7 @@ AnnotatedTopologyReader::SaveTopology(const std::string& file)
 
     os << name << "\t"
        << "NA"
-       << "\t" << -position.y << "\t" << position.x << "\n";
+       << "\t" << -position.y << "\t" << position.x << "\t" << GetSystemId(*node) << "\n";
   }
 
   os
@@ -27,6 +27,8 @@
 #include "ns3/object-factory.h"
 #include "ns3/node-container.h"
 
+#include <map>
+
 namespace ns3 {
 
 /**
@@ -105,7 +107,24 @@ public:
   ApplyOspfMetric();
 
   /**
-   * \brief Save positions (e.g., after manual modification using visualizer)
+   * \brief Set system id (MPI rank) of the node in topology files written by SaveTopology
+   *
+   * The node itself keeps the system id it was created with, so the new assignment takes effect
+   * only when the saved topology is read again (e.g., by a parallel simulation).
+   *
+   * \see TopologyPartitioner
+   */
+  void
+  SetSystemId(Ptr<Node> node, uint32_t systemId);
+
+  /**
+   * \brief Get system id of the node as written by SaveTopology
+   */
+  uint32_t
+  GetSystemId(Ptr<Node> node) const;
+
+  /**
+   * \brief Save positions (e.g., after manual modification using visualizer) and system ids
    */
   virtual void
   SaveTopology(const std::string& file);
@@ -148,6 +167,7 @@ private:
   double m_scale;
 
   uint32_t m_requiredPartitions;
+  std::map<uint32_t, uint32_t> m_systemIds; ///< \brief system ids set by SetSystemId, by node id
 };
 }
 
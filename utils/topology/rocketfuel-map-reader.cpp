@@ -481,14 +481,14 @@ RocketfuelMapReader::GetCustomerRouters() const
 }
 
 static void
-nodeWriter(std::ostream& os, NodeContainer& m)
+nodeWriter(std::ostream& os, NodeContainer& m, const AnnotatedTopologyReader& reader)
 {
   for (NodeContainer::Iterator node = m.Begin(); node != m.End(); node++) {
     std::string name = Names::FindName(*node);
 
     os << name << "\t"
        << "NA"
-       << "\t" << 0 << "\t" << 0 << "\n";
+       << "\t" << 0 << "\t" << 0 << "\t" << reader.GetSystemId(*node) << "\n";
   }
 };
 
@@ -506,11 +506,11 @@ RocketfuelMapReader::SaveTopology(const std::string& file)
      << "router\n"
      << "\n"
      << "# each line in this section represents one router and should have the following data\n"
-     << "# node  comment     yPos    xPos\n";
+     << "# node  comment     yPos    xPos    systemId\n";
 
-  nodeWriter(os, m_backboneRouters);
-  nodeWriter(os, m_gatewayRouters);
-  nodeWriter(os, m_customerRouters);
+  nodeWriter(os, m_backboneRouters, *this);
+  nodeWriter(os, m_gatewayRouters, *this);
+  nodeWriter(os, m_customerRouters, *this);
 
   os << "# link section defines point-to-point links between nodes and characteristics of these "
         "links\n"
@@ -0,0 +1,402 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "topology-partitioner.hpp"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/node.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <tuple>
+
+NS_LOG_COMPONENT_DEFINE("TopologyPartitioner");
+
+namespace ns3 {
+
+namespace {
+
+const size_t NONE = std::numeric_limits<size_t>::max();
+const int MAX_REFINEMENT_PASSES = 16;
+
+struct Edge {
+  size_t from;
+  size_t to;
+  Time delay;
+};
+
+/**
+ * \brief Group nodes connected by links with delay below @p threshold
+ * \return number of groups; group of every node and weight of every group are set
+ */
+size_t
+Contract(const std::vector<double>& weights, const std::vector<Edge>& edges, Time threshold,
+         std::vector<size_t>& groups, std::vector<double>& groupWeights)
+{
+  std::vector<size_t> parents(weights.size());
+  std::iota(parents.begin(), parents.end(), 0);
+  auto find = [&parents] (size_t node) {
+    while (parents[node] != node) {
+      parents[node] = parents[parents[node]];
+      node = parents[node];
+    }
+    return node;
+  };
+
+  for (const Edge& edge : edges) {
+    if (edge.delay < threshold) {
+      parents[find(edge.to)] = find(edge.from);
+    }
+  }
+
+  std::vector<size_t> roots(weights.size(), NONE);
+  groups.resize(weights.size());
+  groupWeights.clear();
+  for (size_t node = 0; node < weights.size(); node++) {
+    size_t root = find(node);
+    if (roots[root] == NONE) {
+      roots[root] = groupWeights.size();
+      groupWeights.push_back(0);
+    }
+    groups[node] = roots[root];
+    groupWeights[groups[node]] += weights[node];
+  }
+  return groupWeights.size();
+}
+
+/**
+ * \brief Assign every item to one of @p nBins, the heaviest items first, each to the bin with
+ *        the least load (and the fewest items)
+ */
+std::vector<size_t>
+Pack(const std::vector<double>& weights, size_t nBins, std::vector<double>& loads)
+{
+  std::vector<size_t> order(weights.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&weights] (size_t a, size_t b) { return weights[a] > weights[b]; });
+
+  std::vector<size_t> bins(weights.size());
+  std::vector<size_t> counts(nBins, 0);
+  loads.assign(nBins, 0);
+  for (size_t item : order) {
+    size_t bin = 0;
+    for (size_t i = 1; i < nBins; i++) {
+      if (std::tie(loads[i], counts[i]) < std::tie(loads[bin], counts[bin])) {
+        bin = i;
+      }
+    }
+    bins[item] = bin;
+    loads[bin] += weights[item];
+    counts[bin]++;
+  }
+  return bins;
+}
+
+} // namespace
+
+TopologyPartitioner::TopologyPartitioner()
+  : m_nodeWeight(1)
+  , m_degreeWeight(1)
+  , m_applicationWeight(1)
+  , m_imbalance(0.1)
+  , m_lookahead(Time::Max())
+  , m_nCutLinks(0)
+{
+}
+
+void
+TopologyPartitioner::SetNodeWeight(double weight)
+{
+  m_nodeWeight = weight;
+}
+
+void
+TopologyPartitioner::SetDegreeWeight(double weight)
+{
+  m_degreeWeight = weight;
+}
+
+void
+TopologyPartitioner::SetApplicationWeight(double weight)
+{
+  m_applicationWeight = weight;
+}
+
+void
+TopologyPartitioner::SetWeight(Ptr<Node> node, double weight)
+{
+  m_weights[node->GetId()] = weight;
+}
+
+void
+TopologyPartitioner::SetImbalance(double imbalance)
+{
+  m_imbalance = imbalance;
+}
+
+void
+TopologyPartitioner::Partition(const NodeContainer& nodes,
+                               const std::list<TopologyReader::Link>& links, uint32_t nPartitions)
+{
+  size_t nNodes = nodes.GetN();
+  NS_ASSERT_MSG(nPartitions > 0 && nPartitions <= nNodes,
+                "Cannot partition " << nNodes << " nodes into " << nPartitions << " partitions");
+
+  std::map<uint32_t, size_t> indices; // by node id
+  for (size_t i = 0; i < nNodes; i++) {
+    indices[nodes.Get(i)->GetId()] = i;
+  }
+
+  std::vector<Edge> edges;
+  std::vector<uint32_t> degrees(nNodes, 0);
+  for (const TopologyReader::Link& link : links) {
+    auto from = indices.find(link.GetFromNode()->GetId());
+    auto to = indices.find(link.GetToNode()->GetId());
+    NS_ASSERT_MSG(from != indices.end() && to != indices.end(), "Link to an unknown node");
+
+    std::string delay;
+    edges.push_back({from->second, to->second,
+                     link.GetAttributeFailSafe("Delay", delay) ? Time(delay) : Time(0)});
+    degrees[from->second]++;
+    degrees[to->second]++;
+  }
+
+  std::vector<double> weights(nNodes);
+  double total = 0;
+  for (size_t i = 0; i < nNodes; i++) {
+    Ptr<Node> node = nodes.Get(i);
+    auto weight = m_weights.find(node->GetId());
+    weights[i] = weight != m_weights.end() ? weight->second
+                                           : m_nodeWeight + m_degreeWeight * degrees[i]
+                                               + m_applicationWeight * node->GetNApplications();
+    total += weights[i];
+  }
+  double capacity = (1 + m_imbalance) * total / nPartitions;
+
+  // Find the largest delay such that groups of nodes connected by shorter links can be packed
+  // into balanced partitions.  Larger delays give fewer, heavier groups, so packing is assumed
+  // to get only harder as the delay grows.  With the smallest delay, no links are contracted.
+  std::vector<Time> delays;
+  for (const Edge& edge : edges) {
+    delays.push_back(edge.delay);
+  }
+  std::sort(delays.begin(), delays.end());
+  delays.erase(std::unique(delays.begin(), delays.end()), delays.end());
+
+  std::vector<size_t> groups;
+  std::vector<double> groupWeights;
+  std::vector<double> loads;
+  auto isBalanced = [&] (Time threshold) {
+    if (Contract(weights, edges, threshold, groups, groupWeights) < nPartitions) {
+      return false;
+    }
+    Pack(groupWeights, nPartitions, loads);
+    return *std::max_element(loads.begin(), loads.end()) <= capacity;
+  };
+
+  Time threshold = delays.empty() ? Time(0) : delays.front();
+  if (nPartitions > 1 && delays.size() > 1) {
+    size_t low = 0, high = delays.size() - 1;
+    while (low < high) {
+      size_t middle = (low + high + 1) / 2;
+      if (isBalanced(delays[middle])) {
+        low = middle;
+      }
+      else {
+        high = middle - 1;
+      }
+    }
+    threshold = delays[low];
+  }
+  bool isPackable = isBalanced(threshold);
+  size_t nGroups = groupWeights.size();
+
+  // links between groups
+  std::vector<std::map<size_t, double>> adjacency(nGroups);
+  for (const Edge& edge : edges) {
+    size_t from = groups[edge.from], to = groups[edge.to];
+    if (from != to) {
+      adjacency[from][to] += 1;
+      adjacency[to][from] += 1;
+    }
+  }
+
+  // Grow partitions one by one, starting from the heaviest unassigned group and adding the
+  // neighbor with the most links to the partition, until the partition has its share of load
+  std::vector<size_t> byWeight(nGroups);
+  std::iota(byWeight.begin(), byWeight.end(), 0);
+  std::stable_sort(byWeight.begin(), byWeight.end(), [&groupWeights] (size_t a, size_t b) {
+      return groupWeights[a] > groupWeights[b];
+    });
+
+  std::vector<size_t> parts(nGroups, NONE);
+  loads.assign(nPartitions, 0);
+  size_t nUnassigned = nGroups;
+  for (size_t part = 0; part + 1 < nPartitions; part++) {
+    auto fits = [&] (size_t group) {
+      return parts[group] == NONE
+             && (loads[part] == 0 || loads[part] + groupWeights[group] <= capacity);
+    };
+
+    std::vector<double> links(nGroups, 0);
+    std::priority_queue<std::tuple<double, size_t>> frontier; // (links, group), may be stale
+    while (loads[part] < total / nPartitions && nUnassigned > nPartitions - 1 - part) {
+      size_t next = NONE;
+      while (!frontier.empty() && next == NONE) {
+        size_t group = std::get<1>(frontier.top());
+        if (fits(group) && std::get<0>(frontier.top()) == links[group]) {
+          next = group;
+        }
+        frontier.pop();
+      }
+      for (size_t i = 0; i < nGroups && next == NONE; i++) {
+        if (fits(byWeight[i])) {
+          next = byWeight[i];
+        }
+      }
+      if (next == NONE) {
+        break;
+      }
+
+      parts[next] = part;
+      loads[part] += groupWeights[next];
+      nUnassigned--;
+      for (const auto& neighbor : adjacency[next]) {
+        if (parts[neighbor.first] == NONE) {
+          links[neighbor.first] += neighbor.second;
+          frontier.push(std::make_tuple(links[neighbor.first], neighbor.first));
+        }
+      }
+    }
+  }
+  for (size_t group = 0; group < nGroups; group++) {
+    if (parts[group] == NONE) {
+      parts[group] = nPartitions - 1;
+      loads[nPartitions - 1] += groupWeights[group];
+    }
+  }
+
+  if (isPackable && *std::max_element(loads.begin(), loads.end()) > capacity) {
+    NS_LOG_DEBUG("Grown partitions are not balanced, packing groups instead");
+    parts = Pack(groupWeights, nPartitions, loads);
+  }
+
+  // Move groups to the partition they have most links to, or to an adjacent partition with
+  // less load if that does not cut more links
+  std::vector<size_t> counts(nPartitions, 0);
+  for (size_t part : parts) {
+    counts[part]++;
+  }
+  for (int pass = 0; pass < MAX_REFINEMENT_PASSES; pass++) {
+    bool isMoved = false;
+    for (size_t group = 0; group < nGroups; group++) {
+      size_t from = parts[group];
+      if (counts[from] == 1) {
+        continue; // keep every partition
+      }
+
+      std::map<size_t, double> links;
+      for (const auto& neighbor : adjacency[group]) {
+        links[parts[neighbor.first]] += neighbor.second;
+      }
+
+      size_t to = from;
+      double bestGain = 0;
+      for (const auto& part : links) {
+        double load = loads[part.first] + groupWeights[group];
+        if (part.first == from || load > capacity) {
+          continue;
+        }
+        double gain = part.second - links[from];
+        if (gain < 0 || (gain == 0 && load >= loads[from])) {
+          continue;
+        }
+        if (to == from || gain > bestGain
+            || (gain == bestGain && loads[part.first] < loads[to])) {
+          to = part.first;
+          bestGain = gain;
+        }
+      }
+
+      if (to != from) {
+        parts[group] = to;
+        loads[from] -= groupWeights[group];
+        loads[to] += groupWeights[group];
+        counts[from]--;
+        counts[to]++;
+        isMoved = true;
+      }
+    }
+    if (!isMoved) {
+      break;
+    }
+  }
+
+  m_systemIds.clear();
+  for (size_t i = 0; i < nNodes; i++) {
+    m_systemIds[nodes.Get(i)->GetId()] = parts[groups[i]];
+  }
+  m_loads = loads;
+
+  m_lookahead = Time::Max();
+  m_nCutLinks = 0;
+  for (const Edge& edge : edges) {
+    if (parts[groups[edge.from]] != parts[groups[edge.to]]) {
+      m_lookahead = std::min(m_lookahead, edge.delay);
+      m_nCutLinks++;
+    }
+  }
+
+  NS_LOG_INFO("Partitioned " << nNodes << " nodes into " << nPartitions << " partitions: "
+                             << m_nCutLinks << " links cut, lookahead " << m_lookahead.As(Time::MS)
+                             << ", largest load " << *std::max_element(loads.begin(), loads.end())
+                             << " of " << total);
+}
+
+void
+TopologyPartitioner::Partition(AnnotatedTopologyReader& reader, uint32_t nPartitions)
+{
+  NodeContainer nodes = reader.GetNodes();
+  Partition(nodes, reader.GetLinks(), nPartitions);
+
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    reader.SetSystemId(*node, GetSystemId(*node));
+  }
+}
+
+uint32_t
+TopologyPartitioner::GetSystemId(Ptr<Node> node) const
+{
+  auto systemId = m_systemIds.find(node->GetId());
+  NS_ASSERT_MSG(systemId != m_systemIds.end(), "Node " << node->GetId() << " was not partitioned");
+  return systemId->second;
+}
+
+double
+TopologyPartitioner::GetLoad(uint32_t systemId) const
+{
+  NS_ASSERT_MSG(systemId < m_loads.size(), "No partition " << systemId);
+  return m_loads[systemId];
+}
+
+} // namespace ns3
@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef TOPOLOGY_PARTITIONER_H
+#define TOPOLOGY_PARTITIONER_H
+
+#include "annotated-topology-reader.hpp"
+
+#include "ns3/nstime.h"
+
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Assigns system ids (MPI ranks) to the nodes of a topology for distributed simulation
+ *
+ * The partitioner balances the expected event load of the partitions, keeps the smallest delay
+ * of links between partitions (the lookahead of the distributed simulator) as large as
+ * possible, and then cuts as few links as possible:
+ *
+ * - The load of a node is estimated as NodeWeight + DegreeWeight * (number of links) +
+ *   ApplicationWeight * (number of applications), unless set explicitly with SetWeight.
+ *   A partition may exceed the average load by the imbalance factor.
+ *
+ * - Links with a delay below a threshold are never cut.  The threshold is the largest link
+ *   delay for which the nodes connected by shorter links can still be packed into balanced
+ *   partitions.
+ *
+ * - Groups of nodes connected by shorter links are then assigned by growing partitions
+ *   from the heaviest group along the most links, and refined by moving groups to the
+ *   partition they have most links to.
+ *
+ * Links without a Delay attribute count as links with zero delay.  Typical use is to partition
+ * a topology file once and use the result in parallel runs:
+ *
+ * \code
+ * AnnotatedTopologyReader reader;
+ * reader.SetFileName("topo.txt");
+ * reader.Read();
+ *
+ * TopologyPartitioner partitioner;
+ * partitioner.Partition(reader, 4);
+ * reader.SaveTopology("topo-4.txt"); // contains the system ids
+ * \endcode
+ */
+class TopologyPartitioner {
+public:
+  TopologyPartitioner();
+
+  /**
+   * \brief Set load of every node (default 1)
+   */
+  void
+  SetNodeWeight(double weight);
+
+  /**
+   * \brief Set load of every link of a node (default 1)
+   */
+  void
+  SetDegreeWeight(double weight);
+
+  /**
+   * \brief Set load of every application installed on a node (default 1)
+   */
+  void
+  SetApplicationWeight(double weight);
+
+  /**
+   * \brief Set load of @p node instead of the estimate
+   */
+  void
+  SetWeight(Ptr<Node> node, double weight);
+
+  /**
+   * \brief Set by how much the load of a partition may exceed the average (default 0.1)
+   */
+  void
+  SetImbalance(double imbalance);
+
+  /**
+   * \brief Partition @p nodes connected by @p links into @p nPartitions
+   *
+   * All nodes at both ends of the links must be in @p nodes, and @p nPartitions must not
+   * exceed the number of nodes.
+   */
+  void
+  Partition(const NodeContainer& nodes, const std::list<TopologyReader::Link>& links,
+            uint32_t nPartitions);
+
+  /**
+   * \brief Partition nodes and links read by @p reader and set the system ids of the nodes in
+   *        @p reader, to be written by AnnotatedTopologyReader::SaveTopology
+   */
+  void
+  Partition(AnnotatedTopologyReader& reader, uint32_t nPartitions);
+
+  /**
+   * \brief Get system id assigned to @p node by the last partitioning
+   */
+  uint32_t
+  GetSystemId(Ptr<Node> node) const;
+
+  /**
+   * \brief Get smallest delay of a link between partitions (Time::Max () if none)
+   */
+  Time
+  GetLookahead() const
+  {
+    return m_lookahead;
+  }
+
+  /**
+   * \brief Get number of links between partitions
+   */
+  uint32_t
+  GetNCutLinks() const
+  {
+    return m_nCutLinks;
+  }
+
+  /**
+   * \brief Get estimated load of the partition with @p systemId
+   */
+  double
+  GetLoad(uint32_t systemId) const;
+
+private:
+  double m_nodeWeight;
+  double m_degreeWeight;
+  double m_applicationWeight;
+  double m_imbalance;
+  std::map<uint32_t, double> m_weights; ///< \brief weights set by SetWeight, by node id
+
+  std::map<uint32_t, uint32_t> m_systemIds; ///< \brief by node id
+  std::vector<double> m_loads;
+  Time m_lookahead;
+  uint32_t m_nCutLinks;
+};
+
+} // namespace ns3
+
+#endif // TOPOLOGY_PARTITIONER_H
@@ -18,6 +18,8 @@
  **/
 
 #include "l2-rate-tracer.hpp"
+#include "ndn-binary-trace.hpp"
+#include "ndn-tracer-registry.hpp"
 
 #include "ns3/node.h"
 #include "ns3/packet.h"
@@ -28,86 +30,87 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 
-#include <boost/lexical_cast.hpp>
-#include <fstream>
 
 NS_LOG_COMPONENT_DEFINE("L2RateTracer");
 
 namespace ns3 {
 
-static std::list<std::tuple<std::shared_ptr<std::ostream>, std::list<Ptr<L2RateTracer>>>>
-  g_tracers;
+static bool g_isBinaryOutput = false;
 
 void
 L2RateTracer::Destroy()
 {
-  g_tracers.clear();
+  ndn::TracerRegistry::Remove<L2RateTracer>();
 }
 
 void
-L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+L2RateTracer::SetBinaryOutput(bool isEnabled)
 {
-  std::list<Ptr<L2RateTracer>> tracers;
-  std::shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    std::shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = std::shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
+  g_isBinaryOutput = isEnabled;
+}
 
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    NS_LOG_DEBUG("Node: " << boost::lexical_cast<std::string>((*node)->GetId()));
+void
+L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  ndn::TracerRegistry::Install<L2RateTracer>(NodeList::Begin(), NodeList::End(), file,
+                                             averagingPeriod);
+}
 
-    Ptr<L2RateTracer> trace = Create<L2RateTracer>(outputStream, *node);
-    trace->SetAveragingPeriod(averagingPeriod);
-    tracers.push_back(trace);
+void
+L2RateTracer::AttachOutput(const std::list<Ptr<L2RateTracer>>& tracers,
+                           std::shared_ptr<std::ostream> os)
+{
+  if (g_isBinaryOutput) {
+    auto writer = std::make_shared<ndn::BinaryTraceWriter>(os,
+                                                           std::vector<ndn::BinaryTraceColumn>{
+        {ndn::BinaryTraceColumn::DOUBLE, "Time"},
+        {ndn::BinaryTraceColumn::SYMBOL, "Node"},
+        {ndn::BinaryTraceColumn::SYMBOL, "Interface"},
+        {ndn::BinaryTraceColumn::SYMBOL, "Type"},
+        {ndn::BinaryTraceColumn::INTEGER, "Packets"},
+        {ndn::BinaryTraceColumn::INTEGER, "Kilobytes"},
+        {ndn::BinaryTraceColumn::INTEGER, "PacketsRaw"},
+        {ndn::BinaryTraceColumn::DOUBLE, "KilobytesRaw"},
+      });
+    for (const auto& trace : tracers) {
+      trace->m_writer = writer;
+    }
   }
-
-  if (tracers.size() > 0) {
+  else if (tracers.size() > 0) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    tracers.front()->PrintHeader(*os);
+    *os << "\n";
   }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
 
 L2RateTracer::L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node)
   : L2Tracer(node)
   , m_os(os)
+  , m_period(Seconds(1.0))
 {
-  SetAveragingPeriod(Seconds(1.0));
 }
 
 L2RateTracer::~L2RateTracer()
 {
-  m_printEvent.Cancel();
 }
 
 void
 L2RateTracer::SetAveragingPeriod(const Time& period)
 {
   m_period = period;
-  m_printEvent.Cancel();
-  m_printEvent = Simulator::Schedule(m_period, &L2RateTracer::PeriodicPrinter, this);
+  ndn::TracerRegistry::SetPeriod(this, period);
 }
 
 void
 L2RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_writer != nullptr) {
+    Write(*m_writer);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
-
-  m_printEvent = Simulator::Schedule(m_period, &L2RateTracer::PeriodicPrinter, this);
 }
 
 void
@@ -150,12 +153,37 @@ const double alpha = 0.8;
   STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
                        + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << interface << "\t" << printName << "\t" \
-     << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t" << STATS(0).fieldName << "\t"     \
-     << STATS(1).fieldName / 1024.0 << "\n";
+  if (writer != nullptr) {                                                                         \
+    writer->AddDouble(time.ToDouble(Time::S));                                                     \
+    writer->AddSymbol(m_node);                                                                     \
+    writer->AddSymbol(interface);                                                                  \
+    writer->AddSymbol(printName);                                                                  \
+    writer->AddInteger(STATS(2).fieldName);                                                        \
+    writer->AddInteger(STATS(3).fieldName);                                                        \
+    writer->AddInteger(STATS(0).fieldName);                                                        \
+    writer->AddDouble(STATS(1).fieldName / 1024.0);                                                \
+    writer->EndRow();                                                                              \
+  }                                                                                                \
+  else {                                                                                           \
+    *os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << interface << "\t" << printName      \
+        << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"                        \
+        << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";                      \
+  }
 
 void
 L2RateTracer::Print(std::ostream& os) const
+{
+  Output(&os, nullptr);
+}
+
+void
+L2RateTracer::Write(ndn::BinaryTraceWriter& writer) const
+{
+  Output(nullptr, &writer);
+}
+
+void
+L2RateTracer::Output(std::ostream* os, ndn::BinaryTraceWriter* writer) const
 {
   Time time = Simulator::Now();
 
@@ -23,13 +23,17 @@
 #include "l2-tracer.hpp"
 
 #include "ns3/nstime.h"
-#include "ns3/event-id.h"
 
+#include <list>
 #include <tuple>
-#include <map>
 
 namespace ns3 {
 
+namespace ndn {
+class BinaryTraceWriter;
+class TracerRegistry;
+} // namespace ndn
+
 /**
  * @ingroup ndn-tracers
  * @brief Tracer to collect link-layer rate information about links
@@ -69,6 +73,19 @@ public:
   static void
   Destroy();
 
+  /**
+   * @brief Write traces in the binary columnar format of ndn::BinaryTraceWriter instead of
+   *        tab-separated text (default false)
+   *
+   * Affects tracers installed after the call.  ndn::BinaryTraceReader::ConvertToTsv converts
+   * binary traces back to the text format.
+   */
+  static void
+  SetBinaryOutput(bool isEnabled);
+
+  /**
+   * @brief Change the period with which the tracer prints and averages rates
+   */
   void
   SetAveragingPeriod(const Time& period);
 
@@ -78,10 +95,22 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write current trace data to a binary trace
+   */
+  void
+  Write(ndn::BinaryTraceWriter& writer) const;
+
   virtual void
   Drop(Ptr<const Packet>);
 
 private:
+  static void
+  AttachOutput(const std::list<Ptr<L2RateTracer>>& tracers, std::shared_ptr<std::ostream> os);
+
+  void
+  Output(std::ostream* os, ndn::BinaryTraceWriter* writer) const;
+
   void
   PeriodicPrinter();
 
@@ -90,10 +119,12 @@ private:
 
 private:
   std::shared_ptr<std::ostream> m_os;
+  std::shared_ptr<ndn::BinaryTraceWriter> m_writer; // set instead of printing to m_os if binary
   Time m_period;
-  EventId m_printEvent;
 
   mutable std::tuple<Stats, Stats, Stats, Stats> m_stats;
+
+  friend class ndn::TracerRegistry;
 };
 
 } // namespace ns3
@@ -18,6 +18,7 @@
  **/
 
 #include "ndn-app-delay-tracer.hpp"
+#include "ndn-binary-trace.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -42,12 +43,54 @@ namespace ndn {
 static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<AppDelayTracer>>>>
   g_tracers;
 
+static bool g_isBinaryOutput = false;
+static Time g_histogramPeriod = Seconds(0);
+
 void
 AppDelayTracer::Destroy()
 {
   g_tracers.clear();
 }
 
+void
+AppDelayTracer::SetBinaryOutput(bool isEnabled)
+{
+  g_isBinaryOutput = isEnabled;
+}
+
+void
+AppDelayTracer::SetHistogramPeriod(Time period)
+{
+  g_histogramPeriod = period;
+}
+
+void
+AppDelayTracer::AttachOutput(const std::list<Ptr<AppDelayTracer>>& tracers,
+                             shared_ptr<std::ostream> os)
+{
+  if (g_isBinaryOutput && !g_histogramPeriod.IsStrictlyPositive()) {
+    auto writer = make_shared<BinaryTraceWriter>(os, std::vector<BinaryTraceColumn>{
+        {BinaryTraceColumn::DOUBLE, "Time"},
+        {BinaryTraceColumn::SYMBOL, "Node"},
+        {BinaryTraceColumn::INTEGER, "AppId"},
+        {BinaryTraceColumn::INTEGER, "SeqNo"},
+        {BinaryTraceColumn::SYMBOL, "Type"},
+        {BinaryTraceColumn::DOUBLE, "DelayS"},
+        {BinaryTraceColumn::DOUBLE, "DelayUS"},
+        {BinaryTraceColumn::INTEGER, "RetxCount"},
+        {BinaryTraceColumn::INTEGER, "HopCount"},
+      });
+    for (const auto& trace : tracers) {
+      trace->m_writer = writer;
+    }
+  }
+  else if (tracers.size() > 0) {
+    // *m_l3RateTrace << "# "; // not necessary for R's read.table
+    tracers.front()->PrintHeader(*os);
+    *os << "\n";
+  }
+}
+
 void
 AppDelayTracer::InstallAll(const std::string& file)
 {
@@ -76,11 +119,7 @@ AppDelayTracer::InstallAll(const std::string& file)
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
+  AttachOutput(tracers, outputStream);
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
@@ -113,11 +152,7 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
+  AttachOutput(tracers, outputStream);
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
@@ -148,11 +183,7 @@ AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
   Ptr<AppDelayTracer> trace = Install(node, outputStream);
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
+  AttachOutput(tracers, outputStream);
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
@@ -174,6 +205,8 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_histogramPeriod(g_histogramPeriod)
+  , m_isHistogramActive(false)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -188,11 +221,16 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
   , m_os(os)
+  , m_histogramPeriod(g_histogramPeriod)
+  , m_isHistogramActive(false)
 {
   Connect();
 }
 
-AppDelayTracer::~AppDelayTracer(){};
+AppDelayTracer::~AppDelayTracer()
+{
+  StopHistograms();
+}
 
 void
 AppDelayTracer::Connect()
@@ -204,11 +242,28 @@ AppDelayTracer::Connect()
 
   Config::ConnectWithoutContext("/NodeList/" + m_node + "/ApplicationList/*/FirstInterestDataDelay",
                                 MakeCallback(&AppDelayTracer::FirstInterestDataDelay, this));
+
+  if (m_histogramPeriod.IsStrictlyPositive()) {
+    // per-packet traces keep their format, service delays are only recorded into histograms
+    Config::ConnectWithoutContext("/NodeList/" + m_node + "/ApplicationList/*/ServiceDelay",
+                                  MakeCallback(&AppDelayTracer::ServiceDelay, this));
+
+    m_isHistogramActive = true;
+    m_histogramEvent = Simulator::Schedule(m_histogramPeriod,
+                                           &AppDelayTracer::PeriodicHistogramPrinter, this);
+    m_destroyEvent = Simulator::ScheduleDestroy(&AppDelayTracer::StopHistograms, this);
+  }
 }
 
 void
 AppDelayTracer::PrintHeader(std::ostream& os) const
 {
+  if (m_histogramPeriod.IsStrictlyPositive()) {
+    os << "Time\tNode\tAppId\tType\tCount\tMinUS\tP50US\tP90US\tP99US\tP999US\tMaxUS\tMeanUS"
+       << "\tBuckets";
+    return;
+  }
+
   os << "Time"
      << "\t"
      << "Node"
@@ -234,22 +289,112 @@ void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "LastDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << 1 << "\t"
-        << hopCount << "\n";
+  OutputRow(app, seqno, "LastDelay", delay, 1, hopCount);
 }
 
 void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
+  OutputRow(app, seqno, "FullDelay", delay, retxCount, hopCount);
+}
+
+void
+AppDelayTracer::ServiceDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
+                             int32_t hopCount)
+{
+  OutputRow(app, seqno, "ServiceDelay", delay, retxCount, hopCount);
+}
+
+void
+AppDelayTracer::OutputRow(Ptr<App> app, uint32_t seqno, const char* type, Time delay,
+                          uint32_t retxCount, int32_t hopCount)
+{
+  if (m_histogramPeriod.IsStrictlyPositive()) {
+    m_histograms[std::make_tuple(app->GetId(), std::string(type))].Record(delay.GetMicroSeconds());
+    return;
+  }
+
+  if (m_writer != nullptr) {
+    m_writer->AddDouble(Simulator::Now().ToDouble(Time::S));
+    m_writer->AddSymbol(m_node);
+    m_writer->AddInteger(app->GetId());
+    m_writer->AddInteger(seqno);
+    m_writer->AddSymbol(type);
+    m_writer->AddDouble(delay.ToDouble(Time::S));
+    m_writer->AddDouble(delay.ToDouble(Time::US));
+    m_writer->AddInteger(retxCount);
+    m_writer->AddInteger(hopCount);
+    m_writer->EndRow();
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "FullDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << retxCount
-        << "\t" << hopCount << "\n";
+        << seqno << "\t" << type << "\t" << delay.ToDouble(Time::S) << "\t"
+        << delay.ToDouble(Time::US) << "\t" << retxCount << "\t" << hopCount << "\n";
+}
+
+void
+AppDelayTracer::PrintHistogram(const std::string& appId, const std::string& type,
+                               const LatencyHistogram& histogram)
+{
+  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << appId << "\t" << type
+        << "\t" << histogram.GetCount() << "\t" << histogram.GetMin() << "\t"
+        << histogram.GetValueAtPercentile(50) << "\t" << histogram.GetValueAtPercentile(90) << "\t"
+        << histogram.GetValueAtPercentile(99) << "\t" << histogram.GetValueAtPercentile(99.9)
+        << "\t" << histogram.GetMax() << "\t" << histogram.GetMean() << "\t" << histogram.Encode()
+        << "\n";
+}
+
+void
+AppDelayTracer::PrintHistograms()
+{
+  // per type: merged histogram of all applications and number of applications
+  std::map<std::string, std::tuple<LatencyHistogram, int>> nodeHistograms;
+
+  for (auto& entry : m_histograms) {
+    LatencyHistogram& histogram = entry.second;
+    if (histogram.GetCount() == 0) {
+      continue;
+    }
+    const std::string& type = std::get<1>(entry.first);
+    PrintHistogram(boost::lexical_cast<std::string>(std::get<0>(entry.first)), type, histogram);
+
+    auto& node = nodeHistograms[type];
+    std::get<0>(node).Merge(histogram);
+    std::get<1>(node)++;
+    histogram.Reset(); // keeps buckets allocated for the next period
+  }
+
+  for (const auto& node : nodeHistograms) {
+    if (std::get<1>(node.second) > 1) {
+      PrintHistogram("all", node.first, std::get<0>(node.second));
+    }
+  }
+}
+
+void
+AppDelayTracer::StopHistograms()
+{
+  if (!m_isHistogramActive) {
+    return;
+  }
+
+  m_isHistogramActive = false;
+  m_histogramEvent.Cancel();
+  m_destroyEvent.Cancel();
+
+  // delays recorded since the last period
+  PrintHistograms();
+}
+
+void
+AppDelayTracer::PeriodicHistogramPrinter()
+{
+  PrintHistograms();
+
+  m_histogramEvent = Simulator::Schedule(m_histogramPeriod,
+                                         &AppDelayTracer::PeriodicHistogramPrinter, this);
 }
 
 } // namespace ndn
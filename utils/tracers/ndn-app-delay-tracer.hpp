@@ -21,6 +21,7 @@
 #define CCNX_APP_DELAY_TRACER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ndn-latency-histogram.hpp"
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
@@ -30,6 +31,7 @@
 
 #include <tuple>
 #include <list>
+#include <map>
 
 namespace ns3 {
 
@@ -39,6 +41,7 @@ class Packet;
 namespace ndn {
 
 class App;
+class BinaryTraceWriter;
 
 /**
  * @ingroup ndn-tracers
@@ -100,6 +103,31 @@ public:
   static void
   Destroy();
 
+  /**
+   * @brief Write traces in the binary columnar format of BinaryTraceWriter instead of
+   *        tab-separated text (default false)
+   *
+   * Affects tracers installed with a file name after the call.  BinaryTraceReader::ConvertToTsv
+   * converts binary traces back to the text format.
+   */
+  static void
+  SetBinaryOutput(bool isEnabled);
+
+  /**
+   * @brief Record delays into per-application histograms that are written every @p period,
+   *        instead of writing a row for every received Data packet (default 0, disabled)
+   *
+   * Affects tracers installed after the call.  For every application and type of delay, a row
+   * with the number of delays, their minimum, percentiles, maximum, and mean (in microseconds),
+   * and the encoded LatencyHistogram is written at the end of each period in which delays were
+   * recorded, and for the last partial period when the simulation is destroyed.  Percentiles
+   * are upper bounds of histogram buckets, not exact delays.  If more than one application of
+   * a node recorded the same type of delay, a row with AppId "all" aggregates them.  ServiceDelay
+   * is recorded only by these tracers.  Histograms are always written as tab-separated text.
+   */
+  static void
+  SetHistogramPeriod(Time period);
+
   /**
    * @brief Trace constructor that attaches to all applications on the node using node's pointer
    * @param os    reference to the output stream
@@ -128,9 +156,16 @@ public:
   PrintHeader(std::ostream& os) const;
 
 private:
+  static void
+  AttachOutput(const std::list<Ptr<AppDelayTracer>>& tracers, shared_ptr<std::ostream> os);
+
   void
   Connect();
 
+  void
+  OutputRow(Ptr<App> app, uint32_t seqno, const char* type, Time delay, uint32_t retxCount,
+            int32_t hopCount);
+
   void
   LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
 
@@ -138,11 +173,39 @@ private:
   FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t rextCount,
                          int32_t hopCount);
 
+  void
+  ServiceDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount, int32_t hopCount);
+
+  void
+  PrintHistogram(const std::string& appId, const std::string& type,
+                 const LatencyHistogram& histogram);
+
+  void
+  PrintHistograms();
+
+  void
+  PeriodicHistogramPrinter();
+
+  /**
+   * @brief Write delays recorded since the last period and stop periodic output
+   *
+   * Called when the tracer is destroyed or when Simulator::Destroy is called, whichever is first.
+   */
+  void
+  StopHistograms();
+
 private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  shared_ptr<BinaryTraceWriter> m_writer; // set instead of printing to m_os in binary mode
+
+  Time m_histogramPeriod; // zero when a row is written for every delay
+  EventId m_histogramEvent;
+  EventId m_destroyEvent;
+  bool m_isHistogramActive;
+  std::map<std::tuple<uint32_t, std::string>, LatencyHistogram> m_histograms; // (AppId, Type)
 };
 
 } // namespace ndn
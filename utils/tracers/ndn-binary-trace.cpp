@@ -0,0 +1,356 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-binary-trace.hpp"
+
+#include "ns3/assert.h"
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace ns3 {
+namespace ndn {
+
+static const char MAGIC[] = {'N', 'D', 'N', 'T', 'R', 'A', 'C', 'E'};
+static const uint32_t VERSION = 1;
+static const char SYMBOLS_RECORD = 'S';
+static const char ROWS_RECORD = 'R';
+
+static void
+Encode(std::string& buffer, uint64_t value, size_t size)
+{
+  for (size_t i = 0; i < size; i++) {
+    buffer.push_back(static_cast<char>(value >> (8 * i)));
+  }
+}
+
+static void
+EncodeString(std::string& buffer, const std::string& value)
+{
+  Encode(buffer, value.size(), 4);
+  buffer.append(value);
+}
+
+static size_t
+GetSize(BinaryTraceColumn::Type type)
+{
+  return type == BinaryTraceColumn::SYMBOL ? 4 : 8;
+}
+
+BinaryTraceWriter::BinaryTraceWriter(shared_ptr<std::ostream> os,
+                                     const std::vector<BinaryTraceColumn>& columns,
+                                     size_t blockSize /* = 4096*/)
+  : m_os(os)
+  , m_columns(columns)
+  , m_blockSize(blockSize)
+  , m_nNewSymbols(0)
+  , m_values(columns.size())
+  , m_nRows(0)
+  , m_column(0)
+{
+  std::string header(MAGIC, sizeof(MAGIC));
+  Encode(header, VERSION, 4);
+  Encode(header, m_columns.size(), 4);
+  for (const auto& column : m_columns) {
+    Encode(header, column.type, 1);
+    EncodeString(header, column.name);
+  }
+  m_os->write(header.data(), header.size());
+
+  for (size_t i = 0; i < m_columns.size(); i++) {
+    m_values[i].reserve(m_blockSize * GetSize(m_columns[i].type));
+  }
+}
+
+BinaryTraceWriter::~BinaryTraceWriter()
+{
+  Flush();
+  m_os->flush();
+}
+
+void
+BinaryTraceWriter::AddValue(BinaryTraceColumn::Type type, uint64_t value)
+{
+  NS_ASSERT_MSG(m_column < m_columns.size(), "Too many values in a row");
+  NS_ASSERT_MSG(m_columns[m_column].type == type, "Value does not match type of column "
+                                                     << m_columns[m_column].name);
+
+  Encode(m_values[m_column], value, GetSize(type));
+  m_column++;
+}
+
+void
+BinaryTraceWriter::AddDouble(double value)
+{
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  AddValue(BinaryTraceColumn::DOUBLE, bits);
+}
+
+void
+BinaryTraceWriter::AddInteger(int64_t value)
+{
+  AddValue(BinaryTraceColumn::INTEGER, static_cast<uint64_t>(value));
+}
+
+void
+BinaryTraceWriter::AddSymbol(const std::string& value)
+{
+  auto symbol = m_symbols.emplace(value, m_symbols.size());
+  if (symbol.second) {
+    EncodeString(m_newSymbols, value);
+    m_nNewSymbols++;
+  }
+  AddValue(BinaryTraceColumn::SYMBOL, symbol.first->second);
+}
+
+void
+BinaryTraceWriter::EndRow()
+{
+  NS_ASSERT_MSG(m_column == m_columns.size(), "Too few values in a row");
+  m_column = 0;
+  m_nRows++;
+
+  if (m_nRows >= m_blockSize) {
+    Flush();
+  }
+}
+
+void
+BinaryTraceWriter::Flush()
+{
+  NS_ASSERT_MSG(m_column == 0, "Cannot flush an incomplete row");
+
+  if (m_nNewSymbols > 0) {
+    std::string record(1, SYMBOLS_RECORD);
+    Encode(record, m_symbols.size() - m_nNewSymbols, 4);
+    Encode(record, m_nNewSymbols, 4);
+    m_os->write(record.data(), record.size());
+    m_os->write(m_newSymbols.data(), m_newSymbols.size());
+
+    m_newSymbols.clear();
+    m_nNewSymbols = 0;
+  }
+
+  if (m_nRows > 0) {
+    std::string record(1, ROWS_RECORD);
+    Encode(record, m_nRows, 4);
+    m_os->write(record.data(), record.size());
+    for (auto& values : m_values) {
+      m_os->write(values.data(), values.size());
+      values.clear();
+    }
+
+    m_nRows = 0;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+static void
+Read(std::istream& is, std::string& buffer, size_t size)
+{
+  buffer.resize(size);
+  is.read(&buffer[0], size);
+  if (static_cast<size_t>(is.gcount()) != size) {
+    throw BinaryTraceReader::Error("Binary trace is truncated");
+  }
+}
+
+static uint64_t
+Decode(const char* data, size_t size)
+{
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; i++) {
+    value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+  }
+  return value;
+}
+
+static uint64_t
+ReadNumber(std::istream& is, size_t size)
+{
+  std::string buffer;
+  Read(is, buffer, size);
+  return Decode(buffer.data(), size);
+}
+
+static std::string
+ReadString(std::istream& is)
+{
+  std::string value;
+  Read(is, value, ReadNumber(is, 4));
+  return value;
+}
+
+BinaryTraceReader::BinaryTraceReader(std::istream& is)
+  : m_is(is)
+  , m_nRows(0)
+{
+  std::string magic;
+  Read(m_is, magic, sizeof(MAGIC));
+  if (magic != std::string(MAGIC, sizeof(MAGIC))) {
+    throw Error("Not a binary trace");
+  }
+
+  uint32_t version = ReadNumber(m_is, 4);
+  if (version != VERSION) {
+    throw Error("Unsupported version " + std::to_string(version) + " of binary trace");
+  }
+
+  uint32_t nColumns = ReadNumber(m_is, 4);
+  for (uint32_t i = 0; i < nColumns; i++) {
+    BinaryTraceColumn column;
+    column.type = static_cast<BinaryTraceColumn::Type>(ReadNumber(m_is, 1));
+    if (column.type > BinaryTraceColumn::SYMBOL) {
+      throw Error("Unknown type of column " + std::to_string(i));
+    }
+    column.name = ReadString(m_is);
+    m_columns.push_back(column);
+  }
+  m_values.resize(m_columns.size());
+}
+
+bool
+BinaryTraceReader::ReadBlock()
+{
+  while (true) {
+    char type;
+    if (!m_is.get(type)) {
+      m_nRows = 0;
+      return false;
+    }
+
+    if (type == SYMBOLS_RECORD) {
+      uint32_t firstId = ReadNumber(m_is, 4);
+      uint32_t nSymbols = ReadNumber(m_is, 4);
+      if (firstId != m_symbols.size()) {
+        throw Error("Binary trace is corrupted (unexpected symbol id)");
+      }
+      for (uint32_t i = 0; i < nSymbols; i++) {
+        m_symbols.push_back(ReadString(m_is));
+      }
+    }
+    else if (type == ROWS_RECORD) {
+      m_nRows = ReadNumber(m_is, 4);
+
+      std::string buffer;
+      for (size_t i = 0; i < m_columns.size(); i++) {
+        size_t size = GetSize(m_columns[i].type);
+        Read(m_is, buffer, m_nRows * size);
+
+        m_values[i].resize(m_nRows);
+        for (size_t row = 0; row < m_nRows; row++) {
+          m_values[i][row] = Decode(buffer.data() + row * size, size);
+          if (m_columns[i].type == BinaryTraceColumn::SYMBOL
+              && m_values[i][row] >= m_symbols.size()) {
+            throw Error("Binary trace is corrupted (undefined symbol)");
+          }
+        }
+      }
+      return true;
+    }
+    else {
+      throw Error("Binary trace is corrupted (unknown record)");
+    }
+  }
+}
+
+uint64_t
+BinaryTraceReader::GetValue(size_t column, size_t row, BinaryTraceColumn::Type type) const
+{
+  NS_ASSERT_MSG(column < m_columns.size() && row < m_nRows, "Value is out of range");
+  NS_ASSERT_MSG(m_columns[column].type == type, "Column " << m_columns[column].name
+                                                   << " has a different type");
+  return m_values[column][row];
+}
+
+double
+BinaryTraceReader::GetDouble(size_t column, size_t row) const
+{
+  uint64_t bits = GetValue(column, row, BinaryTraceColumn::DOUBLE);
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+int64_t
+BinaryTraceReader::GetInteger(size_t column, size_t row) const
+{
+  return static_cast<int64_t>(GetValue(column, row, BinaryTraceColumn::INTEGER));
+}
+
+const std::string&
+BinaryTraceReader::GetSymbol(size_t column, size_t row) const
+{
+  return m_symbols[GetValue(column, row, BinaryTraceColumn::SYMBOL)];
+}
+
+void
+BinaryTraceReader::PrintHeader(std::ostream& os) const
+{
+  for (size_t i = 0; i < m_columns.size(); i++) {
+    if (i > 0) {
+      os << "\t";
+    }
+    os << m_columns[i].name;
+  }
+}
+
+void
+BinaryTraceReader::PrintRow(std::ostream& os, size_t row) const
+{
+  for (size_t i = 0; i < m_columns.size(); i++) {
+    if (i > 0) {
+      os << "\t";
+    }
+    switch (m_columns[i].type) {
+    case BinaryTraceColumn::DOUBLE:
+      os << GetDouble(i, row);
+      break;
+    case BinaryTraceColumn::INTEGER:
+      os << GetInteger(i, row);
+      break;
+    case BinaryTraceColumn::SYMBOL:
+      os << GetSymbol(i, row);
+      break;
+    }
+  }
+}
+
+void
+BinaryTraceReader::ConvertToTsv(std::istream& is, std::ostream& os)
+{
+  BinaryTraceReader reader(is);
+
+  reader.PrintHeader(os);
+  os << "\n";
+  while (reader.ReadBlock()) {
+    for (size_t row = 0; row < reader.GetNRows(); row++) {
+      reader.PrintRow(os, row);
+      os << "\n";
+    }
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,223 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_BINARY_TRACE_H
+#define NDN_BINARY_TRACE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <iosfwd>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Column of a binary trace
+ *
+ * A binary trace file starts with the magic string "NDNTRACE", the format version, and the
+ * schema (type and name of each column).  It continues with a sequence of records:
+ *
+ * - symbol records ('S'), which assign consecutive ids to new strings (node names, face
+ *   descriptions, counter types, prefixes);
+ * - row blocks ('R'), which store the values of up to a block of rows column by column: doubles
+ *   and integers take 8 bytes, symbols are the 4-byte ids of previously defined strings.
+ *
+ * All numbers are little-endian; lengths and counts are 32-bit.
+ */
+struct BinaryTraceColumn {
+  enum Type : uint8_t {
+    DOUBLE = 0,
+    INTEGER = 1,
+    SYMBOL = 2,
+  };
+
+  Type type;
+  std::string name;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Writer of binary columnar traces
+ *
+ * Values of a row are added in the order of the schema, and a complete row is ended with
+ * EndRow.  Rows are buffered and written as one block once the block is full or when the
+ * writer is destroyed.
+ */
+class BinaryTraceWriter : boost::noncopyable {
+public:
+  /**
+   * @param os        output stream, which is kept until the writer is destroyed
+   * @param columns   schema of the trace
+   * @param blockSize number of rows in a block
+   */
+  BinaryTraceWriter(shared_ptr<std::ostream> os, const std::vector<BinaryTraceColumn>& columns,
+                    size_t blockSize = 4096);
+
+  /**
+   * @brief Write buffered rows and flush the output stream
+   */
+  ~BinaryTraceWriter();
+
+  void
+  AddDouble(double value);
+
+  void
+  AddInteger(int64_t value);
+
+  /**
+   * @brief Add a string value, which is written once in the trace and then referenced by its id
+   */
+  void
+  AddSymbol(const std::string& value);
+
+  void
+  EndRow();
+
+  /**
+   * @brief Write buffered symbols and rows as a block
+   */
+  void
+  Flush();
+
+private:
+  void
+  AddValue(BinaryTraceColumn::Type type, uint64_t value);
+
+private:
+  shared_ptr<std::ostream> m_os;
+  std::vector<BinaryTraceColumn> m_columns;
+  size_t m_blockSize;
+
+  std::unordered_map<std::string, uint32_t> m_symbols;
+  std::string m_newSymbols; ///< @brief encoded symbols defined since the last block
+  uint32_t m_nNewSymbols;
+
+  std::vector<std::string> m_values; ///< @brief encoded values of buffered rows for each column
+  size_t m_nRows;
+  size_t m_column; ///< @brief next column of the current row
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Reader of binary columnar traces written by BinaryTraceWriter
+ *
+ * @code
+ * std::ifstream is("rate-trace.bin");
+ * BinaryTraceReader reader(is);
+ * while (reader.ReadBlock()) {
+ *   for (size_t row = 0; row < reader.GetNRows(); row++) {
+ *     double time = reader.GetDouble(0, row);
+ *     const std::string& node = reader.GetSymbol(1, row);
+ *     ...
+ *   }
+ * }
+ * @endcode
+ */
+class BinaryTraceReader : boost::noncopyable {
+public:
+  class Error : public std::runtime_error {
+  public:
+    explicit Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /**
+   * @brief Read the schema of the trace from @p is
+   * @throw Error the stream does not contain a binary trace
+   */
+  explicit BinaryTraceReader(std::istream& is);
+
+  const std::vector<BinaryTraceColumn>&
+  GetColumns() const
+  {
+    return m_columns;
+  }
+
+  /**
+   * @brief Read the next block of rows
+   * @return false at the end of the trace
+   * @throw Error the trace is truncated or corrupted
+   */
+  bool
+  ReadBlock();
+
+  /**
+   * @brief Get number of rows in the current block
+   */
+  size_t
+  GetNRows() const
+  {
+    return m_nRows;
+  }
+
+  double
+  GetDouble(size_t column, size_t row) const;
+
+  int64_t
+  GetInteger(size_t column, size_t row) const;
+
+  const std::string&
+  GetSymbol(size_t column, size_t row) const;
+
+  /**
+   * @brief Print tab-separated column names
+   */
+  void
+  PrintHeader(std::ostream& os) const;
+
+  /**
+   * @brief Print tab-separated values of a row of the current block
+   *
+   * Values are formatted in the same way as text traces.
+   */
+  void
+  PrintRow(std::ostream& os, size_t row) const;
+
+  /**
+   * @brief Convert binary trace @p is to the tab-separated text format
+   */
+  static void
+  ConvertToTsv(std::istream& is, std::ostream& os);
+
+private:
+  uint64_t
+  GetValue(size_t column, size_t row, BinaryTraceColumn::Type type) const;
+
+private:
+  std::istream& m_is;
+  std::vector<BinaryTraceColumn> m_columns;
+  std::vector<std::string> m_symbols;
+
+  std::vector<std::vector<uint64_t>> m_values;
+  size_t m_nRows;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_BINARY_TRACE_H
@@ -18,6 +18,8 @@
  **/
 
 #include "ndn-cs-tracer.hpp"
+#include "ndn-binary-trace.hpp"
+#include "ndn-tracer-registry.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -25,136 +27,85 @@
 #include "ns3/callback.h"
 
 #include "apps/ndn-app.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/log.h"
 
+#include <boost/functional/hash.hpp>
 #include <boost/lexical_cast.hpp>
 
-#include <fstream>
+#include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE("ndn.CsTracer");
 
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<CsTracer>>>> g_tracers;
+static size_t g_prefixDepth = 1;
+
+static bool g_isBinaryOutput = false;
 
 void
 CsTracer::Destroy()
 {
-  g_tracers.clear();
+  TracerRegistry::Remove<CsTracer>();
 }
 
 void
-CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+CsTracer::SetPrefixDepth(size_t depth)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
+  g_prefixDepth = depth;
+}
 
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
+void
+CsTracer::SetBinaryOutput(bool isEnabled)
+{
+  g_isBinaryOutput = isEnabled;
+}
 
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
-    tracers.push_back(trace);
+void
+CsTracer::AttachOutput(const std::list<Ptr<CsTracer>>& tracers, shared_ptr<std::ostream> os)
+{
+  if (g_isBinaryOutput) {
+    auto writer = make_shared<BinaryTraceWriter>(os, std::vector<BinaryTraceColumn>{
+        {BinaryTraceColumn::DOUBLE, "Time"},
+        {BinaryTraceColumn::SYMBOL, "Node"},
+        {BinaryTraceColumn::SYMBOL, "Prefix"},
+        {BinaryTraceColumn::SYMBOL, "Type"},
+        {BinaryTraceColumn::INTEGER, "Packets"},
+      });
+    for (const auto& trace : tracers) {
+      trace->m_writer = writer;
+    }
   }
-
-  if (tracers.size() > 0) {
+  else if (tracers.size() > 0) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    tracers.front()->PrintHeader(*os);
+    *os << "\n";
   }
+}
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+void
+CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  TracerRegistry::Install<CsTracer>(NodeList::Begin(), NodeList::End(), file, averagingPeriod);
 }
 
 void
 CsTracer::Install(const NodeContainer& nodes, const std::string& file,
                   Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
-
-  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
-    tracers.push_back(trace);
-  }
-
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  TracerRegistry::Install<CsTracer>(nodes.Begin(), nodes.End(), file, averagingPeriod);
 }
 
 void
 CsTracer::Install(Ptr<Node> node, const std::string& file,
                   Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
-
-  Ptr<CsTracer> trace = Install(node, outputStream, averagingPeriod);
-  tracers.push_back(trace);
-
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  NodeContainer nodes(node);
+  TracerRegistry::Install<CsTracer>(nodes.Begin(), nodes.End(), file, averagingPeriod);
 }
 
 Ptr<CsTracer>
@@ -164,7 +115,7 @@ CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
   NS_LOG_DEBUG("Node: " << node->GetId());
 
   Ptr<CsTracer> trace = Create<CsTracer>(outputStream, node);
-  trace->SetAveragingPeriod(averagingPeriod);
+  TracerRegistry::Add(trace, node->GetId(), outputStream, averagingPeriod);
 
   return trace;
 }
@@ -176,6 +127,9 @@ CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
 CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_prefixDepth(g_prefixDepth)
+  , m_lastHits(0)
+  , m_lastMisses(0)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -189,7 +143,11 @@ CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 
 CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
+  , m_nodePtr(Names::Find<Node>(node))
   , m_os(os)
+  , m_prefixDepth(g_prefixDepth)
+  , m_lastHits(0)
+  , m_lastMisses(0)
 {
   Connect();
 }
@@ -199,10 +157,28 @@ CsTracer::~CsTracer(){};
 void
 CsTracer::Connect()
 {
-  // // @TODO Do the same with NFD content store...
-  // Ptr<ContentStore> cs = m_nodePtr->GetObject<ContentStore>();
-  // cs->TraceConnectWithoutContext("CacheHits", MakeCallback(&CsTracer::CacheHits, this));
-  // cs->TraceConnectWithoutContext("CacheMisses", MakeCallback(&CsTracer::CacheMisses, this));
+  Ptr<L3Protocol> l3 = m_nodePtr->GetObject<L3Protocol>();
+
+  l3->TraceConnectWithoutContext("CsHits", MakeCallback(&CsTracer::CacheHits, this));
+  l3->TraceConnectWithoutContext("CsInserts", MakeCallback(&CsTracer::CacheInserts, this));
+  l3->TraceConnectWithoutContext("CsEvictions", MakeCallback(&CsTracer::CacheEvictions, this));
+
+  // node-wide hits and misses are taken from NFD forwarder counters, which are maintained anyway
+  const nfd::ForwarderCounters& counters = l3->getForwarder()->getCounters();
+  m_lastHits = counters.nCsHits;
+  m_lastMisses = counters.nCsMisses;
+
+  // occupancy includes the Data cached before the tracer was installed, which can be evicted later
+  for (const auto& entry : l3->getForwarder()->getCs()) {
+    const Data& data = entry.getData();
+    size_t size = data.wireEncode().size();
+    m_stats.m_bytes += size;
+
+    cs::Stats* stats = GetPrefixStats(data);
+    if (stats != nullptr) {
+      stats->m_bytes += size;
+    }
+  }
 
   Reset();
 }
@@ -211,17 +187,19 @@ void
 CsTracer::SetAveragingPeriod(const Time& period)
 {
   m_period = period;
-  m_printEvent.Cancel();
-  m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
 }
 
 void
 CsTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  UpdateForwarderCounters();
+  if (m_writer != nullptr) {
+    Write(*m_writer);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
-
-  m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
 }
 
 void
@@ -233,6 +211,9 @@ CsTracer::PrintHeader(std::ostream& os) const
      << "Node"
      << "\t"
 
+     << "Prefix"
+     << "\t"
+
      << "Type"
      << "\t"
      << "Packets"
@@ -243,31 +224,132 @@ void
 CsTracer::Reset()
 {
   m_stats.Reset();
+  for (auto& stats : m_prefixStats) {
+    stats.second.Reset();
+  }
 }
 
-#define PRINTER(printName, fieldName)                                                              \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << printName << "\t" << m_stats.fieldName \
-     << "\n";
+#define PRINTER(prefix, printName, stats, fieldName)                                               \
+  if (writer != nullptr) {                                                                         \
+    writer->AddDouble(time.ToDouble(Time::S));                                                     \
+    writer->AddSymbol(m_node);                                                                     \
+    writer->AddSymbol(prefix);                                                                     \
+    writer->AddSymbol(printName);                                                                  \
+    writer->AddInteger(static_cast<int64_t>(stats.fieldName));                                     \
+    writer->EndRow();                                                                              \
+  }                                                                                                \
+  else {                                                                                           \
+    *os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << prefix << "\t" << printName         \
+        << "\t" << stats.fieldName << "\n";                                                        \
+  }
 
 void
 CsTracer::Print(std::ostream& os) const
+{
+  Output(&os, nullptr);
+}
+
+void
+CsTracer::Write(BinaryTraceWriter& writer) const
+{
+  Output(nullptr, &writer);
+}
+
+void
+CsTracer::Output(std::ostream* os, BinaryTraceWriter* writer) const
 {
   Time time = Simulator::Now();
+  const std::string all = "all";
+
+  PRINTER(all, "CacheHits", m_stats, m_cacheHits);
+  PRINTER(all, "CacheMisses", m_stats, m_cacheMisses);
+  PRINTER(all, "CacheInserts", m_stats, m_cacheInserts);
+  PRINTER(all, "CacheEvictions", m_stats, m_cacheEvictions);
+  PRINTER(all, "CacheBytes", m_stats, m_bytes);
+
+  for (const auto& stats : m_prefixStats) {
+    std::string prefix = stats.first.toUri();
+    PRINTER(prefix, "CacheHits", stats.second, m_cacheHits);
+    PRINTER(prefix, "CacheInserts", stats.second, m_cacheInserts);
+    PRINTER(prefix, "CacheEvictions", stats.second, m_cacheEvictions);
+    PRINTER(prefix, "CacheBytes", stats.second, m_bytes);
+  }
+}
 
-  PRINTER("CacheHits", m_cacheHits);
-  PRINTER("CacheMisses", m_cacheMisses);
+void
+CsTracer::UpdateForwarderCounters()
+{
+  const nfd::ForwarderCounters& counters =
+    m_nodePtr->GetObject<L3Protocol>()->getForwarder()->getCounters();
+
+  m_stats.m_cacheHits += counters.nCsHits - m_lastHits;
+  m_stats.m_cacheMisses += counters.nCsMisses - m_lastMisses;
+  m_lastHits = counters.nCsHits;
+  m_lastMisses = counters.nCsMisses;
+}
+
+cs::Stats*
+CsTracer::GetPrefixStats(const Data& data)
+{
+  if (m_prefixDepth == 0) {
+    return nullptr;
+  }
+
+  const Name& name = data.getName();
+  size_t depth = std::min(name.size(), m_prefixDepth);
+  size_t hash = 0;
+  for (size_t i = 0; i < depth; i++) {
+    boost::hash_combine(hash, boost::hash_range(name[i].begin(), name[i].end()));
+  }
+
+  auto candidates = m_prefixIndex.equal_range(hash);
+  for (auto candidate = candidates.first; candidate != candidates.second; ++candidate) {
+    if (name.compare(0, depth, candidate->second->first) == 0) {
+      return &candidate->second->second;
+    }
+  }
+
+  auto stats = m_prefixStats.emplace(name.getPrefix(depth), cs::Stats()).first;
+  m_prefixIndex.emplace(hash, stats);
+  return &stats->second;
 }
 
 void
-CsTracer::CacheHits(shared_ptr<const Interest>, shared_ptr<const Data>)
+CsTracer::CacheHits(const Data& data)
 {
-  m_stats.m_cacheHits++;
+  // node-wide hits are updated from forwarder counters
+  cs::Stats* stats = GetPrefixStats(data);
+  if (stats != nullptr) {
+    stats->m_cacheHits++;
+  }
 }
 
 void
-CsTracer::CacheMisses(shared_ptr<const Interest>)
+CsTracer::CacheInserts(const Data& data)
 {
-  m_stats.m_cacheMisses++;
+  size_t size = data.wireEncode().size();
+  m_stats.m_cacheInserts++;
+  m_stats.m_bytes += size;
+
+  cs::Stats* stats = GetPrefixStats(data);
+  if (stats != nullptr) {
+    stats->m_cacheInserts++;
+    stats->m_bytes += size;
+  }
+}
+
+void
+CsTracer::CacheEvictions(const Data& data)
+{
+  size_t size = data.wireEncode().size();
+  m_stats.m_cacheEvictions++;
+  m_stats.m_bytes -= std::min<uint64_t>(size, m_stats.m_bytes);
+
+  cs::Stats* stats = GetPrefixStats(data);
+  if (stats != nullptr) {
+    stats->m_cacheEvictions++;
+    stats->m_bytes -= std::min<uint64_t>(size, stats->m_bytes);
+  }
 }
 
 } // namespace ndn
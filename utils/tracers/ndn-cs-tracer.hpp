@@ -25,12 +25,12 @@
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include <ns3/nstime.h>
-#include <ns3/event-id.h>
 #include <ns3/node-container.h>
 
 #include <tuple>
 #include <map>
 #include <list>
+#include <unordered_map>
 
 namespace ns3 {
 
@@ -39,25 +39,42 @@ class Packet;
 
 namespace ndn {
 
+class BinaryTraceWriter;
+class TracerRegistry;
+
 namespace cs {
 
 /// @cond include_hidden
 struct Stats {
+  Stats()
+    : m_bytes(0)
+  {
+    Reset();
+  }
+
   inline void
   Reset()
   {
     m_cacheHits = 0;
     m_cacheMisses = 0;
+    m_cacheInserts = 0;
+    m_cacheEvictions = 0;
   }
   double m_cacheHits;
   double m_cacheMisses;
+  double m_cacheInserts;
+  double m_cacheEvictions;
+  uint64_t m_bytes; // occupancy, not reset between periods
 };
 /// @endcond
 }
 
 /**
  * @ingroup ndn-tracers
- * @brief NDN tracer for cache performance (hits and misses)
+ * @brief NDN tracer for cache performance (hits, misses, insertions, evictions, and occupancy)
+ *
+ * Node-wide counters are always reported.  Hits, insertions, evictions, and occupancy in bytes
+ * are additionally broken down by name prefix of the cached Data (see SetPrefixDepth).
  */
 class CsTracer : public SimpleRefCount<CsTracer> {
 public:
@@ -133,6 +150,25 @@ public:
   static void
   Destroy();
 
+  /**
+   * @brief Set number of name components used to aggregate per-prefix statistics
+   *
+   * Affects tracers installed after the call.  Zero disables per-prefix statistics, leaving
+   * only node-wide counters.  Default is 1.
+   */
+  static void
+  SetPrefixDepth(size_t depth);
+
+  /**
+   * @brief Write traces in the binary columnar format of BinaryTraceWriter instead of
+   *        tab-separated text (default false)
+   *
+   * Affects tracers installed with a file name after the call.  BinaryTraceReader::ConvertToTsv
+   * converts binary traces back to the text format; counters are written as integers.
+   */
+  static void
+  SetBinaryOutput(bool isEnabled);
+
   /**
    * @brief Trace constructor that attaches to the node using node pointer
    * @param os    reference to the output stream
@@ -168,15 +204,36 @@ public:
   void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write current trace data to a binary trace
+   */
+  void
+  Write(BinaryTraceWriter& writer) const;
+
 private:
+  static void
+  AttachOutput(const std::list<Ptr<CsTracer>>& tracers, shared_ptr<std::ostream> os);
+
+  void
+  Output(std::ostream* os, BinaryTraceWriter* writer) const;
+
   void
   Connect();
 
   void
-  CacheHits(shared_ptr<const Interest>, shared_ptr<const Data>);
+  CacheHits(const Data& data);
 
   void
-  CacheMisses(shared_ptr<const Interest>);
+  CacheInserts(const Data& data);
+
+  void
+  CacheEvictions(const Data& data);
+
+  cs::Stats*
+  GetPrefixStats(const Data& data);
+
+  void
+  UpdateForwarderCounters();
 
 private:
   void
@@ -193,10 +250,19 @@ private:
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  shared_ptr<BinaryTraceWriter> m_writer; // set instead of printing to m_os in binary mode
 
   Time m_period;
-  EventId m_printEvent;
   cs::Stats m_stats;
+  std::map<Name, cs::Stats> m_prefixStats;
+  /// hash of a prefix -> stats of the prefixes with this hash, so that no prefix is built per event
+  std::unordered_multimap<size_t, std::map<Name, cs::Stats>::iterator> m_prefixIndex;
+  size_t m_prefixDepth;
+
+  uint64_t m_lastHits;
+  uint64_t m_lastMisses;
+
+  friend class TracerRegistry;
 };
 
 /**
@@ -18,6 +18,8 @@
  **/
 
 #include "ndn-l3-rate-tracer.hpp"
+#include "ndn-binary-trace.hpp"
+#include "ndn-tracer-registry.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -27,9 +29,9 @@
 #include "ns3/node-list.h"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 
+#include "daemon/fw/face-table.hpp"
 #include "daemon/table/pit-entry.hpp"
 
-#include <fstream>
 #include <boost/lexical_cast.hpp>
 
 NS_LOG_COMPONENT_DEFINE("ndn.L3RateTracer");
@@ -37,121 +39,67 @@ NS_LOG_COMPONENT_DEFINE("ndn.L3RateTracer");
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<L3RateTracer>>>>
-  g_tracers;
+static bool g_isBinaryOutput = false;
 
 void
 L3RateTracer::Destroy()
 {
-  g_tracers.clear();
+  TracerRegistry::Remove<L3RateTracer>();
 }
 
 void
-L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+L3RateTracer::SetBinaryOutput(bool isEnabled)
 {
-  std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
+  g_isBinaryOutput = isEnabled;
+}
 
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
-    tracers.push_back(trace);
+void
+L3RateTracer::AttachOutput(const std::list<Ptr<L3RateTracer>>& tracers,
+                           shared_ptr<std::ostream> os)
+{
+  if (g_isBinaryOutput) {
+    auto writer = make_shared<BinaryTraceWriter>(os, std::vector<BinaryTraceColumn>{
+        {BinaryTraceColumn::DOUBLE, "Time"},
+        {BinaryTraceColumn::SYMBOL, "Node"},
+        {BinaryTraceColumn::INTEGER, "FaceId"},
+        {BinaryTraceColumn::SYMBOL, "FaceDescr"},
+        {BinaryTraceColumn::SYMBOL, "Type"},
+        {BinaryTraceColumn::DOUBLE, "Packets"},
+        {BinaryTraceColumn::DOUBLE, "Kilobytes"},
+        {BinaryTraceColumn::DOUBLE, "PacketRaw"},
+        {BinaryTraceColumn::DOUBLE, "KilobytesRaw"},
+      });
+    for (const auto& trace : tracers) {
+      trace->m_writer = writer;
+    }
   }
-
-  if (tracers.size() > 0) {
+  else if (tracers.size() > 0) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    tracers.front()->PrintHeader(*os);
+    *os << "\n";
   }
+}
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+void
+L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  TracerRegistry::Install<L3RateTracer>(NodeList::Begin(), NodeList::End(), file,
+                                        averagingPeriod);
 }
 
 void
 L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
                       Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
-
-  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
-    tracers.push_back(trace);
-  }
-
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  TracerRegistry::Install<L3RateTracer>(nodes.Begin(), nodes.End(), file, averagingPeriod);
 }
 
 void
 L3RateTracer::Install(Ptr<Node> node, const std::string& file,
                       Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
-
-  Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod);
-  tracers.push_back(trace);
-
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  NodeContainer nodes(node);
+  TracerRegistry::Install<L3RateTracer>(nodes.Begin(), nodes.End(), file, averagingPeriod);
 }
 
 Ptr<L3RateTracer>
@@ -161,7 +109,7 @@ L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
   NS_LOG_DEBUG("Node: " << node->GetId());
 
   Ptr<L3RateTracer> trace = Create<L3RateTracer>(outputStream, node);
-  trace->SetAveragingPeriod(averagingPeriod);
+  TracerRegistry::Add(trace, node->GetId(), outputStream, averagingPeriod);
 
   return trace;
 }
@@ -169,37 +117,54 @@ L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : L3Tracer(node)
   , m_os(os)
+  , m_period(Seconds(1.0))
+  , m_faces(1)
+  , m_slots(1, 0)
 {
-  SetAveragingPeriod(Seconds(1.0));
+  m_faces[0].faceDescr = "all";
+  m_faces[0].isTraced = false;
+
+  // counters of each face are allocated when the face is added, so tracing only indexes arrays
+  nfd::FaceTable& faceTable = m_nodePtr->GetObject<L3Protocol>()->getFaceTable();
+  for (const Face& face : faceTable) {
+    AddFace(face);
+  }
+  m_afterAddFaceConnection = faceTable.afterAdd.connect([this] (const Face& face) {
+      AddFace(face);
+    });
 }
 
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
   : L3Tracer(node)
   , m_os(os)
+  , m_period(Seconds(1.0))
+  , m_faces(1)
+  , m_slots(1, 0)
 {
-  SetAveragingPeriod(Seconds(1.0));
+  m_faces[0].faceDescr = "all";
+  m_faces[0].isTraced = false;
 }
 
 L3RateTracer::~L3RateTracer()
 {
-  m_printEvent.Cancel();
 }
 
 void
 L3RateTracer::SetAveragingPeriod(const Time& period)
 {
   m_period = period;
-  m_printEvent.Cancel();
-  m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
 }
 
 void
 L3RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_writer != nullptr) {
+    Write(*m_writer);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
-
-  m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
 }
 
 void
@@ -229,44 +194,49 @@ L3RateTracer::PrintHeader(std::ostream& os) const
 void
 L3RateTracer::Reset()
 {
-  for (auto& stats : m_stats) {
-    std::get<0>(stats.second).Reset();
-    std::get<1>(stats.second).Reset();
+  for (auto& stats : m_faces) {
+    stats.packets.Reset();
+    stats.bytes.Reset();
   }
 }
 
 const double alpha = 0.8;
 
-#define STATS(INDEX) std::get<INDEX>(stats.second)
-#define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
+#define RATE(STATS, fieldName) stats.STATS.fieldName / m_period.ToDouble(Time::S)
 
 #define PRINTER(printName, fieldName)                                                              \
-  STATS(2).fieldName =                                                                             \
-    /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;     \
-  STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
-                       + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
+  stats.packetRate.fieldName =                                                                     \
+    /*new value*/ alpha * RATE(packets, fieldName)                                                 \
+    + /*old value*/ (1 - alpha) * stats.packetRate.fieldName;                                      \
+  stats.kilobyteRate.fieldName = /*new value*/ alpha * RATE(bytes, fieldName) / 1024.0             \
+                                 + /*old value*/ (1 - alpha) * stats.kilobyteRate.fieldName;       \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
-  if (stats.first != nfd::face::INVALID_FACEID) {                                                  \
-    os << stats.first << "\t";                                                                     \
-    NS_ASSERT(m_faceInfos.find(stats.first) != m_faceInfos.end());                                 \
-    os << m_faceInfos.find(stats.first)->second << "\t";                                           \
-  }                                                                                                \
-  else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
-  }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+  OutputRow(os, writer, time, faceId, stats.faceDescr, printName, stats.packetRate.fieldName,      \
+            stats.kilobyteRate.fieldName, stats.packets.fieldName, stats.bytes.fieldName / 1024.0);
 
 void
 L3RateTracer::Print(std::ostream& os) const
+{
+  Output(&os, nullptr);
+}
+
+void
+L3RateTracer::Write(BinaryTraceWriter& writer) const
+{
+  Output(nullptr, &writer);
+}
+
+void
+L3RateTracer::Output(std::ostream* os, BinaryTraceWriter* writer) const
 {
   Time time = Simulator::Now();
 
-  for (auto& stats : m_stats) {
-    if (stats.first == nfd::face::INVALID_FACEID)
+  // in the order of FaceIds
+  for (nfd::FaceId faceId = 1; faceId < m_slots.size(); faceId++) {
+    if (m_slots[faceId] == 0 || !m_faces[m_slots[faceId]].isTraced)
       continue;
 
+    const FaceStats& stats = m_faces[m_slots[faceId]];
     PRINTER("InInterests", m_inInterests);
     PRINTER("OutInterests", m_outInterests);
 
@@ -283,122 +253,146 @@ L3RateTracer::Print(std::ostream& os) const
     PRINTER("OutTimedOutInterests", m_outTimedOutInterests);
   }
 
-  {
-    auto i = m_stats.find(nfd::face::INVALID_FACEID);
-    if (i != m_stats.end()) {
-      auto& stats = *i;
-      PRINTER("SatisfiedInterests", m_satisfiedInterests);
-      PRINTER("TimedOutInterests", m_timedOutInterests);
+  if (m_faces[0].isTraced) {
+    nfd::FaceId faceId = nfd::face::INVALID_FACEID;
+    const FaceStats& stats = m_faces[0];
+    PRINTER("SatisfiedInterests", m_satisfiedInterests);
+    PRINTER("TimedOutInterests", m_timedOutInterests);
+  }
+}
+
+void
+L3RateTracer::OutputRow(std::ostream* os, BinaryTraceWriter* writer, const Time& time,
+                        nfd::FaceId faceId, const std::string& faceDescr, const char* type,
+                        double packets, double kilobytes, double packetsRaw,
+                        double kilobytesRaw) const
+{
+  if (writer != nullptr) {
+    writer->AddDouble(time.ToDouble(Time::S));
+    writer->AddSymbol(m_node);
+    if (faceId != nfd::face::INVALID_FACEID) {
+      writer->AddInteger(faceId);
+    }
+    else {
+      writer->AddInteger(-1);
     }
+    writer->AddSymbol(faceDescr);
+    writer->AddSymbol(type);
+    writer->AddDouble(packets);
+    writer->AddDouble(kilobytes);
+    writer->AddDouble(packetsRaw);
+    writer->AddDouble(kilobytesRaw);
+    writer->EndRow();
+    return;
+  }
+
+  *os << time.ToDouble(Time::S) << "\t" << m_node << "\t";
+  if (faceId != nfd::face::INVALID_FACEID) {
+    *os << faceId << "\t";
+  }
+  else {
+    *os << "-1\t";
   }
+  *os << faceDescr << "\t";
+  *os << type << "\t" << packets << "\t" << kilobytes << "\t" << packetsRaw << "\t"
+      << kilobytesRaw << "\n";
 }
 
 void
 L3RateTracer::OutInterests(const Interest& interest, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outInterests++;
-  if (interest.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outInterests +=
-      interest.wireEncode().size();
-  }
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_outInterests++;
+  stats.bytes.m_outInterests += GetWireSize(interest);
 }
 
 void
 L3RateTracer::InInterests(const Interest& interest, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inInterests++;
-  if (interest.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inInterests +=
-      interest.wireEncode().size();
-  }
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_inInterests++;
+  stats.bytes.m_inInterests += GetWireSize(interest);
 }
 
 void
 L3RateTracer::OutData(const Data& data, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outData++;
-  if (data.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outData +=
-      data.wireEncode().size();
-  }
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_outData++;
+  stats.bytes.m_outData += GetWireSize(data);
 }
 
 void
 L3RateTracer::InData(const Data& data, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inData++;
-  if (data.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inData +=
-      data.wireEncode().size();
-  }
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_inData++;
+  stats.bytes.m_inData += GetWireSize(data);
 }
 
 void
 L3RateTracer::OutNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outNack++;
-  if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outNack +=
-      nack.getInterest().wireEncode().size();
-  }
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_outNack++;
+  stats.bytes.m_outNack += GetWireSize(nack.getInterest());
 }
 
 void
 L3RateTracer::InNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inNack++;
-  if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inNack +=
-      nack.getInterest().wireEncode().size();
-  }
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_inNack++;
+  stats.bytes.m_inNack += GetWireSize(nack.getInterest());
 }
 
 void
 L3RateTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
 {
-  std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_satisfiedInterests++;
+  m_faces[0].isTraced = true;
+  m_faces[0].packets.m_satisfiedInterests++;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    AddInfo(in.getFace());
-    std::get<0>(m_stats[(in.getFace()).getId()]).m_satisfiedInterests ++;
+    GetStats(in.getFace()).packets.m_satisfiedInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    AddInfo(out.getFace());
-    std::get<0>(m_stats[(out.getFace()).getId()]).m_outSatisfiedInterests ++;
+    GetStats(out.getFace()).packets.m_outSatisfiedInterests++;
   }
 }
 
 void
 L3RateTracer::TimedOutInterests(const nfd::pit::Entry& entry)
 {
-  std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_timedOutInterests++;
+  m_faces[0].isTraced = true;
+  m_faces[0].packets.m_timedOutInterests++;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    AddInfo(in.getFace());
-    std::get<0>(m_stats[(in.getFace()).getId()]).m_timedOutInterests++;
+    GetStats(in.getFace()).packets.m_timedOutInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    AddInfo(out.getFace());
-    std::get<0>(m_stats[(out.getFace()).getId()]).m_outTimedOutInterests++;
+    GetStats(out.getFace()).packets.m_outTimedOutInterests++;
   }
 }
 
 void
-L3RateTracer::AddInfo(const Face& face)
+L3RateTracer::AddFace(const Face& face)
 {
-  if (m_faceInfos.find(face.getId()) == m_faceInfos.end()) {
-    m_faceInfos.insert(make_pair(face.getId(), boost::lexical_cast<std::string>(face.getLocalUri())));
+  nfd::FaceId faceId = face.getId();
+  if (faceId >= m_slots.size()) {
+    m_slots.resize(faceId + 1, 0);
   }
+  if (m_slots[faceId] != 0) {
+    return;
+  }
+
+  m_slots[faceId] = m_faces.size();
+  m_faces.emplace_back();
+  FaceStats& stats = m_faces.back();
+  stats.faceDescr = boost::lexical_cast<std::string>(face.getLocalUri()); // counters are zero
 }
 
 } // namespace ndn
@@ -25,16 +25,17 @@
 #include "ndn-l3-tracer.hpp"
 
 #include "ns3/nstime.h"
-#include "ns3/event-id.h"
 #include "ns3/node-container.h"
 
-#include <tuple>
-#include <map>
 #include <list>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
 
+class BinaryTraceWriter;
+class TracerRegistry;
+
 /**
  * @ingroup ndn-tracers
  * @brief NDN network-layer rate tracer
@@ -83,6 +84,16 @@ public:
   static void
   Destroy();
 
+  /**
+   * @brief Write traces in the binary columnar format of BinaryTraceWriter instead of
+   *        tab-separated text (default false)
+   *
+   * Affects tracers installed with a file name after the call.  BinaryTraceReader::ConvertToTsv
+   * converts binary traces back to the text format.
+   */
+  static void
+  SetBinaryOutput(bool isEnabled);
+
   /**
    * @brief Trace constructor that attaches to the node using node pointer
    * @param os    reference to the output stream
@@ -125,6 +136,12 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write current trace data to a binary trace
+   */
+  void
+  Write(BinaryTraceWriter& writer) const;
+
 protected:
   // from L3Tracer
   virtual void
@@ -152,6 +169,17 @@ protected:
   TimedOutInterests(const nfd::pit::Entry&);
 
 private:
+  static void
+  AttachOutput(const std::list<Ptr<L3RateTracer>>& tracers, shared_ptr<std::ostream> os);
+
+  void
+  Output(std::ostream* os, BinaryTraceWriter* writer) const;
+
+  void
+  OutputRow(std::ostream* os, BinaryTraceWriter* writer, const Time& time, nfd::FaceId faceId,
+            const std::string& faceDescr, const char* type, double packets, double kilobytes,
+            double packetsRaw, double kilobytesRaw) const;
+
   void
   SetAveragingPeriod(const Time& period);
 
@@ -161,16 +189,51 @@ private:
   void
   Reset();
 
+  /**
+   * @brief Counters of a face, or of all faces for FaceId INVALID_FACEID
+   */
+  struct FaceStats {
+    std::string faceDescr; // needed, because face may no longer exists at the time of stat printing
+    bool isTraced;         ///< @brief only faces that appeared in traces are printed
+
+    Stats packets;
+    Stats bytes;
+    mutable Stats packetRate;
+    mutable Stats kilobyteRate;
+  };
+
   void
-  AddInfo(const Face& face);
+  AddFace(const Face& face);
+
+  FaceStats&
+  GetStats(const Face& face)
+  {
+    nfd::FaceId faceId = face.getId();
+    if (faceId >= m_slots.size() || m_slots[faceId] == 0) {
+      AddFace(face);
+    }
+    FaceStats& stats = m_faces[m_slots[faceId]];
+    stats.isTraced = true;
+    return stats;
+  }
+
+  template<class NdnPacket>
+  static size_t
+  GetWireSize(const NdnPacket& packet)
+  {
+    return packet.hasWire() ? packet.wireEncode().size() : 0;
+  }
 
 private:
   shared_ptr<std::ostream> m_os;
+  shared_ptr<BinaryTraceWriter> m_writer; // set instead of printing to m_os in binary mode
   Time m_period;
-  EventId m_printEvent;
 
-  mutable std::map<nfd::FaceId, std::tuple<Stats, Stats, Stats, Stats>> m_stats;
-  std::map<nfd::FaceId, std::string> m_faceInfos; // needed, because face may no longer exists at the time of stat printing
+  std::vector<FaceStats> m_faces; ///< @brief counters of all faces in one array, [0] for all faces
+  std::vector<uint32_t> m_slots;  ///< @brief index in m_faces for each FaceId, 0 if not added yet
+  ::ndn::util::signal::ScopedConnection m_afterAddFaceConnection;
+
+  friend class TracerRegistry;
 };
 
 } // namespace ndn
@@ -0,0 +1,281 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-latency-histogram.hpp"
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+namespace ns3 {
+namespace ndn {
+
+static const uint32_t MAX_SUB_BUCKET_BITS = 30;
+
+LatencyHistogram::LatencyHistogram(uint32_t subBucketBits)
+  : m_subBucketBits(subBucketBits)
+{
+  NS_ASSERT_MSG(subBucketBits <= MAX_SUB_BUCKET_BITS, "Too many sub-bucket bits");
+  Reset();
+}
+
+void
+LatencyHistogram::Record(int64_t value, uint64_t count)
+{
+  if (count == 0) {
+    return;
+  }
+  value = std::max<int64_t>(value, 0);
+
+  size_t index = GetIndex(value);
+  if (index >= m_counts.size()) {
+    m_counts.resize(index + 1, 0);
+  }
+  m_counts[index] += count;
+
+  m_count += count;
+  m_min = std::min(m_min, value);
+  m_max = std::max(m_max, value);
+  m_sum += static_cast<uint64_t>(value) * count;
+}
+
+void
+LatencyHistogram::Merge(const LatencyHistogram& other)
+{
+  NS_ASSERT_MSG(other.m_subBucketBits == m_subBucketBits,
+                "Only histograms with the same number of sub-bucket bits can be merged");
+  if (other.m_count == 0) {
+    return;
+  }
+
+  if (other.m_counts.size() > m_counts.size()) {
+    m_counts.resize(other.m_counts.size(), 0);
+  }
+  for (size_t i = 0; i < other.m_counts.size(); i++) {
+    m_counts[i] += other.m_counts[i];
+  }
+
+  m_count += other.m_count;
+  m_min = std::min(m_min, other.m_min);
+  m_max = std::max(m_max, other.m_max);
+  m_sum += other.m_sum;
+}
+
+void
+LatencyHistogram::Reset()
+{
+  m_counts.clear();
+  m_count = 0;
+  m_min = std::numeric_limits<int64_t>::max();
+  m_max = 0;
+  m_sum = 0;
+}
+
+int64_t
+LatencyHistogram::GetMin() const
+{
+  return m_count > 0 ? m_min : 0;
+}
+
+double
+LatencyHistogram::GetMean() const
+{
+  return m_count > 0 ? static_cast<double>(m_sum) / m_count : 0;
+}
+
+int64_t
+LatencyHistogram::GetValueAtPercentile(double percentile) const
+{
+  if (m_count == 0) {
+    return 0;
+  }
+
+  if (percentile <= 0) {
+    return m_min;
+  }
+
+  uint64_t rank = static_cast<uint64_t>(std::ceil(std::min(percentile, 100.0) / 100 * m_count));
+  rank = std::min(std::max<uint64_t>(rank, 1), m_count);
+
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < m_counts.size(); i++) {
+    cumulative += m_counts[i];
+    if (cumulative >= rank) {
+      return std::min(std::max(GetUpperBound(i), m_min), m_max);
+    }
+  }
+  return m_max;
+}
+
+std::vector<std::pair<int64_t, uint64_t>>
+LatencyHistogram::GetBuckets() const
+{
+  std::vector<std::pair<int64_t, uint64_t>> buckets;
+  for (size_t i = 0; i < m_counts.size(); i++) {
+    if (m_counts[i] > 0) {
+      buckets.emplace_back(GetUpperBound(i), m_counts[i]);
+    }
+  }
+  return buckets;
+}
+
+std::string
+LatencyHistogram::Encode() const
+{
+  std::ostringstream os;
+  os << m_subBucketBits << ";" << GetMin() << ";" << m_max << ";" << m_sum << ";";
+
+  size_t previous = 0;
+  bool isFirst = true;
+  for (size_t i = 0; i < m_counts.size(); i++) {
+    if (m_counts[i] == 0) {
+      continue;
+    }
+    if (!isFirst) {
+      os << ",";
+    }
+    os << i - previous;
+    if (m_counts[i] != 1) {
+      os << ":" << m_counts[i];
+    }
+    previous = i;
+    isFirst = false;
+  }
+  return os.str();
+}
+
+/**
+ * @brief Read an unsigned decimal number from @p encoded at @p pos and skip the following
+ *        character, which must be one of @p delimiters (or the end of the string)
+ * @return the delimiter, or '\0' at the end of the string
+ */
+static char
+ReadNumber(const std::string& encoded, size_t& pos, const char* delimiters, uint64_t& number)
+{
+  size_t start = pos;
+  number = 0;
+  while (pos < encoded.size() && encoded[pos] >= '0' && encoded[pos] <= '9') {
+    uint64_t digit = encoded[pos] - '0';
+    if (number > (std::numeric_limits<uint64_t>::max() - digit) / 10) {
+      throw LatencyHistogram::Error("Number in histogram is too large");
+    }
+    number = number * 10 + digit;
+    pos++;
+  }
+  if (pos == start) {
+    throw LatencyHistogram::Error("Histogram is malformed (number expected)");
+  }
+
+  if (pos == encoded.size()) {
+    return '\0';
+  }
+  char delimiter = encoded[pos++];
+  if (std::string(delimiters).find(delimiter) == std::string::npos) {
+    throw LatencyHistogram::Error(std::string("Histogram is malformed (unexpected '") + delimiter
+                                  + "')");
+  }
+  return delimiter;
+}
+
+LatencyHistogram
+LatencyHistogram::Decode(const std::string& encoded)
+{
+  size_t pos = 0;
+  uint64_t bits, min, max, sum;
+  if (ReadNumber(encoded, pos, ";", bits) != ';' || ReadNumber(encoded, pos, ";", min) != ';'
+      || ReadNumber(encoded, pos, ";", max) != ';' || ReadNumber(encoded, pos, ";", sum) != ';') {
+    throw Error("Histogram is truncated");
+  }
+  if (bits > MAX_SUB_BUCKET_BITS) {
+    throw Error("Too many sub-bucket bits in histogram");
+  }
+  if (min > max || max > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+    throw Error("Histogram has invalid range");
+  }
+
+  LatencyHistogram histogram(bits);
+  if (pos == encoded.size()) {
+    return histogram; // empty
+  }
+
+  size_t firstIndex = histogram.GetIndex(min);
+  size_t lastIndex = histogram.GetIndex(max);
+  histogram.m_counts.resize(lastIndex + 1, 0);
+
+  size_t index = 0;
+  char delimiter = ',';
+  while (delimiter == ',') {
+    uint64_t gap, count = 1;
+    delimiter = ReadNumber(encoded, pos, ",:", gap);
+    if (delimiter == ':') {
+      delimiter = ReadNumber(encoded, pos, ",", count);
+    }
+    if (gap > lastIndex - index || (histogram.m_count > 0 && gap == 0) || count == 0) {
+      throw Error("Histogram has invalid buckets");
+    }
+    index += gap;
+    histogram.m_counts[index] = count;
+    histogram.m_count += count;
+  }
+  if (histogram.m_counts[firstIndex] == 0 || histogram.m_counts[lastIndex] == 0) {
+    throw Error("Histogram buckets do not match its range");
+  }
+
+  histogram.m_min = static_cast<int64_t>(min);
+  histogram.m_max = static_cast<int64_t>(max);
+  histogram.m_sum = sum;
+  return histogram;
+}
+
+int64_t
+LatencyHistogram::GetLowerBound(size_t index) const
+{
+  size_t shift = index >> m_subBucketBits;
+  shift = shift > 0 ? shift - 1 : 0;
+  return static_cast<int64_t>((index - (shift << m_subBucketBits)) << shift);
+}
+
+int64_t
+LatencyHistogram::GetUpperBound(size_t index) const
+{
+  size_t shift = index >> m_subBucketBits;
+  shift = shift > 0 ? shift - 1 : 0;
+  return GetLowerBound(index) + ((int64_t(1) << shift) - 1);
+}
+
+size_t
+LatencyHistogram::GetIndex(int64_t value) const
+{
+  uint64_t v = value > 0 ? static_cast<uint64_t>(value) : 0;
+
+  // values below 2^(m_subBucketBits+1) are their own index; larger values keep the
+  // m_subBucketBits bits that follow their most significant bit
+  size_t shift = 0;
+  if ((v >> (m_subBucketBits + 1)) != 0) {
+    size_t msb = 63 - __builtin_clzll(v);
+    shift = msb - m_subBucketBits;
+  }
+  return (shift << m_subBucketBits) + static_cast<size_t>(v >> shift);
+}
+
+} // namespace ndn
+} // namespace ns3
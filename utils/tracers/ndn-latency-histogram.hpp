@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_LATENCY_HISTOGRAM_H
+#define NDN_LATENCY_HISTOGRAM_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Log-linear histogram of non-negative integer values (e.g., delays in microseconds)
+ *
+ * Values below 2^(subBucketBits+1) have a bucket each.  Above that, every power-of-two range
+ * [2^k, 2^(k+1)) is split into 2^subBucketBits buckets of equal width, so a value is known with
+ * a relative error below 2^-subBucketBits (0.8% for the default of 7 bits) regardless of its
+ * magnitude.  Buckets are allocated up to the largest recorded value.  Minimum, maximum, and
+ * sum are kept exactly.
+ *
+ * Histograms with the same number of sub-bucket bits can be merged, e.g., to aggregate the
+ * histograms of all applications of a node or of several simulation runs.
+ */
+class LatencyHistogram {
+public:
+  class Error : public std::runtime_error {
+  public:
+    explicit Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  explicit LatencyHistogram(uint32_t subBucketBits = 7);
+
+  /**
+   * @brief Record @p count occurrences of @p value (negative values are recorded as 0)
+   */
+  void
+  Record(int64_t value, uint64_t count = 1);
+
+  /**
+   * @brief Add all values recorded in @p other
+   * @pre @p other has the same number of sub-bucket bits
+   */
+  void
+  Merge(const LatencyHistogram& other);
+
+  /**
+   * @brief Forget all recorded values
+   */
+  void
+  Reset();
+
+  uint32_t
+  GetSubBucketBits() const
+  {
+    return m_subBucketBits;
+  }
+
+  uint64_t
+  GetCount() const
+  {
+    return m_count;
+  }
+
+  /**
+   * @brief Get smallest recorded value, or 0 if the histogram is empty
+   */
+  int64_t
+  GetMin() const;
+
+  /**
+   * @brief Get largest recorded value, or 0 if the histogram is empty
+   */
+  int64_t
+  GetMax() const
+  {
+    return m_max;
+  }
+
+  /**
+   * @brief Get mean of recorded values, or 0 if the histogram is empty
+   */
+  double
+  GetMean() const;
+
+  /**
+   * @brief Get value below or at which @p percentile percent of recorded values are
+   *
+   * The result is the upper bound of the bucket that contains the value, limited to the
+   * recorded maximum.  The 0th and 100th percentiles are the exact minimum and maximum.
+   */
+  int64_t
+  GetValueAtPercentile(double percentile) const;
+
+  /**
+   * @brief Get number of recorded values in each non-empty bucket
+   * @return pairs of the largest value of the bucket and the count, in increasing order
+   */
+  std::vector<std::pair<int64_t, uint64_t>>
+  GetBuckets() const;
+
+  /**
+   * @brief Encode the histogram as a compact string without whitespace
+   *
+   * The string consists of fields separated by ';': the number of sub-bucket bits, the
+   * minimum, the maximum, the sum, and a ','-separated list of non-empty buckets.  Each bucket
+   * is written as "<gap>:<count>", where gap is the difference between its index and the index
+   * of the previous non-empty bucket (the first gap is the index itself).  A count of 1 is
+   * written as "<gap>" alone.
+   */
+  std::string
+  Encode() const;
+
+  /**
+   * @brief Decode a histogram encoded with Encode
+   * @throw Error @p encoded is not a valid histogram
+   */
+  static LatencyHistogram
+  Decode(const std::string& encoded);
+
+  /**
+   * @brief Get smallest value that falls into the bucket with @p index
+   */
+  int64_t
+  GetLowerBound(size_t index) const;
+
+  /**
+   * @brief Get largest value that falls into the bucket with @p index
+   */
+  int64_t
+  GetUpperBound(size_t index) const;
+
+  /**
+   * @brief Get index of the bucket into which @p value falls
+   */
+  size_t
+  GetIndex(int64_t value) const;
+
+private:
+  uint32_t m_subBucketBits;
+  std::vector<uint64_t> m_counts;
+  uint64_t m_count;
+  int64_t m_min;
+  int64_t m_max;
+  uint64_t m_sum;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_LATENCY_HISTOGRAM_H
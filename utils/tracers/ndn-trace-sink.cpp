@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-sink.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceSink");
+
+namespace ns3 {
+namespace ndn {
+
+TraceSink::TraceSink(const std::string& file, size_t bufferSize /* = 4 * 1024 * 1024*/,
+                     size_t blockSize /* = 256 * 1024*/)
+  : m_isOpen(false)
+  , m_buffer(bufferSize)
+  , m_blockSize(std::min(blockSize, bufferSize))
+  , m_nPushed(0)
+  , m_nDrained(0)
+  , m_isClosing(false)
+{
+  NS_ASSERT_MSG(bufferSize > 0, "Buffer of trace sink cannot be empty");
+
+  if (file != "-") {
+    shared_ptr<std::ofstream> os(new std::ofstream());
+    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+
+    if (!os->is_open()) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    m_os = os;
+  }
+  else {
+    m_os = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  m_isOpen = true;
+  m_thread = std::thread(&TraceSink::Drain, this);
+  m_destroyEvent = Simulator::ScheduleDestroy(&TraceSink::Close, this);
+}
+
+TraceSink::~TraceSink()
+{
+  Close();
+}
+
+void
+TraceSink::Close()
+{
+  if (!m_isOpen) {
+    return;
+  }
+
+  m_isOpen = false;
+  m_destroyEvent.Cancel();
+
+  m_isClosing = true;
+  m_thread.join();
+  m_os->flush();
+  m_os.reset();
+}
+
+void
+TraceSink::Push(const char* data, size_t size)
+{
+  uint64_t nPushed = m_nPushed.load(std::memory_order_relaxed);
+  size_t capacity = m_buffer.size();
+
+  while (size > 0) {
+    size_t nFree = capacity - (nPushed - m_nDrained.load(std::memory_order_acquire));
+    if (nFree == 0) {
+      // the writer thread is behind; this is the only case when the simulation waits
+      std::this_thread::yield();
+      continue;
+    }
+
+    size_t offset = nPushed % capacity;
+    size_t n = std::min({size, nFree, capacity - offset});
+    std::copy(data, data + n, m_buffer.data() + offset);
+
+    data += n;
+    size -= n;
+    nPushed += n;
+    m_nPushed.store(nPushed, std::memory_order_release);
+  }
+}
+
+void
+TraceSink::Drain()
+{
+  uint64_t nDrained = m_nDrained.load(std::memory_order_relaxed);
+  size_t capacity = m_buffer.size();
+
+  while (true) {
+    // read the flag first, so that no record pushed before closing is missed
+    bool isClosing = m_isClosing.load(std::memory_order_acquire);
+    uint64_t nPushed = m_nPushed.load(std::memory_order_acquire);
+
+    if (nPushed - nDrained < m_blockSize && !isClosing) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+
+    while (nDrained < nPushed) {
+      size_t offset = nDrained % capacity;
+      size_t n = std::min<uint64_t>(nPushed - nDrained, capacity - offset);
+      m_os->write(m_buffer.data() + offset, n);
+
+      nDrained += n;
+      m_nDrained.store(nDrained, std::memory_order_release);
+    }
+
+    if (isClosing) {
+      return;
+    }
+  }
+}
+
+void
+TraceSink::AppendInteger(int64_t value, bool isSigned)
+{
+  char digits[24];
+  int size = isSigned ? std::snprintf(digits, sizeof(digits), "%" PRId64, value)
+                      : std::snprintf(digits, sizeof(digits), "%" PRIu64,
+                                      static_cast<uint64_t>(value));
+  m_record.append(digits, size);
+}
+
+void
+TraceSink::Append(const Name& value)
+{
+  m_record.append(value.toUri());
+}
+
+void
+TraceSink::Append(double value)
+{
+  char digits[64];
+  int size = std::snprintf(digits, sizeof(digits), "%.9f", value);
+  m_record.append(digits, std::min<size_t>(size, sizeof(digits) - 1));
+}
+
+void
+TraceSink::Append(const Time& value)
+{
+  // exact conversion of nanoseconds, same as std::fixed << std::setprecision(9) of seconds
+  int64_t ns = value.GetNanoSeconds();
+  if (ns < 0) {
+    m_record.push_back('-');
+    ns = -ns;
+  }
+
+  char digits[32];
+  int size = std::snprintf(digits, sizeof(digits), "%" PRId64 ".%09" PRId64, ns / 1000000000,
+                           ns % 1000000000);
+  m_record.append(digits, size);
+}
+
+} // namespace ndn
+} // namespace ns3
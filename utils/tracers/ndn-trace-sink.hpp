@@ -0,0 +1,177 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACE_SINK_H
+#define NDN_TRACE_SINK_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Asynchronous writer of comma-separated trace records
+ *
+ * Trace callbacks of applications and scenarios call Write with the fields of a record.  The
+ * record is formatted on the simulation thread and copied into a single-producer
+ * single-consumer ring buffer.  A background thread drains the buffer and writes it to the file
+ * in large blocks, so trace callbacks neither flush nor wait for the file system (unless the
+ * buffer is full).
+ *
+ * Remaining records are written and the file is closed at Simulator::Destroy, or when Close is
+ * called or the sink is destroyed, whichever happens first.  Write must only be called from the
+ * simulation thread.
+ *
+ * @code
+ * Ptr<ndn::TraceSink> sink = Create<ndn::TraceSink>("trace.csv");
+ * sink->Write("nodeid", "event", "name", "time");
+ * ...
+ * sink->Write(nodeid, "sent", interest->getName(), Simulator::Now());
+ * @endcode
+ */
+class TraceSink : public SimpleRefCount<TraceSink> {
+public:
+  /**
+   * @param file       File to which records will be written.  If filename is -, then std::cout
+   *                   is used
+   * @param bufferSize size of the ring buffer in bytes
+   * @param blockSize  minimum number of bytes written at once before the sink is closed
+   */
+  explicit TraceSink(const std::string& file, size_t bufferSize = 4 * 1024 * 1024,
+                     size_t blockSize = 256 * 1024);
+
+  ~TraceSink();
+
+  /**
+   * @brief Check whether the file has been opened and the sink has not been closed yet
+   */
+  bool
+  IsOpen() const
+  {
+    return m_isOpen;
+  }
+
+  /**
+   * @brief Write a record, one comma-separated field per argument
+   *
+   * Integers and strings are written as is, names as URIs, booleans as 0 or 1, doubles with
+   * 9 decimal places, and Time values in seconds with 9 decimal places.
+   */
+  template<typename... Fields>
+  void
+  Write(const Fields&... fields)
+  {
+    if (!m_isOpen) {
+      return;
+    }
+
+    m_record.clear();
+    Append(fields...);
+    m_record.push_back('\n');
+    Push(m_record.data(), m_record.size());
+  }
+
+  /**
+   * @brief Write remaining records, close the file, and stop the background thread
+   */
+  void
+  Close();
+
+private:
+  template<typename Field, typename Next, typename... Fields>
+  void
+  Append(const Field& field, const Next& next, const Fields&... fields)
+  {
+    Append(field);
+    m_record.push_back(',');
+    Append(next, fields...);
+  }
+
+  template<typename Integer>
+  typename std::enable_if<std::is_integral<Integer>::value>::type
+  Append(Integer value)
+  {
+    AppendInteger(static_cast<int64_t>(value), std::is_signed<Integer>::value);
+  }
+
+  void
+  Append(bool value)
+  {
+    m_record.push_back(value ? '1' : '0');
+  }
+
+  void
+  Append(const char* value)
+  {
+    m_record.append(value);
+  }
+
+  void
+  Append(const std::string& value)
+  {
+    m_record.append(value);
+  }
+
+  void
+  Append(const Name& value);
+
+  void
+  Append(double value);
+
+  void
+  Append(const Time& value);
+
+  void
+  AppendInteger(int64_t value, bool isSigned);
+
+  void
+  Push(const char* data, size_t size);
+
+  void
+  Drain();
+
+private:
+  shared_ptr<std::ostream> m_os;
+  bool m_isOpen;
+  EventId m_destroyEvent;
+  std::string m_record; ///< @brief formatting buffer, reused between records
+
+  std::vector<char> m_buffer;
+  size_t m_blockSize;
+  std::atomic<uint64_t> m_nPushed;  ///< @brief total number of bytes put into the buffer
+  std::atomic<uint64_t> m_nDrained; ///< @brief total number of bytes written to the file
+  std::atomic<bool> m_isClosing;
+  std::thread m_thread;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_SINK_H
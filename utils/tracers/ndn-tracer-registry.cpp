@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-tracer-registry.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/event-id.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TracerRegistry");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+struct Printer {
+  std::type_index type;
+  const void* tracer;
+  uint32_t nodeId;
+  std::function<void()> print;
+};
+
+/**
+ * @brief Tracers that are printed into the same stream with the same period
+ */
+struct Clock {
+  shared_ptr<std::ostream> os;
+  Time period;
+  std::vector<Printer> printers;
+  bool isSorted;
+  EventId event;
+};
+
+std::list<Clock>&
+getClocks()
+{
+  static std::list<Clock> clocks;
+  return clocks;
+}
+
+void
+clearClocks()
+{
+  getClocks().clear();
+}
+
+void
+tick(Clock* clock)
+{
+  if (!clock->isSorted) {
+    // tracers of the same node keep the order in which they were added
+    std::stable_sort(clock->printers.begin(), clock->printers.end(),
+                     [] (const Printer& a, const Printer& b) { return a.nodeId < b.nodeId; });
+    clock->isSorted = true;
+  }
+
+  for (const Printer& printer : clock->printers) {
+    printer.print();
+  }
+
+  clock->event = Simulator::Schedule(clock->period, &tick, clock);
+}
+
+} // namespace
+
+shared_ptr<std::ostream>
+TracerRegistry::OpenStream(const std::string& file)
+{
+  if (file == "-") {
+    return shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  shared_ptr<std::ofstream> os(new std::ofstream());
+  os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+
+  if (!os->is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return nullptr;
+  }
+  return os;
+}
+
+void
+TracerRegistry::SetPeriod(const void* tracer, Time period)
+{
+  std::list<Clock>& clocks = getClocks();
+  for (auto clock = clocks.begin(); clock != clocks.end(); ++clock) {
+    auto printer = std::find_if(clock->printers.begin(), clock->printers.end(),
+                                [tracer] (const Printer& printer) {
+                                  return printer.tracer == tracer;
+                                });
+    if (printer == clock->printers.end()) {
+      continue;
+    }
+    if (clock->period == period) {
+      return;
+    }
+
+    Printer moved = std::move(*printer);
+    shared_ptr<std::ostream> os = clock->os;
+    clock->printers.erase(printer);
+    if (clock->printers.empty()) {
+      clock->event.Cancel();
+      clocks.erase(clock);
+    }
+    AddPrinter(moved.type, moved.tracer, moved.nodeId, os, period, std::move(moved.print));
+    return;
+  }
+}
+
+void
+TracerRegistry::AddPrinter(std::type_index type, const void* tracer, uint32_t nodeId,
+                           shared_ptr<std::ostream> os, Time period,
+                           std::function<void()> printer)
+{
+  std::list<Clock>& clocks = getClocks();
+  if (clocks.empty()) {
+    // clocks of a destroyed simulation must not be joined by tracers of the next one
+    Simulator::ScheduleDestroy(&clearClocks);
+  }
+
+  auto clock = std::find_if(clocks.begin(), clocks.end(), [&] (const Clock& clock) {
+      return clock.os.get() == os.get() && clock.period == period;
+    });
+  if (clock == clocks.end()) {
+    clock = clocks.emplace(clocks.end());
+    clock->os = os;
+    clock->period = period;
+    clock->event = Simulator::Schedule(period, &tick, &*clock);
+  }
+
+  clock->printers.push_back({type, tracer, nodeId, std::move(printer)});
+  clock->isSorted = false;
+}
+
+void
+TracerRegistry::RemovePrinters(std::type_index type)
+{
+  std::list<Clock>& clocks = getClocks();
+  for (auto clock = clocks.begin(); clock != clocks.end();) {
+    auto& printers = clock->printers;
+    printers.erase(std::remove_if(printers.begin(), printers.end(),
+                                  [type] (const Printer& printer) { return printer.type == type; }),
+                   printers.end());
+    if (printers.empty()) {
+      clock->event.Cancel();
+      clock = clocks.erase(clock);
+    }
+    else {
+      ++clock;
+    }
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACER_REGISTRY_H
+#define NDN_TRACER_REGISTRY_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <functional>
+#include <list>
+#include <typeindex>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Sampling clock shared by all periodic tracers
+ *
+ * Periodic tracers are registered here instead of scheduling their own events.  The registry
+ * keeps one periodic event for each output stream and averaging period, which prints all
+ * tracers of the stream in node order.  Every period is therefore written as one contiguous
+ * block, and a network of N nodes needs one event per period instead of N.
+ *
+ * A tracer class used with the registry provides
+ * - a constructor taking (shared_ptr<std::ostream>, Ptr<Node>),
+ * - static AttachOutput(const std::list<Ptr<Tracer>>&, shared_ptr<std::ostream>), which prints
+ *   the header or sets up binary output,
+ * - SetAveragingPeriod(const Time&) and PeriodicPrinter(), which prints and resets the
+ *   counters.
+ */
+class TracerRegistry {
+public:
+  /**
+   * @brief Open trace file for writing
+   * @param file File to which traces will be written.  If filename is -, then std::cout is used
+   * @return nullptr if the file cannot be opened
+   */
+  static shared_ptr<std::ostream>
+  OpenStream(const std::string& file);
+
+  /**
+   * @brief Create tracers of the nodes in [@p first, @p last) that write into @p file
+   * @return the tracers, or an empty list if the file cannot be opened
+   */
+  template<class Tracer, class NodeIterator>
+  static std::list<Ptr<Tracer>>
+  Install(NodeIterator first, NodeIterator last, const std::string& file, Time averagingPeriod)
+  {
+    std::list<Ptr<Tracer>> tracers;
+    shared_ptr<std::ostream> os = OpenStream(file);
+    if (os == nullptr) {
+      return tracers;
+    }
+
+    for (NodeIterator node = first; node != last; node++) {
+      tracers.push_back(Create<Tracer>(os, *node));
+    }
+    Tracer::AttachOutput(tracers, os);
+
+    auto node = first;
+    for (const auto& tracer : tracers) {
+      Add(tracer, (*node++)->GetId(), os, averagingPeriod);
+    }
+    return tracers;
+  }
+
+  /**
+   * @brief Print @p tracer of node @p nodeId into @p os every @p averagingPeriod
+   *
+   * The registry keeps the tracer until Remove is called for its class or the simulation is
+   * destroyed.
+   */
+  template<class Tracer>
+  static void
+  Add(Ptr<Tracer> tracer, uint32_t nodeId, shared_ptr<std::ostream> os, Time averagingPeriod)
+  {
+    tracer->SetAveragingPeriod(averagingPeriod);
+    AddPrinter(typeid(Tracer), PeekPointer(tracer), nodeId, os, averagingPeriod,
+               [tracer] { tracer->PeriodicPrinter(); });
+  }
+
+  /**
+   * @brief Print @p tracer every @p period from now on
+   *
+   * The tracer moves to the clock of its stream with the new period.  Nothing is done if the
+   * tracer is not registered.
+   */
+  static void
+  SetPeriod(const void* tracer, Time period);
+
+  /**
+   * @brief Stop printing and release all tracers of class @p Tracer
+   */
+  template<class Tracer>
+  static void
+  Remove()
+  {
+    RemovePrinters(typeid(Tracer));
+  }
+
+private:
+  static void
+  AddPrinter(std::type_index type, const void* tracer, uint32_t nodeId,
+             shared_ptr<std::ostream> os, Time period, std::function<void()> printer);
+
+  static void
+  RemovePrinters(std::type_index type);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACER_REGISTRY_H